@@ -40,6 +40,7 @@ public:
     virtual void GetGenesisBlock(CBlock& block) = 0;
     virtual Errno ValidateTransaction(const uint256& hashTxAtFork, const uint256& hashMainChainRefBlock, const CTransaction& tx) = 0;
     virtual Errno ValidateBlock(const uint256& hashFork, const uint256& hashMainChainRefBlock, const CBlock& block) = 0;
+    virtual Errno PrevalidateBlock(const CBlock& block) = 0;
     virtual Errno ValidateOrigin(const CBlock& block, const CProfile& parentProfile, CProfile& forkProfile) = 0;
     virtual Errno VerifyProofOfWork(const CBlock& block, const CBlockIndex* pIndexPrev) = 0;
     virtual Errno VerifyDelegatedProofOfStake(const CBlock& block, const CBlockIndex* pIndexPrev,
@@ -48,7 +49,7 @@ public:
     virtual Errno VerifySubsidiary(const CBlock& block, const CBlockIndex* pIndexPrev, const CBlockIndex* pIndexRef,
                                    const CDelegateAgreement& agreement)
         = 0;
-    virtual Errno VerifyTransaction(const uint256& txid, const CTransaction& tx, const uint256& hashFork, const uint256& hashPrevBlock, const int nAtHeight, const CDestState& stateFrom, const std::map<CDestination, CAddressContext>& mapBlockAddress) = 0;
+    virtual Errno VerifyTransaction(const uint256& txid, const CTransaction& tx, const uint256& hashFork, const uint256& hashPrevBlock, const int nAtHeight, const CDestState& stateFrom, const std::map<CDestination, CAddressContext>& mapBlockAddress, const bool fSignVerified = false) = 0;
     virtual bool GetBlockTrust(const CBlock& block, uint256& nChainTrust, const CBlockIndex* pIndexPrev = nullptr, const CDelegateAgreement& agreement = CDelegateAgreement(), const CBlockIndex* pIndexRef = nullptr, const uint256& nEnrollTrust = uint256()) = 0;
     virtual bool GetProofOfWorkTarget(const CBlockIndex* pIndexPrev, int nAlgo, int& nBits) = 0;
     virtual uint256 GetDelegatedBallot(const int nBlockHeight, const uint256& nAgreement, const std::size_t& nWeight, const std::map<CDestination, std::size_t>& mapBallot,
@@ -119,6 +120,8 @@ public:
     virtual bool RetrieveForkLast(const uint256& hashFork, uint256& hashLastBlock) = 0;
     virtual bool GetForkStorageMaxHeight(const uint256& hashFork, uint32& nMaxHeight) = 0;
     virtual Errno AddNewBlock(const CBlock& block, CBlockChainUpdate& update) = 0;
+    virtual void PrevalidateBlock(const CBlock& block) = 0;
+    virtual void RemovePrevalidatedBlock(const std::vector<uint256>& vBlockHash) = 0;
     virtual Errno AddNewOrigin(const CBlock& block, CBlockChainUpdate& update) = 0;
     virtual bool GetProofOfWorkTarget(const uint256& hashPrev, int nAlgo, int& nBits) = 0;
     virtual bool GetBlockMintReward(const uint256& hashPrev, const bool fPow, uint256& nReward, const uint256& hashMainChainRefBlock) = 0;
@@ -138,6 +141,7 @@ public:
     virtual bool GetForkContractCodeContext(const uint256& hashFork, const uint256& hashBlock, const uint256& hashContractCode, CContractCodeContext& ctxtContractCode) = 0;
     virtual bool ListContractCreateCodeContext(const uint256& hashFork, const uint256& hashBlock, const uint256& txid, std::map<uint256, CContractCodeContext>& mapCreateCode) = 0;
     virtual bool ListAddressTxInfo(const uint256& hashFork, const uint256& hashRefBlock, const CDestination& dest, const uint64 nBeginTxIndex, const uint64 nGetTxCount, const bool fReverse, std::vector<CDestTxInfo>& vAddressTxInfo) = 0;
+    virtual bool GetAddressTxIndexLast(const uint256& hashFork, uint256& hashIndexBlock) = 0;
     virtual bool GetCreateForkLockedAmount(const CDestination& dest, const uint256& hashPrevBlock, const bytes& btAddressData, uint256& nLockedAmount) = 0;
     virtual bool VerifyAddressVoteRedeem(const CDestination& dest, const uint256& hashPrevBlock) = 0;
     virtual bool GetVoteRewardLockedAmount(const uint256& hashFork, const uint256& hashPrevBlock, const CDestination& dest, uint256& nLockedAmount) = 0;
@@ -145,6 +149,7 @@ public:
     virtual bool VerifyForkNameAndChainId(const uint256& hashFork, const CChainId nChainIdIn, const std::string& strForkName, const uint256& hashBlock = uint256()) = 0;
     virtual bool GetForkHashByChainId(const CChainId nChainId, uint256& hashFork, const uint256& hashBlock = uint256()) = 0;
     virtual bool RetrieveContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& key, bytes& value) = 0;
+    virtual bool ListContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext) = 0;
     virtual uint256 AddLogsFilter(const uint256& hashClient, const uint256& hashFork, const CLogsFilter& logsFilter) = 0;
     virtual void RemoveFilter(const uint256& nFilterId) = 0;
     virtual bool GetTxReceiptLogsByFilterId(const uint256& nFilterId, const bool fAll, ReceiptLogsVec& receiptLogs) = 0;
@@ -210,6 +215,7 @@ public:
 
     virtual bool UpdateForkMintMinGasPrice(const uint256& hashFork, const uint256& nMinGasPrice) = 0;
     virtual uint256 GetForkMintMinGasPrice(const uint256& hashFork) = 0;
+    virtual void GetSaveBlockStat(storage::CSaveBlockStat& stat, const bool fReset = false) = 0;
 
     const CBasicConfig* Config()
     {
@@ -231,9 +237,11 @@ public:
     virtual bool CheckTxNonce(const uint256& hashFork, const CDestination& destFrom, const uint64 nTxNonce) = 0;
     virtual std::size_t Count(const uint256& hashFork) const = 0;
     virtual Errno Push(const uint256& hashFork, const CTransaction& tx) = 0;
+    virtual void Push(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<Errno>& vErr) = 0;
     virtual bool Get(const uint256& hashFork, const uint256& txid, CTransaction& tx, uint256& hashAtFork) const = 0;
     virtual void ListTx(const uint256& hashFork, std::vector<std::pair<uint256, std::size_t>>& vTxPool) = 0;
     virtual void ListTx(const uint256& hashFork, std::vector<uint256>& vTxPool) = 0;
+    virtual void ListRelayTx(const uint256& hashFork, std::vector<uint256>& vTxPool) = 0;
     virtual bool ListTx(const uint256& hashFork, const CDestination& dest, std::vector<CTxInfo>& vTxPool, const int64 nGetOffset = 0, const int64 nGetCount = 0) = 0;
     virtual bool FetchArrangeBlockTx(const uint256& hashFork, const uint256& hashPrev, const int64 nBlockTime,
                                      const std::size_t nMaxSize, std::vector<CTransaction>& vtx, uint256& nTotalTxFee)
@@ -346,6 +354,7 @@ public:
       : IBase("dispatcher") {}
     virtual Errno AddNewBlock(const CBlock& block, uint64 nNonce = 0) = 0;
     virtual Errno AddNewTx(const uint256& hashFork, const CTransaction& tx, uint64 nNonce = 0) = 0;
+    virtual void AddNewTx(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<Errno>& vErr, uint64 nNonce = 0) = 0;
     virtual bool AddNewDistribute(const uint256& hashAnchor, const CDestination& dest,
                                   const std::vector<unsigned char>& vchDistribute)
         = 0;
@@ -407,6 +416,7 @@ public:
         = 0;
     virtual bool GetForkHashByChainId(const CChainId nChainIdIn, uint256& hashFork) = 0;
     virtual bool RetrieveContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& key, bytes& value) = 0;
+    virtual bool ListContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext) = 0;
     virtual uint256 AddLogsFilter(const uint256& hashClient, const uint256& hashFork, const CLogsFilter& logsFilter) = 0;
     virtual void RemoveFilter(const uint256& nFilterId) = 0;
     virtual bool GetTxReceiptLogsByFilterId(const uint256& nFilterId, const bool fAll, ReceiptLogsVec& receiptLogs) = 0;
@@ -440,6 +450,7 @@ public:
     virtual CTemplatePtr GetTemplate(const CDestination& dest) = 0;
     virtual bool RemoveTemplate(const CDestination& dest) = 0;
     virtual bool ListTransaction(const uint256& hashFork, const uint256& hashRefBlock, const CDestination& dest, const uint64 nOffset, const uint64 nCount, const bool fReverse, std::vector<CDestTxInfo>& vTx) = 0;
+    virtual int GetAddressTxIndexHeight(const uint256& hashFork) = 0;
     virtual boost::optional<std::string> CreateTransaction(const uint256& hashFork, const CDestination& destFrom, const CDestination& destTo, const bytes& btToData,
                                                            const uint256& nAmount, const uint64 nNonce, const uint256& nGasPrice, const uint256& nGas, const bytes& btData,
                                                            const bytes& btFormatData, const bytes& btContractCode, const bytes& btContractParam, CTransaction& txNew)
@@ -448,6 +459,7 @@ public:
                                                             const uint64 nNonce, const uint256& nGasPrice, const uint256& nGas, const bytes& btData, const uint64 nAddGas, uint256& txid, bytes& btSignTxData)
         = 0;
     virtual bool SendEthRawTransaction(const bytes& btRawTxData, uint256& txid) = 0;
+    virtual void SendEthRawTransaction(const std::vector<bytes>& vRawTxData, std::vector<uint256>& vTxid, std::vector<bool>& vResult) = 0;
     virtual bool SendEthTransaction(const uint256& hashFork, const CDestination& destFrom, const CDestination& destTo, const uint256& nAmount,
                                     const uint64 nNonce, const uint256& nGasPrice, const uint256& nGas, const bytes& btData, const uint64 nAddGas, uint256& txid)
         = 0;
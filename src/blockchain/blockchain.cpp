@@ -8,6 +8,7 @@
 #include "delegatecomm.h"
 #include "delegateverify.h"
 #include "mevm/evmexec.h"
+#include "parallel.h"
 #include "param.h"
 #include "template/delegate.h"
 #include "template/fork.h"
@@ -28,7 +29,11 @@ namespace metabasenet
 // CBlockChain
 
 CBlockChain::CBlockChain()
-  : cacheEnrolled(ENROLLED_CACHE_COUNT), cacheAgreement(AGREEMENT_CACHE_COUNT), cachePiggyback(PIGGYBACK_CACHE_COUNT), nMaxBlockRewardTxCount(0)
+  : cacheEnrolled(ENROLLED_CACHE_COUNT), cacheAgreement(AGREEMENT_CACHE_COUNT), cachePiggyback(PIGGYBACK_CACHE_COUNT), nMaxBlockRewardTxCount(0),
+    thrWarmup("warmup", boost::bind(&CBlockChain::WarmupCacheProc, this)),
+    thrAddressTxIndex("addrtxindex", boost::bind(&CBlockChain::AddressTxIndexProc, this)),
+    thrPrevalidate("prevalidate", boost::bind(&CBlockChain::PrevalidateBlockProc, this)),
+    cachePrevalidated(MAX_PREVALIDATE_BLOCK_COUNT)
 {
     pCoreProtocol = nullptr;
     pTxPool = nullptr;
@@ -77,7 +82,7 @@ bool CBlockChain::HandleInvoke()
     nMaxBlockRewardTxCount = GetBlockInvestRewardTxMaxCount();
     StdLog("BlockChain", "HandleInvoke: Max block reward tx count: %d", nMaxBlockRewardTxCount);
 
-    if (!cntrBlock.Initialize(Config()->pathData, blockGenesis.GetHash(), Config()->fFullDb, Config()->fRewardCheck))
+    if (!cntrBlock.Initialize(Config()->pathData, blockGenesis.GetHash(), Config()->fFullDb, Config()->fFullDbAsync, Config()->fRewardCheck, StorageConfig()->nCheckLevel))
     {
         StdError("BlockChain", "Failed to initialize container");
         return false;
@@ -112,17 +117,159 @@ bool CBlockChain::HandleInvoke()
         }
     }
 
+    if (!ThreadDelayStart(thrWarmup))
+    {
+        StdError("BlockChain", "Failed to start warmup thread");
+        return false;
+    }
+    if (Config()->fFullDb && !ThreadDelayStart(thrAddressTxIndex))
+    {
+        StdError("BlockChain", "Failed to start address tx index thread");
+        return false;
+    }
+    if (!ThreadDelayStart(thrPrevalidate))
+    {
+        StdError("BlockChain", "Failed to start prevalidate thread");
+        return false;
+    }
     return true;
 }
 
 void CBlockChain::HandleHalt()
 {
+    if (thrWarmup.IsRunning())
+    {
+        thrWarmup.Interrupt();
+    }
+    ThreadExit(thrWarmup);
+    if (thrAddressTxIndex.IsRunning())
+    {
+        thrAddressTxIndex.Interrupt();
+    }
+    ThreadExit(thrAddressTxIndex);
+    if (thrPrevalidate.IsRunning())
+    {
+        thrPrevalidate.Interrupt();
+    }
+    ThreadExit(thrPrevalidate);
+    {
+        boost::unique_lock<boost::mutex> lock(mtxPrevalidate);
+        queuePrevalidate.clear();
+        setPrevalidatePending.clear();
+        cachePrevalidated.Clear();
+    }
     cntrBlock.Deinitialize();
     cacheEnrolled.Clear();
     cacheAgreement.Clear();
     cachePiggyback.Clear();
 }
 
+void CBlockChain::WarmupCacheProc()
+{
+    try
+    {
+        cntrBlock.WarmupCache();
+    }
+    catch (const boost::thread_interrupted&)
+    {
+        StdLog("BlockChain", "Warmup cache: interrupted");
+    }
+}
+
+void CBlockChain::AddressTxIndexProc()
+{
+    try
+    {
+        while (true)
+        {
+            // Follows the main chain of every fork, idles once all of them are indexed
+            std::size_t nIndexCount = 0;
+            if (!cntrBlock.CatchUpAddressTxInfo(ADDRESS_TX_INDEX_BATCH_COUNT, nIndexCount))
+            {
+                StdError("BlockChain", "Address tx index: Catch up fail, retry after %d seconds", ADDRESS_TX_INDEX_RETRY_SECONDS);
+                boost::this_thread::sleep(boost::posix_time::seconds((int)ADDRESS_TX_INDEX_RETRY_SECONDS));
+            }
+            else if (nIndexCount == 0)
+            {
+                boost::this_thread::sleep(boost::posix_time::seconds((int)ADDRESS_TX_INDEX_IDLE_SECONDS));
+            }
+        }
+    }
+    catch (const boost::thread_interrupted&)
+    {
+        StdLog("BlockChain", "Address tx index: interrupted");
+    }
+}
+
+void CBlockChain::PrevalidateBlockProc()
+{
+    try
+    {
+        while (true)
+        {
+            uint256 hashBlock;
+            CBlock block;
+            {
+                boost::unique_lock<boost::mutex> lock(mtxPrevalidate);
+                while (queuePrevalidate.empty())
+                {
+                    condPrevalidate.wait(lock);
+                }
+                hashBlock = queuePrevalidate.front().first;
+                block = std::move(queuePrevalidate.front().second);
+                queuePrevalidate.pop_front();
+            }
+
+            // Stateless checks and signatures against the from address, run while the blocks ahead are executed
+            CBlockPrevalidated prevalidated;
+            if (pCoreProtocol->PrevalidateBlock(block) == OK)
+            {
+                prevalidated.vSignVerifiedTxid.assign(block.vtx.size(), uint256());
+                auto lmdVerify = [&](const size_t i) {
+                    const CTransaction& tx = block.vtx[i];
+                    if (!tx.IsRewardTx() && tx.VerifyTxSignature(tx.GetFromAddress()))
+                    {
+                        prevalidated.vSignVerifiedTxid[i] = tx.GetHash();
+                    }
+                };
+                if (block.vtx.size() < PREVALIDATE_PARALLEL_MIN_COUNT)
+                {
+                    for (size_t i = 0; i < block.vtx.size(); i++)
+                    {
+                        lmdVerify(i);
+                    }
+                }
+                else
+                {
+                    ParallelComputer computer;
+                    computer.Execute(block.vtx.size(), [](const size_t i) { return i; }, lmdVerify);
+                }
+            }
+
+            boost::unique_lock<boost::mutex> lock(mtxPrevalidate);
+            if (setPrevalidatePending.erase(hashBlock) > 0)
+            {
+                cachePrevalidated.AddNew(hashBlock, prevalidated);
+            }
+        }
+    }
+    catch (const boost::thread_interrupted&)
+    {
+        StdLog("BlockChain", "Prevalidate block: interrupted");
+    }
+}
+
+bool CBlockChain::TakePrevalidatedBlock(const uint256& hashBlock, CBlockPrevalidated& prevalidated)
+{
+    boost::unique_lock<boost::mutex> lock(mtxPrevalidate);
+    if (!cachePrevalidated.Retrieve(hashBlock, prevalidated))
+    {
+        return false;
+    }
+    cachePrevalidated.Remove(hashBlock);
+    return true;
+}
+
 void CBlockChain::GetForkStatus(map<uint256, CForkStatus>& mapForkStatus)
 {
     mapForkStatus.clear();
@@ -482,6 +629,11 @@ Errno CBlockChain::AddNewBlock(const CBlock& block, CBlockChainUpdate& update)
     }
     uint256 hashFork = pIndexPrev->GetOriginHash();
 
+    // Only the verified tx signatures are taken, each for its txid, the block itself is validated again
+    CBlockPrevalidated prevalidated;
+    TakePrevalidatedBlock(hashBlock, prevalidated);
+
+    CTicks tVerify;
     err = pCoreProtocol->ValidateBlock(hashFork, pIndexPrev->GetRefBlock(), block);
     if (err != OK)
     {
@@ -514,7 +666,7 @@ Errno CBlockChain::AddNewBlock(const CBlock& block, CBlockChainUpdate& update)
         return ERR_TRANSACTION_INVALID;
     }
 
-    err = VerifyBlockTx(hashFork, hashBlock, block, nReward, nIgnoreVerifyTx, mapBlockAddress);
+    err = VerifyBlockTx(hashFork, hashBlock, block, nReward, nIgnoreVerifyTx, mapBlockAddress, prevalidated.vSignVerifiedTxid);
     if (err != OK)
     {
         StdLog("BlockChain", "Add new block: Verify Block tx fail, err: %s, block: %s", ErrorString(err), hashBlock.ToString().c_str());
@@ -527,6 +679,7 @@ Errno CBlockChain::AddNewBlock(const CBlock& block, CBlockChainUpdate& update)
         StdLog("BlockChain", "Add new block: Get block trust fail, block: %s", hashBlock.GetHex().c_str());
         return ERR_BLOCK_TRANSACTIONS_INVALID;
     }
+    cntrBlock.AddSaveBlockStage(storage::CSaveBlockStat::STAGE_VERIFY, tVerify.Elapse());
 
     CBlockEx blockex(block, nChainTrust);
     if (!cntrBlock.StorageNewBlock(hashFork, hashBlock, blockex, update))
@@ -539,6 +692,39 @@ Errno CBlockChain::AddNewBlock(const CBlock& block, CBlockChainUpdate& update)
     return OK;
 }
 
+void CBlockChain::PrevalidateBlock(const CBlock& block)
+{
+    const uint256 hashBlock = block.GetHash();
+    if (cntrBlock.Exists(hashBlock))
+    {
+        return;
+    }
+    boost::unique_lock<boost::mutex> lock(mtxPrevalidate);
+    if (setPrevalidatePending.count(hashBlock) > 0 || cachePrevalidated.Exists(hashBlock)
+        || setPrevalidatePending.size() >= MAX_PREVALIDATE_BLOCK_COUNT)
+    {
+        return;
+    }
+    setPrevalidatePending.insert(hashBlock);
+    queuePrevalidate.push_back(make_pair(hashBlock, block));
+    condPrevalidate.notify_one();
+}
+
+void CBlockChain::RemovePrevalidatedBlock(const std::vector<uint256>& vBlockHash)
+{
+    boost::unique_lock<boost::mutex> lock(mtxPrevalidate);
+    for (const uint256& hashBlock : vBlockHash)
+    {
+        if (setPrevalidatePending.erase(hashBlock) > 0)
+        {
+            queuePrevalidate.erase(std::remove_if(queuePrevalidate.begin(), queuePrevalidate.end(),
+                                                  [&](const std::pair<uint256, CBlock>& item) { return item.first == hashBlock; }),
+                                   queuePrevalidate.end());
+        }
+        cachePrevalidated.Remove(hashBlock);
+    }
+}
+
 Errno CBlockChain::AddNewOrigin(const CBlock& block, CBlockChainUpdate& update)
 {
     uint256 hashBlock = block.GetHash();
@@ -1089,7 +1275,7 @@ Errno CBlockChain::VerifyPowBlock(const CBlock& block, bool& fLongChain)
         return ERR_TRANSACTION_INVALID;
     }
 
-    err = VerifyBlockTx(hashFork, hashBlock, block, nReward, nIgnoreVerifyTx, mapBlockAddress);
+    err = VerifyBlockTx(hashFork, hashBlock, block, nReward, nIgnoreVerifyTx, mapBlockAddress, std::vector<uint256>());
     if (err != OK)
     {
         StdError("BlockChain", "Verify poa block: Verify block tx fail, block: %s", hashBlock.ToString().c_str());
@@ -1820,7 +2006,8 @@ bool CBlockChain::ListAddressTxInfo(const uint256& hashFork, const uint256& hash
     uint256 hashLastBlock = hashRefBlock;
     if (hashRefBlock == 0)
     {
-        if (!cntrBlock.RetrieveForkLast(hashFork, hashLastBlock))
+        // The latest blocks may not be indexed yet, list from the last indexed one
+        if (!cntrBlock.GetAddressTxInfoIndexLast(hashFork, hashLastBlock))
         {
             return false;
         }
@@ -1828,6 +2015,11 @@ bool CBlockChain::ListAddressTxInfo(const uint256& hashFork, const uint256& hash
     return cntrBlock.ListAddressTxInfo(hashFork, hashLastBlock, dest, nBeginTxIndex, nGetTxCount, fReverse, vAddressTxInfo);
 }
 
+bool CBlockChain::GetAddressTxIndexLast(const uint256& hashFork, uint256& hashIndexBlock)
+{
+    return cntrBlock.GetAddressTxInfoIndexLast(hashFork, hashIndexBlock);
+}
+
 bool CBlockChain::GetCreateForkLockedAmount(const CDestination& dest, const uint256& hashPrevBlock, const bytes& btAddressData, uint256& nLockedAmount)
 {
     return cntrBlock.GetCreateForkLockedAmount(dest, hashPrevBlock, btAddressData, nLockedAmount);
@@ -1892,6 +2084,17 @@ bool CBlockChain::RetrieveContractKvValue(const uint256& hashFork, const uint256
     return cntrBlock.RetrieveContractKvValue(hashFork, state.GetStorageRoot(), hash, value);
 }
 
+bool CBlockChain::ListContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext)
+{
+    CDestState state;
+    if (!RetrieveDestState(hashFork, hashBlock, dest, state))
+    {
+        StdLog("BlockChain", "List contract kv value: Retrieve dest state fail, dest: %s, block: %s", dest.ToString().c_str(), hashBlock.GetHex().c_str());
+        return false;
+    }
+    return cntrBlock.ListContractKvValue(hashFork, state.GetStorageRoot(), keyBegin, nGetCount, vContractKv, keyNext);
+}
+
 uint256 CBlockChain::AddLogsFilter(const uint256& hashClient, const uint256& hashFork, const CLogsFilter& logsFilter)
 {
     return cntrBlock.AddLogsFilter(hashClient, hashFork, logsFilter);
@@ -2273,6 +2476,11 @@ uint256 CBlockChain::GetForkMintMinGasPrice(const uint256& hashFork)
     return cntrBlock.GetForkMintMinGasPrice(hashFork);
 }
 
+void CBlockChain::GetSaveBlockStat(storage::CSaveBlockStat& stat, const bool fReset)
+{
+    cntrBlock.GetSaveBlockStat(stat, fReset);
+}
+
 //------------------------------------------------------------------------------------------
 bool CBlockChain::VerifyVoteRewardTx(const CBlock& block, size_t& nRewardTxCount)
 {
@@ -2305,16 +2513,82 @@ bool CBlockChain::VerifyVoteRewardTx(const CBlock& block, size_t& nRewardTxCount
     return true;
 }
 
+void CBlockChain::PrefetchBlockDestState(const uint256& hashFork, const CBlock& block, std::map<CDestination, CDestState>& mapDestState)
+{
+    CBlockIndex* pIndexPrev = nullptr;
+    if (!cntrBlock.RetrieveIndex(block.hashPrev, &pIndexPrev))
+    {
+        return;
+    }
+    const uint256 hashPrevStateRoot = pIndexPrev->GetStateRoot();
+
+    // Every address the block pays from or to is read from the parent state,
+    // load them together on worker threads instead of one trie descent at a time.
+    // Only dest states are prefetched: template and contract address contexts come
+    // resolved in mapBlockAddress, and contract code is read by CBlockState when the
+    // block is executed, which has no cache this map could warm.
+    std::set<CDestination> setDest;
+    std::set<CDestination> setFromDest;
+    for (const CTransaction& tx : block.vtx)
+    {
+        if (!tx.GetFromAddress().IsNull())
+        {
+            setDest.insert(tx.GetFromAddress());
+            setFromDest.insert(tx.GetFromAddress());
+        }
+        if (tx.GetAmount() > 0)
+        {
+            setDest.insert(tx.GetToAddress());
+        }
+    }
+    const std::vector<CDestination> vDest(setDest.begin(), setDest.end());
+    std::vector<CDestState> vState(vDest.size());
+    std::vector<uint8> vFound(vDest.size(), 0);
+    auto lmdRetrieve = [&](const size_t i) {
+        vFound[i] = (cntrBlock.RetrieveDestState(hashFork, hashPrevStateRoot, vDest[i], vState[i]) ? 1 : 0);
+    };
+    if (vDest.size() < PREFETCH_PARALLEL_MIN_COUNT)
+    {
+        for (size_t i = 0; i < vDest.size(); i++)
+        {
+            lmdRetrieve(i);
+        }
+    }
+    else
+    {
+        ParallelComputer computer;
+        computer.Execute(vDest.size(), [](const size_t i) { return i; }, lmdRetrieve);
+    }
+
+    for (size_t i = 0; i < vDest.size(); i++)
+    {
+        if (!vFound[i])
+        {
+            if (setFromDest.count(vDest[i]) > 0)
+            {
+                StdLog("BlockChain", "Prefetch block dest state: Retrieve dest state fail, from: %s, block: %s",
+                       vDest[i].ToString().c_str(), block.GetHash().GetHex().c_str());
+            }
+            vState[i].SetNull();
+        }
+        mapDestState.insert(make_pair(vDest[i], vState[i]));
+    }
+}
+
 Errno CBlockChain::VerifyBlockTx(const uint256& hashFork, const uint256& hashBlock, const CBlock& block, const uint256& nReward,
-                                 const std::size_t nIgnoreVerifyTx, const std::map<CDestination, CAddressContext>& mapBlockAddress)
+                                 const std::size_t nIgnoreVerifyTx, const std::map<CDestination, CAddressContext>& mapBlockAddress,
+                                 const std::vector<uint256>& vSignVerifiedTxid)
 {
     uint256 nTotalFee;
     std::map<CDestination, CDestState> mapDestState;
     std::size_t nIgnoreTx = nIgnoreVerifyTx;
 
+    PrefetchBlockDestState(hashFork, block, mapDestState);
+
     // verify tx
-    for (const CTransaction& tx : block.vtx)
+    for (std::size_t nTx = 0; nTx < block.vtx.size(); nTx++)
     {
+        const CTransaction& tx = block.vtx[nTx];
         if (nIgnoreTx > 0)
         {
             nIgnoreTx--;
@@ -2374,7 +2648,9 @@ Errno CBlockChain::VerifyBlockTx(const uint256& hashFork, const uint256& hashBlo
                 }
                 CDestState& stateFrom = it->second;
 
-                Errno err = pCoreProtocol->VerifyTransaction(txid, tx, hashFork, block.hashPrev, block.GetBlockHeight(), stateFrom, mapBlockAddress);
+                // The prevalidated block shares only the header hash, so the signature result is used for the same tx only
+                const bool fSignVerified = (nTx < vSignVerifiedTxid.size() && vSignVerifiedTxid[nTx] == txid);
+                Errno err = pCoreProtocol->VerifyTransaction(txid, tx, hashFork, block.hashPrev, block.GetBlockHeight(), stateFrom, mapBlockAddress, fSignVerified);
                 if (err != OK)
                 {
                     StdLog("BlockChain", "Verify block tx: Verify transaction fail, err: %s, txid: %s", ErrorString(err), txid.ToString().c_str());
@@ -5,6 +5,8 @@
 #ifndef METABASENET_BLOCKCHAIN_H
 #define METABASENET_BLOCKCHAIN_H
 
+#include <algorithm>
+#include <deque>
 #include <map>
 #include <uint256.h>
 #include <utility>
@@ -45,6 +47,8 @@ public:
     bool RetrieveForkLast(const uint256& hashFork, uint256& hashLastBlock) override;
     bool GetForkStorageMaxHeight(const uint256& hashFork, uint32& nMaxHeight) override;
     Errno AddNewBlock(const CBlock& block, CBlockChainUpdate& update) override;
+    void PrevalidateBlock(const CBlock& block) override;
+    void RemovePrevalidatedBlock(const std::vector<uint256>& vBlockHash) override;
     Errno AddNewOrigin(const CBlock& block, CBlockChainUpdate& update) override;
     bool GetProofOfWorkTarget(const uint256& hashPrev, int nAlgo, int& nBits) override;
     bool GetBlockMintReward(const uint256& hashPrev, const bool fPow, uint256& nReward, const uint256& hashMainChainRefBlock) override;
@@ -84,6 +88,7 @@ public:
     bool GetForkContractCodeContext(const uint256& hashFork, const uint256& hashBlock, const uint256& hashContractCode, CContractCodeContext& ctxtContractCode) override;
     bool ListContractCreateCodeContext(const uint256& hashFork, const uint256& hashBlock, const uint256& txid, std::map<uint256, CContractCodeContext>& mapCreateCode) override;
     bool ListAddressTxInfo(const uint256& hashFork, const uint256& hashRefBlock, const CDestination& dest, const uint64 nBeginTxIndex, const uint64 nGetTxCount, const bool fReverse, std::vector<CDestTxInfo>& vAddressTxInfo) override;
+    bool GetAddressTxIndexLast(const uint256& hashFork, uint256& hashIndexBlock) override;
     bool GetCreateForkLockedAmount(const CDestination& dest, const uint256& hashPrevBlock, const bytes& btAddressData, uint256& nLockedAmount) override;
     bool VerifyAddressVoteRedeem(const CDestination& dest, const uint256& hashPrevBlock) override;
     bool GetVoteRewardLockedAmount(const uint256& hashFork, const uint256& hashPrevBlock, const CDestination& dest, uint256& nLockedAmount) override;
@@ -91,6 +96,7 @@ public:
     bool VerifyForkNameAndChainId(const uint256& hashFork, const CChainId nChainIdIn, const std::string& strForkName, const uint256& hashBlock = uint256()) override;
     bool GetForkHashByChainId(const CChainId nChainId, uint256& hashFork, const uint256& hashBlock = uint256()) override;
     bool RetrieveContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& key, bytes& value) override;
+    bool ListContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext) override;
     uint256 AddLogsFilter(const uint256& hashClient, const uint256& hashFork, const CLogsFilter& logsFilter) override;
     void RemoveFilter(const uint256& nFilterId) override;
     bool GetTxReceiptLogsByFilterId(const uint256& nFilterId, const bool fAll, ReceiptLogsVec& receiptLogs) override;
@@ -135,6 +141,7 @@ public:
 
     bool UpdateForkMintMinGasPrice(const uint256& hashFork, const uint256& nMinGasPrice) override;
     uint256 GetForkMintMinGasPrice(const uint256& hashFork) override;
+    void GetSaveBlockStat(storage::CSaveBlockStat& stat, const bool fReset = false) override;
 
 public:
     static int64 GetBlockInvestRewardTxMaxCount();
@@ -152,21 +159,39 @@ protected:
     Errno VerifyBlock(const uint256& hashBlock, const CBlock& block, CBlockIndex* pIndexPrev,
                       uint256& nReward, CDelegateAgreement& agreement, uint256& nEnrollTrust, CBlockIndex** ppIndexRef);
     bool VerifyBlockCertTx(const CBlock& block);
+    void PrefetchBlockDestState(const uint256& hashFork, const CBlock& block, std::map<CDestination, CDestState>& mapDestState);
 
     void InitCheckPoints();
     void InitCheckPoints(const uint256& hashFork, const std::map<int, uint256>& mapCheckPointsIn);
 
     bool VerifyVoteRewardTx(const CBlock& block, std::size_t& nRewardTxCount);
     Errno VerifyBlockTx(const uint256& hashFork, const uint256& hashBlock, const CBlock& block, const uint256& nReward,
-                        const std::size_t nIgnoreVerifyTx, const std::map<CDestination, CAddressContext>& mapBlockAddress);
+                        const std::size_t nIgnoreVerifyTx, const std::map<CDestination, CAddressContext>& mapBlockAddress,
+                        const std::vector<uint256>& vSignVerifiedTxid);
     bool CalcEndVoteReward(const uint256& hashPrev, const uint16 nBlockType, const int nBlockHeight, const uint32 nBlockTime,
                            const uint256& hashFork, const uint256& hashCalcEndBlock, const uint256& hashCalcEndMainChainRefBlock, std::vector<std::vector<CTransaction>>& vRewardList);
     bool CalcDistributeVoteReward(const uint256& hashCalcEndBlock, std::map<CDestination, std::pair<CDestination, uint256>>& mapVoteReward);
+    void WarmupCacheProc();
+    void AddressTxIndexProc();
+    void PrevalidateBlockProc();
+
+    class CBlockPrevalidated
+    {
+    public:
+        std::vector<uint256> vSignVerifiedTxid; // by vtx index, txid whose from address signature is verified, or 0
+    };
+    bool TakePrevalidatedBlock(const uint256& hashBlock, CBlockPrevalidated& prevalidated);
 
 protected:
     enum
     {
-        MAX_CACHE_DISTRIBUTE_VOTE_REWARD_BLOCK_COUNT = 8
+        MAX_CACHE_DISTRIBUTE_VOTE_REWARD_BLOCK_COUNT = 8,
+        PREFETCH_PARALLEL_MIN_COUNT = 8,
+        ADDRESS_TX_INDEX_BATCH_COUNT = 256,
+        ADDRESS_TX_INDEX_IDLE_SECONDS = 1,
+        ADDRESS_TX_INDEX_RETRY_SECONDS = 30,
+        MAX_PREVALIDATE_BLOCK_COUNT = 64,
+        PREVALIDATE_PARALLEL_MIN_COUNT = 8
     };
     ICoreProtocol* pCoreProtocol;
     ITxPool* pTxPool;
@@ -179,6 +204,15 @@ protected:
 
     std::map<uint256, MapCheckPointsType> mapForkCheckPoints;
     uint32 nMaxBlockRewardTxCount;
+    mtbase::CThread thrWarmup;
+    mtbase::CThread thrAddressTxIndex;
+    mtbase::CThread thrPrevalidate;
+
+    boost::mutex mtxPrevalidate;
+    boost::condition_variable condPrevalidate;
+    std::deque<std::pair<uint256, CBlock>> queuePrevalidate;
+    std::set<uint256> setPrevalidatePending;
+    mtbase::CCache<uint256, CBlockPrevalidated> cachePrevalidated; // first in, first out when full
 
     boost::shared_mutex rwCvrAccess;
     std::map<uint256, std::map<uint256, std::vector<std::vector<CTransaction>>>> mapCacheDistributeVoteReward;
@@ -361,7 +361,8 @@ bool CBlockMaker::ArrangeBlockTx(CBlock& block, const uint256& hashFork, const C
         StdError("blockmaker", "Arrange Block Tx: Calc Block Vote Reward Tx error, prev block: %s, fork: %s", block.hashPrev.ToString().c_str(), hashFork.ToString().c_str());
         return false;
     }
-    for (const CTransaction& tx : vVoteRewardTx)
+    block.vtx.reserve(block.vtx.size() + vVoteRewardTx.size());
+    for (CTransaction& tx : vVoteRewardTx)
     {
         size_t nTxSize = GetSerializeSize(tx);
         if (rewardTxSize + nTxSize > nRestOfSize)
@@ -369,9 +370,9 @@ bool CBlockMaker::ArrangeBlockTx(CBlock& block, const uint256& hashFork, const C
             StdError("blockmaker", "Arrange Block Tx: Reward tx size error, prev block: %s, fork: %s", block.hashPrev.ToString().c_str(), hashFork.ToString().c_str());
             return false;
         }
-        block.vtx.push_back(tx);
         nRewardTxTotalFee += tx.GetTxFee();
         rewardTxSize += nTxSize;
+        block.vtx.push_back(std::move(tx));
     }
 
     size_t nMaxTxSize = nRestOfSize - rewardTxSize;
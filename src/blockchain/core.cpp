@@ -356,6 +356,38 @@ Errno CCoreProtocol::ValidateBlock(const uint256& hashFork, const uint256& hashM
         return DEBUG(ERR_BLOCK_TIMESTAMP_OUT_OF_RANGE, "%ld", block.GetBlockTime());
     }
 
+    // Always run again, even for a prevalidated block: the result is found by the block hash,
+    // which covers neither the txs, the bloom data nor the signature of the block given here
+    Errno err = PrevalidateBlock(block);
+    if (err != OK)
+    {
+        return err;
+    }
+
+    // Validate mint tx
+    if (!block.txMint.IsMintTx() || ValidateTransaction(hashFork, hashMainChainRefBlock, block.txMint) != OK)
+    {
+        return DEBUG(ERR_BLOCK_TRANSACTIONS_INVALID, "invalid mint tx, tx type: %d", block.txMint.GetTxType());
+    }
+
+    for (const CTransaction& tx : block.vtx)
+    {
+        if (tx.IsMintTx() || ValidateTransaction(hashFork, hashMainChainRefBlock, tx) != OK)
+        {
+            return DEBUG(ERR_BLOCK_TRANSACTIONS_INVALID, "invalid tx %s", tx.GetHash().GetHex().c_str());
+        }
+    }
+
+    if (!CheckBlockSignature(hashFork, block))
+    {
+        return DEBUG(ERR_BLOCK_SIGNATURE_INVALID, "Check block signature fail");
+    }
+    return OK;
+}
+
+Errno CCoreProtocol::PrevalidateBlock(const CBlock& block)
+{
+    // Checks that depend on nothing but the block itself, so they may run ahead of its parent being stored
     if (!block.VerifyBlockProof())
     {
         return DEBUG(ERR_BLOCK_PROOF_OF_STAKE_INVALID, "block proof error");
@@ -376,12 +408,6 @@ Errno CCoreProtocol::ValidateBlock(const uint256& hashFork, const uint256& hashM
         }
     }
 
-    // Validate mint tx
-    if (!block.txMint.IsMintTx() || ValidateTransaction(hashFork, hashMainChainRefBlock, block.txMint) != OK)
-    {
-        return DEBUG(ERR_BLOCK_TRANSACTIONS_INVALID, "invalid mint tx, tx type: %d", block.txMint.GetTxType());
-    }
-
     size_t nBlockSize = GetSerializeSize(block);
     if (nBlockSize > MAX_BLOCK_SIZE)
     {
@@ -393,33 +419,18 @@ Errno CCoreProtocol::ValidateBlock(const uint256& hashFork, const uint256& hashM
         return DEBUG(ERR_BLOCK_TRANSACTIONS_INVALID, "origin block vtx is not empty");
     }
 
-    if (block.hashMerkleRoot != block.CalcMerkleTreeRoot())
+    vector<uint256> vTxHash;
+    block.GetTxHashList(vTxHash);
+    if (block.hashMerkleRoot != block.CalcMerkleTreeRoot(vTxHash))
     {
         return DEBUG(ERR_BLOCK_TXHASH_MISMATCH, "tx merkleroot mismatched");
     }
 
-    set<uint256> setTx;
-    for (auto& tx : block.vtx)
-    {
-        setTx.insert(tx.GetHash());
-    }
+    set<uint256> setTx(vTxHash.begin(), vTxHash.end());
     if (setTx.size() != block.vtx.size())
     {
         return DEBUG(ERR_BLOCK_DUPLICATED_TRANSACTION, "duplicate tx");
     }
-
-    for (const CTransaction& tx : block.vtx)
-    {
-        if (tx.IsMintTx() || ValidateTransaction(hashFork, hashMainChainRefBlock, tx) != OK)
-        {
-            return DEBUG(ERR_BLOCK_TRANSACTIONS_INVALID, "invalid tx %s", tx.GetHash().GetHex().c_str());
-        }
-    }
-
-    if (!CheckBlockSignature(hashFork, block))
-    {
-        return DEBUG(ERR_BLOCK_SIGNATURE_INVALID, "Check block signature fail");
-    }
     return OK;
 }
 
@@ -714,7 +725,7 @@ Errno CCoreProtocol::VerifySubsidiary(const CBlock& block, const CBlockIndex* pI
     return OK;
 }
 
-Errno CCoreProtocol::VerifyTransaction(const uint256& txid, const CTransaction& tx, const uint256& hashFork, const uint256& hashPrevBlock, const int nAtHeight, const CDestState& stateFrom, const std::map<CDestination, CAddressContext>& mapBlockAddress)
+Errno CCoreProtocol::VerifyTransaction(const uint256& txid, const CTransaction& tx, const uint256& hashFork, const uint256& hashPrevBlock, const int nAtHeight, const CDestState& stateFrom, const std::map<CDestination, CAddressContext>& mapBlockAddress, const bool fSignVerified)
 {
     Errno err = OK;
     if (stateFrom.GetBalance() < tx.GetAmount() + tx.GetTxFee())
@@ -875,6 +886,11 @@ Errno CCoreProtocol::VerifyTransaction(const uint256& txid, const CTransaction&
     {
         destSign = tx.GetFromAddress();
     }
+    // The caller may have verified the signature against the from address ahead of time, outside its lock
+    if (fSignVerified && destSign == tx.GetFromAddress())
+    {
+        return OK;
+    }
     if (!tx.VerifyTxSignature(destSign))
     {
         return DEBUG(ERR_TRANSACTION_SIGNATURE_INVALID, "Invalid signature, txid: %s", txid.ToString().c_str());
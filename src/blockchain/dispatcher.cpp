@@ -290,6 +290,88 @@ Errno CDispatcher::AddNewTx(const uint256& hashFork, const CTransaction& tx, uin
     return OK;
 }
 
+void CDispatcher::AddNewTx(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<Errno>& vErr, uint64 nNonce)
+{
+    vErr.assign(vtx.size(), ERR_BLOCK_INVALID_FORK);
+
+    uint256 hashMainChainLastBlock;
+    if (!pBlockChain->RetrieveForkLast(pCoreProtocol->GetGenesisBlockHash(), hashMainChainLastBlock))
+    {
+        StdError("Dispatcher", "Add New Tx: Get fork last block fail, fork: %s", hashFork.GetHex().c_str());
+        return;
+    }
+
+    std::vector<CTransaction> vValidTx;
+    std::vector<size_t> vValidIndex;
+    vValidTx.reserve(vtx.size());
+    vValidIndex.reserve(vtx.size());
+    for (size_t i = 0; i < vtx.size(); i++)
+    {
+        vErr[i] = pCoreProtocol->ValidateTransaction(hashFork, hashMainChainLastBlock, vtx[i]);
+        if (vErr[i] != OK)
+        {
+            StdError("Dispatcher", "Add New Tx: Validate transaction fail, txid: %s", vtx[i].GetHash().GetHex().c_str());
+            continue;
+        }
+        vValidTx.push_back(vtx[i]);
+        vValidIndex.push_back(i);
+    }
+    if (vValidTx.empty())
+    {
+        return;
+    }
+
+    // One pool lock for the whole batch
+    std::vector<Errno> vPushErr;
+    pTxPool->Push(hashFork, vValidTx, vPushErr);
+
+    std::vector<CTransaction> vBroadUserTx;
+    std::vector<CTransaction> vBroadCertTx;
+    std::vector<uint256> vPendingTxid;
+    for (size_t i = 0; i < vValidTx.size(); i++)
+    {
+        const CTransaction& tx = vValidTx[i];
+        vErr[vValidIndex[i]] = vPushErr[i];
+        if (vPushErr[i] != OK)
+        {
+            StdError("Dispatcher", "Add New Tx: TxPool Push fail, txid: %s", tx.GetHash().GetHex().c_str());
+            continue;
+        }
+        if (tx.IsCertTx())
+        {
+            vBroadCertTx.push_back(tx);
+        }
+        else
+        {
+            vBroadUserTx.push_back(tx);
+        }
+        vPendingTxid.push_back(tx.GetHash());
+    }
+    if (vPendingTxid.empty())
+    {
+        return;
+    }
+
+    pDataStat->AddP2pSynTxSynStatData(hashFork, vPendingTxid.size(), !!nNonce);
+    if (!nNonce)
+    {
+        if (!vBroadCertTx.empty())
+        {
+            pCertTxChannel->BroadcastCertTx(0, vBroadCertTx);
+        }
+        if (!vBroadUserTx.empty())
+        {
+            pUserTxChannel->BroadcastUserTx(0, hashFork, vBroadUserTx);
+        }
+        pDataStat->AddP2pSynTxSynStatData(hashFork, vPendingTxid.size(), false);
+    }
+
+    for (const uint256& txid : vPendingTxid)
+    {
+        pBlockChain->AddPendingTx(hashFork, txid);
+    }
+}
+
 bool CDispatcher::AddNewDistribute(const uint256& hashAnchor, const CDestination& dest, const vector<unsigned char>& vchDistribute)
 {
     return pConsensus->AddNewDistribute(hashAnchor, dest, vchDistribute);
@@ -18,6 +18,7 @@ public:
     ~CDispatcher();
     Errno AddNewBlock(const CBlock& block, uint64 nNonce = 0) override;
     Errno AddNewTx(const uint256& hashFork, const CTransaction& tx, uint64 nNonce = 0) override;
+    void AddNewTx(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<Errno>& vErr, uint64 nNonce = 0) override;
     bool AddNewDistribute(const uint256& hashAnchor, const CDestination& dest,
                           const std::vector<unsigned char>& vchDistribute) override;
     bool AddNewPublish(const uint256& hashAnchor, const CDestination& dest,
@@ -345,6 +345,15 @@ bool CBbEntry::InitializeModules(const EModeType& mode)
             {
                 return false;
             }
+
+            const CRPCServerConfig* pRPCConfig = CastConfigPtr<CRPCServerConfig*>(config.GetConfig());
+            for (std::size_t i = 0; i < pRPCConfig->vecRPCIsolateChainId.size(); i++)
+            {
+                if (!AttachModule(new CRPCMod(GetRPCIsolateModule(i), true)))
+                {
+                    return false;
+                }
+            }
             break;
         }
         case EModuleType::SERVICE:
@@ -456,7 +465,8 @@ bool CBbEntry::GetRPCHostConfig(std::vector<mtbase::CHttpHostConfig>& vHostCfg)
                             sslRPC,
                             mapUsrRPC,
                             pConfig->vRPCAllowIP,
-                            "rpcmod");
+                            "rpcmod",
+                            pConfig->nRPCMaxPending);
     vHostCfg.push_back(cfgHost);
 
     for (auto& vd : pConfig->vecChainIdRpcPort)
@@ -467,11 +477,25 @@ bool CBbEntry::GetRPCHostConfig(std::vector<mtbase::CHttpHostConfig>& vHostCfg)
         }
         cfgHost.nLinkChainId = vd.first;
         cfgHost.epHost = boost::asio::ip::tcp::endpoint(pConfig->epRPC.address(), vd.second);
+        cfgHost.strIOModule = "rpcmod";
+        for (std::size_t i = 0; i < pConfig->vecRPCIsolateChainId.size(); i++)
+        {
+            if (pConfig->vecRPCIsolateChainId[i].count(vd.first))
+            {
+                cfgHost.strIOModule = GetRPCIsolateModule(i);
+                break;
+            }
+        }
         vHostCfg.push_back(cfgHost);
     }
     return true;
 }
 
+std::string CBbEntry::GetRPCIsolateModule(const std::size_t nGroup)
+{
+    return std::string("rpcmod-") + std::to_string(nGroup + 1);
+}
+
 void CBbEntry::PurgeStorage()
 {
     path& pathData = config.GetConfig()->pathData;
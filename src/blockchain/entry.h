@@ -29,6 +29,7 @@ protected:
     bool AttachModule(mtbase::IBase* pBase);
 
     bool GetRPCHostConfig(std::vector<mtbase::CHttpHostConfig>& vHostCfg);
+    std::string GetRPCIsolateModule(const std::size_t nGroup);
 
     void PurgeStorage();
 
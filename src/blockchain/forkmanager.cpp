@@ -6,14 +6,107 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
-#include "template/fork.h"
-
 using namespace std;
 using namespace mtbase;
 
 namespace metabasenet
 {
 
+//////////////////////////////
+// CForkGraph
+
+CForkGraph::CForkGraph()
+  : fLoaded(false)
+{
+}
+
+bool CForkGraph::IsLoaded() const
+{
+    return fLoaded;
+}
+
+void CForkGraph::Clear()
+{
+    fLoaded = false;
+    mapForkGraph.clear();
+    mapForkParent.clear();
+    mapForkJoint.clear();
+}
+
+void CForkGraph::Load(const std::map<uint256, CForkContext>& mapForkCtxt, std::vector<uint256>& vNewFork)
+{
+    const std::map<uint256, CForkContext> mapPrevForkGraph = std::move(mapForkGraph);
+    Clear();
+    for (const auto& kv : mapForkCtxt)
+    {
+        if (AddFork(kv.second) && mapPrevForkGraph.count(kv.second.hashFork) == 0)
+        {
+            vNewFork.push_back(kv.second.hashFork);
+        }
+    }
+    fLoaded = true;
+}
+
+bool CForkGraph::AddFork(const CForkContext& ctxt)
+{
+    if (!mapForkGraph.insert(make_pair(ctxt.hashFork, ctxt)).second)
+    {
+        return false;
+    }
+    mapForkParent.insert(make_pair(ctxt.hashParent, ctxt.hashFork));
+    mapForkJoint.insert(make_pair(ctxt.hashJoint, ctxt.hashFork));
+    return true;
+}
+
+void CForkGraph::RemoveFork(const uint256& hashFork)
+{
+    auto it = mapForkGraph.find(hashFork);
+    if (it == mapForkGraph.end())
+    {
+        return;
+    }
+    for (auto mt = mapForkParent.lower_bound(it->second.hashParent); mt != mapForkParent.upper_bound(it->second.hashParent); ++mt)
+    {
+        if (mt->second == hashFork)
+        {
+            mapForkParent.erase(mt);
+            break;
+        }
+    }
+    for (auto mt = mapForkJoint.lower_bound(it->second.hashJoint); mt != mapForkJoint.upper_bound(it->second.hashJoint); ++mt)
+    {
+        if (mt->second == hashFork)
+        {
+            mapForkJoint.erase(mt);
+            break;
+        }
+    }
+    mapForkGraph.erase(it);
+}
+
+bool CForkGraph::ExistFork(const uint256& hashFork) const
+{
+    return (mapForkGraph.count(hashFork) > 0);
+}
+
+bool CForkGraph::ExistChildFork(const uint256& hashParent) const
+{
+    return (mapForkParent.count(hashParent) > 0);
+}
+
+void CForkGraph::ListJointFork(const uint256& hashJoint, std::vector<uint256>& vFork) const
+{
+    for (auto it = mapForkJoint.lower_bound(hashJoint); it != mapForkJoint.upper_bound(hashJoint); ++it)
+    {
+        vFork.push_back(it->second);
+    }
+}
+
+const std::map<uint256, CForkContext>& CForkGraph::GetForks() const
+{
+    return mapForkGraph;
+}
+
 //////////////////////////////
 // CForkManager
 
@@ -94,26 +187,37 @@ void CForkManager::HandleHalt()
     setGroupAllowed.clear();
     setForkExcluded.clear();
     fAllowAnyFork = false;
+
+    forkGraph.Clear();
 }
 
 bool CForkManager::GetActiveFork(std::vector<uint256>& vActive)
 {
-    boost::shared_lock<boost::shared_mutex> rlock(rwAccess);
+    // Readers of IsAllowed are not blocked while listing, only the graph load and
+    // the active set update take the write lock
+    boost::upgrade_lock<boost::shared_mutex> ulock(rwAccess);
 
-    std::map<uint256, CForkContext> mapForkCtxt;
-    if (!pBlockChain->ListForkContext(mapForkCtxt))
+    if (!forkGraph.IsLoaded())
     {
-        return false;
+        boost::upgrade_to_unique_lock<boost::shared_mutex> wlock(ulock);
+        vector<uint256> vNewFork;
+        if (!LoadForkGraph(vNewFork))
+        {
+            return false;
+        }
     }
-    for (const auto& kv : mapForkCtxt)
+
+    const size_t nStart = vActive.size();
+    for (const auto& kv : forkGraph.GetForks())
     {
-        const uint256& hashFork = kv.first;
-        if (IsAllowedFork(hashFork))
+        if (IsAllowedFork(kv.first))
         {
-            vActive.push_back(hashFork);
-            setCurActiveFork.insert(hashFork);
+            vActive.push_back(kv.first);
         }
     }
+
+    boost::upgrade_to_unique_lock<boost::shared_mutex> wlock(ulock);
+    setCurActiveFork.insert(vActive.begin() + nStart, vActive.end());
     return true;
 }
 
@@ -127,88 +231,48 @@ void CForkManager::ForkUpdate(const CBlockChainUpdate& update, vector<uint256>&
 {
     boost::unique_lock<boost::shared_mutex> wlock(rwAccess);
 
-    std::map<uint256, CForkContext> mapForkCtxt;
-    if (!pBlockChain->ListForkContext(mapForkCtxt))
-    {
-        return;
-    }
-    std::multimap<uint256, uint256> mapForkParent;
-    std::multimap<uint256, uint256> mapForkJoint;
-    for (const auto& kv : mapForkCtxt)
-    {
-        mapForkParent.insert(make_pair(kv.second.hashParent, kv.first));
-        mapForkJoint.insert(make_pair(kv.second.hashJoint, kv.first));
-    }
-
-    if (mapForkParent.count(update.hashFork) > 0)
+    if (update.hashFork == pCoreProtocol->GetGenesisBlockHash())
     {
-        for (const CBlockEx& block : boost::adaptors::reverse(update.vBlockAddNew))
+        vector<uint256> vNewFork;
+        if (forkGraph.IsLoaded() && update.fForkDelta)
         {
-            if (!block.IsExtended() && !block.IsVacant())
+            // Apply the fork changes recorded when the primary blocks were committed
+            for (const uint256& hashFork : update.vForkRemoved)
             {
-                const uint256 hashBlock = block.GetHash();
-                auto it = mapForkJoint.lower_bound(hashBlock);
-                while (it != mapForkJoint.upper_bound(hashBlock))
-                {
-                    const uint256& hashFork = it->second;
-                    if (IsAllowedFork(hashFork))
-                    {
-                        vActive.push_back(hashFork);
-                    }
-                    ++it;
-                }
+                forkGraph.RemoveFork(hashFork);
             }
-        }
-    }
-
-    if (update.hashFork == pCoreProtocol->GetGenesisBlockHash())
-    {
-        for (const CBlockEx& block : boost::adaptors::reverse(update.vBlockAddNew))
-        {
-            for (size_t i = 0; i < block.vtx.size(); i++)
+            for (const uint256& hashFork : update.vForkCreated)
             {
-                const CTransaction& tx = block.vtx[i];
-
-                CAddressContext ctxAddress;
-                if (!pBlockChain->GetTxToAddressContext(update.hashFork, block.hashPrev, tx, ctxAddress))
+                CForkContext ctxt;
+                if (!pBlockChain->GetForkContext(hashFork, ctxt))
                 {
+                    StdLog("CForkManager", "Fork update: Get fork context fail, fork: %s", hashFork.ToString().c_str());
                     continue;
                 }
-
-                if (ctxAddress.IsTemplate() && ctxAddress.GetTemplateType() == TEMPLATE_FORK)
+                if (forkGraph.AddFork(ctxt))
                 {
-                    bytes btTempData;
-                    if (!tx.GetTxData(CTransaction::DF_FORKDATA, btTempData))
-                    {
-                        continue;
-                    }
-                    CBlock blockOrigin;
-                    try
-                    {
-                        CBufStream ss(btTempData);
-                        ss >> blockOrigin;
-                    }
-                    catch (std::exception& e)
-                    {
-                        continue;
-                    }
-                    uint256 hashNewFork = blockOrigin.GetHash();
-                    if (mapForkCtxt.count(hashNewFork) > 0)
-                    {
-                        if (IsAllowedFork(hashNewFork))
-                        {
-                            vActive.push_back(hashNewFork);
-                        }
-                    }
+                    vNewFork.push_back(hashFork);
                 }
             }
         }
+        else if (!LoadForkGraph(vNewFork))
+        {
+            return;
+        }
+
+        for (const uint256& hashFork : vNewFork)
+        {
+            if (setCurActiveFork.count(hashFork) == 0 && IsAllowedFork(hashFork))
+            {
+                vActive.push_back(hashFork);
+                setCurActiveFork.insert(hashFork);
+            }
+        }
 
         auto it = setCurActiveFork.begin();
         while (it != setCurActiveFork.end())
         {
-            auto mt = mapForkCtxt.find(*it);
-            if (mt == mapForkCtxt.end())
+            if (!forkGraph.ExistFork(*it))
             {
                 vDeactive.push_back(*it);
                 setCurActiveFork.erase(it++);
@@ -218,12 +282,31 @@ void CForkManager::ForkUpdate(const CBlockChainUpdate& update, vector<uint256>&
                 ++it;
             }
         }
+    }
+    else if (!forkGraph.IsLoaded())
+    {
+        vector<uint256> vNewFork;
+        if (!LoadForkGraph(vNewFork))
+        {
+            return;
+        }
+    }
 
-        for (const auto& kv : mapForkCtxt)
+    if (forkGraph.ExistChildFork(update.hashFork))
+    {
+        for (const CBlockEx& block : boost::adaptors::reverse(update.vBlockAddNew))
         {
-            if (setCurActiveFork.count(kv.first) == 0 && IsAllowedFork(kv.first))
+            if (!block.IsExtended() && !block.IsVacant())
             {
-                setCurActiveFork.insert(kv.first);
+                vector<uint256> vJointFork;
+                forkGraph.ListJointFork(block.GetHash(), vJointFork);
+                for (const uint256& hashFork : vJointFork)
+                {
+                    if (IsAllowedFork(hashFork))
+                    {
+                        vActive.push_back(hashFork);
+                    }
+                }
             }
         }
     }
@@ -269,4 +352,16 @@ bool CForkManager::IsAllowedFork(const uint256& hashFork) const
     return false;
 }
 
+bool CForkManager::LoadForkGraph(std::vector<uint256>& vNewFork)
+{
+    std::map<uint256, CForkContext> mapForkCtxt;
+    if (!pBlockChain->ListForkContext(mapForkCtxt))
+    {
+        StdLog("CForkManager", "Load fork graph: List fork context fail");
+        return false;
+    }
+    forkGraph.Load(mapForkCtxt, vNewFork);
+    return true;
+}
+
 } // namespace metabasenet
@@ -16,6 +16,30 @@
 namespace metabasenet
 {
 
+// Forks with their parent and joint block, loaded from the fork contexts
+// and kept up to date from the fork deltas of the primary blocks
+class CForkGraph
+{
+public:
+    CForkGraph();
+    bool IsLoaded() const;
+    void Clear();
+    // Replace the graph, vNewFork gets the forks not in the previous graph (all when not loaded)
+    void Load(const std::map<uint256, CForkContext>& mapForkCtxt, std::vector<uint256>& vNewFork);
+    bool AddFork(const CForkContext& ctxt);
+    void RemoveFork(const uint256& hashFork);
+    bool ExistFork(const uint256& hashFork) const;
+    bool ExistChildFork(const uint256& hashParent) const;
+    void ListJointFork(const uint256& hashJoint, std::vector<uint256>& vFork) const;
+    const std::map<uint256, CForkContext>& GetForks() const;
+
+protected:
+    bool fLoaded;
+    std::map<uint256, CForkContext> mapForkGraph;
+    std::multimap<uint256, uint256> mapForkParent;
+    std::multimap<uint256, uint256> mapForkJoint;
+};
+
 class CForkManager : public IForkManager
 {
 public:
@@ -31,6 +55,7 @@ protected:
     bool HandleInvoke() override;
     void HandleHalt() override;
     bool IsAllowedFork(const uint256& hashFork) const;
+    bool LoadForkGraph(std::vector<uint256>& vNewFork);
 
 protected:
     mutable boost::shared_mutex rwAccess;
@@ -43,6 +68,8 @@ protected:
     std::set<uint256> setForkExcluded;
 
     std::set<uint256> setCurActiveFork;
+
+    CForkGraph forkGraph;
 };
 
 } // namespace metabasenet
@@ -5,6 +5,7 @@
 #include "mode/rpc_config.h"
 
 #include <boost/algorithm/algorithm.hpp>
+#include <boost/algorithm/string.hpp>
 
 #include "mode/config_macro.h"
 
@@ -155,6 +156,56 @@ bool CRPCServerConfig::PostLoad()
         }
     }
 
+    // Each -rpcisolate value is one worker group, a chain id without its own rpc port or in two groups is a config error
+    std::set<uint32> setIsolateChainId;
+    for (const string& strIsolate : vRPCIsolate)
+    {
+        std::vector<string> vChainId;
+        boost::split(vChainId, strIsolate, boost::is_any_of(","), boost::token_compress_on);
+
+        std::set<uint32> setGroup;
+        for (const string& strChainId : vChainId)
+        {
+            if (strChainId.empty())
+            {
+                continue;
+            }
+            uint32 nTempChainId = (uint32)std::stol(strChainId);
+            if (setGroup.count(nTempChainId) > 0)
+            {
+                continue;
+            }
+            bool fHasPort = false;
+            for (auto& vd : vecChainIdRpcPort)
+            {
+                if (vd.first == nTempChainId)
+                {
+                    fHasPort = true;
+                    break;
+                }
+            }
+            if (!fHasPort)
+            {
+                printf("rpcisolate chainid %u has no chainidrpcport!\n", nTempChainId);
+                return false;
+            }
+            if (!setIsolateChainId.insert(nTempChainId).second)
+            {
+                printf("rpcisolate chainid %u is already in another group!\n", nTempChainId);
+                return false;
+            }
+            setGroup.insert(nTempChainId);
+        }
+        if (!setGroup.empty())
+        {
+            vecRPCIsolateChainId.push_back(setGroup);
+        }
+    }
+    if (nRPCIsolateThreads == 0)
+    {
+        nRPCIsolateThreads = 1;
+    }
+
     return true;
 }
 
@@ -167,6 +218,15 @@ std::string CRPCServerConfig::ListConfig() const
     {
         oss << "chainid: " << vd.first << ", rpcport: " << vd.second << "\n";
     }
+    for (std::size_t i = 0; i < vecRPCIsolateChainId.size(); i++)
+    {
+        oss << "rpc isolate group " << i + 1 << ", chainid:";
+        for (const uint32 nChainId : vecRPCIsolateChainId[i])
+        {
+            oss << " " << nChainId;
+        }
+        oss << "\n";
+    }
     return CRPCBasicConfig::ListConfig() + oss.str();
 }
 
@@ -7,6 +7,7 @@
 
 #include <boost/asio.hpp>
 #include <boost/filesystem.hpp>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,7 @@ public:
 public:
     boost::asio::ip::tcp::endpoint epRPC;
     std::vector<std::pair<uint32, uint16>> vecChainIdRpcPort;
+    std::vector<std::set<uint32>> vecRPCIsolateChainId;
 };
 
 class CRPCClientConfig : virtual public CRPCBasicConfig, virtual public CRPCClientConfigOption
@@ -745,6 +745,21 @@ bool CNetChannel::HandleEvent(network::CEventPeerInv& eventInv)
             throw runtime_error(string("Inv count overflow, size: ") + to_string(eventInv.data.size()));
         }
 
+        size_t nTxInvCount = 0;
+        for (const network::CInv& inv : eventInv.data)
+        {
+            if (inv.nType == network::CInv::MSG_TX)
+            {
+                nTxInvCount++;
+            }
+        }
+        size_t nTxInvAllow = ConsumePeerTxInv(nNonce, nTxInvCount);
+        if (nTxInvAllow < nTxInvCount)
+        {
+            StdLog("NetChannel", "CEventPeerInv: peer: %s, tx inv rate limited, allow: %lu, count: %lu, fork: %s",
+                   GetPeerAddressInfo(nNonce).c_str(), nTxInvAllow, nTxInvCount, hashFork.GetHex().c_str());
+        }
+
         {
             boost::recursive_mutex::scoped_lock scoped_lock(mtxSched);
             CSchedule& sched = GetSchedule(hashFork);
@@ -772,6 +787,11 @@ bool CNetChannel::HandleEvent(network::CEventPeerInv& eventInv)
             {
                 if (inv.nType == network::CInv::MSG_TX)
                 {
+                    if (vTxHash.size() >= nTxInvAllow)
+                    {
+                        // Over the peer's budget, the tx stays unknown so other peers can still announce it
+                        continue;
+                    }
                     vTxHash.push_back(inv.nHash);
                     do
                     {
@@ -846,7 +866,7 @@ bool CNetChannel::HandleEvent(network::CEventPeerInv& eventInv)
                     } while (0);
                 }
             }
-            if (!vTxHash.empty())
+            if (nTxInvCount > 0)
             {
                 StdTrace("NetChannel", "CEventPeerInv: recv tx inv request and send response, count: %ld, peer: %s, fork: %s",
                          vTxHash.size(), GetPeerAddressInfo(nNonce).c_str(), hashFork.GetHex().c_str());
@@ -901,10 +921,31 @@ bool CNetChannel::HandleEvent(network::CEventPeerGetData& eventGetData)
     uint64 nNonce = eventGetData.nNonce;
     const uint256& hashFork = eventGetData.hashFork;
     network::CEventPeerGetFail eventGetFail(nNonce, hashFork);
+    size_t nTxGetCount = 0;
     for (const network::CInv& inv : eventGetData.data)
     {
         if (inv.nType == network::CInv::MSG_TX)
         {
+            nTxGetCount++;
+        }
+    }
+    size_t nTxGetAllow = ConsumePeerTxGetData(nNonce, nTxGetCount);
+    if (nTxGetAllow < nTxGetCount)
+    {
+        StdLog("NetChannel", "CEventPeerGetData: peer: %s, tx getdata rate limited, allow: %lu, count: %lu, fork: %s",
+               GetPeerAddressInfo(nNonce).c_str(), nTxGetAllow, nTxGetCount, hashFork.GetHex().c_str());
+    }
+    for (const network::CInv& inv : eventGetData.data)
+    {
+        if (inv.nType == network::CInv::MSG_TX)
+        {
+            if (nTxGetAllow == 0)
+            {
+                eventGetFail.data.push_back(inv);
+                continue;
+            }
+            nTxGetAllow--;
+
             network::CEventPeerTx eventTx(nNonce, hashFork);
             CTransaction tx;
             uint256 hashAtFork;
@@ -1742,6 +1783,8 @@ void CNetChannel::AddNewBlock(const uint256& hashFork, const uint256& hash, CSch
                 }
             }
 
+            PrevalidateNextBlock(hashBlock, sched);
+
             Errno err = pDispatcher->AddNewBlock(*pBlock, nNonceSender);
             if (err == OK)
             {
@@ -1829,6 +1872,33 @@ void CNetChannel::AddNewBlock(const uint256& hashFork, const uint256& hash, CSch
     }
 }
 
+void CNetChannel::PrevalidateNextBlock(const uint256& hashBlock, CSchedule& sched)
+{
+    // Results of blocks the schedule has dropped since the last call are no longer needed
+    vector<uint256> vRemovedBlock;
+    sched.GetRemovedBlock(vRemovedBlock);
+    if (!vRemovedBlock.empty())
+    {
+        pBlockChain->RemovePrevalidatedBlock(vRemovedBlock);
+    }
+
+    // Queue the blocks waiting behind this one, their stateless checks overlap with its execution
+    vector<uint256> vNextBlock;
+    sched.GetNextBlock(hashBlock, vNextBlock);
+    for (size_t i = 0; i < vNextBlock.size() && i < PREVALIDATE_NEXT_BLOCK_COUNT; i++)
+    {
+        // GetNextBlock appends to vNextBlock, so do not pass it a reference into the vector
+        const uint256 hashNext = vNextBlock[i];
+        uint64 nNonceSender = 0;
+        CBlock* pBlock = sched.GetBlock(hashNext, nNonceSender);
+        if (pBlock != nullptr)
+        {
+            pBlockChain->PrevalidateBlock(*pBlock);
+            sched.GetNextBlock(hashNext, vNextBlock);
+        }
+    }
+}
+
 void CNetChannel::AddNewTx(const uint256& hashFork, const uint256& txid, CSchedule& sched,
                            set<uint64>& setSchedPeer, set<uint64>& setMisbehavePeer)
 {
@@ -2058,7 +2128,7 @@ bool CNetChannel::PushTxInv(const uint256& hashFork)
     if (fAllowSynTxInv)
     {
         vector<uint256> vTxPool;
-        pTxPool->ListTx(hashFork, vTxPool);
+        pTxPool->ListRelayTx(hashFork, vTxPool);
         if (!vTxPool.empty() && !mapPeer.empty())
         {
             boost::unique_lock<boost::shared_mutex> rlock(rwNetPeer);
@@ -2163,6 +2233,36 @@ void CNetChannel::UpdateValidFork(const set<uint256>& setValidFork)
     }
 }
 
+size_t CNetChannel::ConsumePeerTxInv(uint64 nNonce, size_t nCount)
+{
+    if (nCount == 0)
+    {
+        return 0;
+    }
+    boost::unique_lock<boost::shared_mutex> wlock(rwNetPeer);
+    map<uint64, CNetChannelPeer>::iterator it = mapPeer.find(nNonce);
+    if (it != mapPeer.end())
+    {
+        return it->second.rateTxInv.Consume(nCount, GetTimeMillis());
+    }
+    return nCount;
+}
+
+size_t CNetChannel::ConsumePeerTxGetData(uint64 nNonce, size_t nCount)
+{
+    if (nCount == 0)
+    {
+        return 0;
+    }
+    boost::unique_lock<boost::shared_mutex> wlock(rwNetPeer);
+    map<uint64, CNetChannelPeer>::iterator it = mapPeer.find(nNonce);
+    if (it != mapPeer.end())
+    {
+        return it->second.rateTxGetData.Consume(nCount, GetTimeMillis());
+    }
+    return nCount;
+}
+
 const string CNetChannel::GetPeerAddressInfo(uint64 nNonce)
 {
     boost::shared_lock<boost::shared_mutex> wlock(rwNetPeer);
@@ -12,6 +12,32 @@
 namespace metabasenet
 {
 
+class CNetChannelRateLimit
+{
+public:
+    CNetChannelRateLimit(const int64 nRateIn, const int64 nBurstIn)
+      : nRate(nRateIn), nBurst(nBurstIn), nTokens(nBurstIn * 1000), nLastTime(0) {}
+
+    // Token bucket, refills nRate tokens per second up to nBurst, returns the number of tokens granted
+    std::size_t Consume(const std::size_t nCount, const int64 nTimeMillis)
+    {
+        if (nTimeMillis > nLastTime)
+        {
+            nTokens = std::min(nBurst * 1000, nTokens + (nTimeMillis - nLastTime) * nRate);
+            nLastTime = nTimeMillis;
+        }
+        std::size_t nAllow = std::min(nCount, (std::size_t)(nTokens / 1000));
+        nTokens -= (int64)nAllow * 1000;
+        return nAllow;
+    }
+
+protected:
+    int64 nRate;
+    int64 nBurst;
+    int64 nTokens; // in thousandths of a token
+    int64 nLastTime;
+};
+
 class CNetChannelPeer
 {
     class CNetChannelPeerFork
@@ -146,9 +172,10 @@ class CNetChannelPeer
     };
 
 public:
-    CNetChannelPeer() {}
+    CNetChannelPeer()
+      : rateTxInv(PEER_TX_INV_RATE, PEER_TX_INV_BURST), rateTxGetData(PEER_TX_GETDATA_RATE, PEER_TX_GETDATA_BURST) {}
     CNetChannelPeer(uint64 nServiceIn, const network::CAddress& addr, const uint256& hashPrimary)
-      : nService(nServiceIn), addressRemote(addr)
+      : nService(nServiceIn), addressRemote(addr), rateTxInv(PEER_TX_INV_RATE, PEER_TX_INV_BURST), rateTxGetData(PEER_TX_GETDATA_RATE, PEER_TX_GETDATA_BURST)
     {
         mapSubscribedFork.insert(std::make_pair(hashPrimary, CNetChannelPeerFork()));
 
@@ -235,12 +262,22 @@ public:
         CHECK_SYNTXINV_STATUS_RESULT_WAIT_TIMEOUT,
         CHECK_SYNTXINV_STATUS_RESULT_ALLOW_SYN
     };
+    // Per peer budget of incoming tx invs and tx getdata items, per second
+    enum
+    {
+        PEER_TX_INV_RATE = network::CInv::MAX_INV_COUNT / 2,
+        PEER_TX_INV_BURST = network::CInv::MAX_INV_COUNT * 2,
+        PEER_TX_GETDATA_RATE = network::CInv::MAX_INV_COUNT / 2,
+        PEER_TX_GETDATA_BURST = network::CInv::MAX_INV_COUNT * 2
+    };
 
 public:
     uint64 nService;
     network::CAddress addressRemote;
     std::string strRemoteAddress;
     std::map<uint256, CNetChannelPeerFork> mapSubscribedFork;
+    CNetChannelRateLimit rateTxInv;
+    CNetChannelRateLimit rateTxGetData;
 };
 
 class CNetChannel : public network::INetChannel
@@ -268,7 +305,8 @@ protected:
     };
     enum
     {
-        MAX_PEER_SCHED_COUNT = 8
+        MAX_PEER_SCHED_COUNT = 8,
+        PREVALIDATE_NEXT_BLOCK_COUNT = 8
     };
     enum
     {
@@ -312,6 +350,7 @@ protected:
     void AddNewBlock(const uint256& hashFork, const uint256& hash, CSchedule& sched,
                      std::set<uint64>& setSchedPeer, std::set<uint64>& setMisbehavePeer,
                      std::vector<std::pair<uint256, uint256>>& vRefNextBlock, bool fCheckPow);
+    void PrevalidateNextBlock(const uint256& hashBlock, CSchedule& sched);
     void AddNewTx(const uint256& hashFork, const uint256& txid, CSchedule& sched,
                   std::set<uint64>& setSchedPeer, std::set<uint64>& setMisbehavePeer);
     void AddRefNextBlock(const std::vector<std::pair<uint256, uint256>>& vRefNextBlock);
@@ -321,6 +360,8 @@ protected:
     bool PushTxInv(const uint256& hashFork);
     void ForkUpdateTimerFunc(uint32 nTimerId);
     void UpdateValidFork(const std::set<uint256>& setValidFork);
+    size_t ConsumePeerTxInv(uint64 nNonce, size_t nCount);
+    size_t ConsumePeerTxGetData(uint64 nNonce, size_t nCount);
     const string GetPeerAddressInfo(uint64 nNonce);
     bool CheckPrevBlock(const uint256& hash, CSchedule& sched, uint256& hashFirst, uint256& hashPrev);
     void InnerBroadcastBlockInv(const uint256& hashFork, const uint256& hashBlock);
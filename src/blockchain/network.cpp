@@ -38,7 +38,8 @@ bool CNetwork::HandleInitialize()
     }
 
     Configure(NETWORK_NETID /*NetworkConfig()->nMagicNum*/, PROTO_VERSION, network::NODE_NETWORK | network::NODE_DELEGATED,
-              FormatSubVersion(), !NetworkConfig()->vConnectTo.empty(), pCoreProtocol->GetGenesisBlockHash());
+              FormatSubVersion(), !NetworkConfig()->vConnectTo.empty(), pCoreProtocol->GetGenesisBlockHash(),
+              NetworkConfig()->nMsgCompressSize);
 
     CPeerNetConfig config;
     if (NetworkConfig()->fListen || NetworkConfig()->fListen4)
@@ -107,6 +108,11 @@ bool CNetwork::HandleInitialize()
                                boost::any(uint64(network::NODE_NETWORK)));
     }
 
+    if (NetworkConfig()->vConnectTo.empty())
+    {
+        config.pathAddressBook = NetworkConfig()->pathData / "peers.dat";
+    }
+
     ConfigNetwork(config);
 
     return network::CBbPeerNet::HandleInitialize();
@@ -5,6 +5,7 @@
 #include "recovery.h"
 
 #include <boost/filesystem.hpp>
+#include <cinttypes>
 
 #include "block.h"
 #include "core.h"
@@ -20,12 +21,14 @@ class CRecoveryWalker : public storage::CTSWalker<CBlockEx>
 {
 public:
     CRecoveryWalker(IDispatcher* pDispatcherIn, const size_t nSizeIn)
-      : pDispatcher(pDispatcherIn), nSize(nSizeIn), nNextSize(nSizeIn / 100), nWalkedFileSize(0) {}
+      : pDispatcher(pDispatcherIn), nSize(nSizeIn), nNextSize(nSizeIn / 100), nWalkedFileSize(0), nImportTicks(0) {}
     bool Walk(const CBlockEx& t, uint32 nFile, uint32 nOffset) override
     {
         if (!t.IsGenesis())
         {
+            mtbase::CTicks tImport;
             Errno err = pDispatcher->AddNewBlock(t);
+            nImportTicks += tImport.Elapse();
             if (err == OK)
             {
                 mtbase::StdTrace("Recovery", "Recovery block [%s]", t.GetHash().ToString().c_str());
@@ -47,6 +50,9 @@ class CRecoveryWalker : public storage::CTSWalker<CBlockEx>
         return true;
     }
 
+public:
+    int64 nImportTicks;
+
 protected:
     IDispatcher* pDispatcher;
     const size_t nSize;
@@ -55,7 +61,7 @@ class CRecoveryWalker : public storage::CTSWalker<CBlockEx>
 };
 
 CRecovery::CRecovery()
-  : pDispatcher(nullptr)
+  : pDispatcher(nullptr), pBlockChain(nullptr)
 {
 }
 
@@ -71,6 +77,12 @@ bool CRecovery::HandleInitialize()
         return false;
     }
 
+    if (!GetObject("blockchain", pBlockChain))
+    {
+        Error("Failed to request blockchain");
+        return false;
+    }
+
     if (!StorageConfig()->strRecoveryDir.empty())
     {
         Warn("Clear old database except wallet address");
@@ -92,6 +104,7 @@ bool CRecovery::HandleInitialize()
 void CRecovery::HandleDeinitialize()
 {
     pDispatcher = nullptr;
+    pBlockChain = nullptr;
 }
 
 bool CRecovery::HandleInvoke()
@@ -114,6 +127,9 @@ bool CRecovery::HandleInvoke()
             return false;
         }
 
+        storage::CSaveBlockStat stat;
+        pBlockChain->GetSaveBlockStat(stat, true);
+
         size_t nSize = tsBlock.GetSize();
         CRecoveryWalker walker(pDispatcher, nSize);
         uint32 nLastFile;
@@ -124,10 +140,29 @@ bool CRecovery::HandleInvoke()
             return false;
         }
         mtbase::StdLog("CRecovery", "CRecovery", "....................... Recovered success .......................");
+        ReportImportStat(walker.nImportTicks);
 
         mtbase::StdLog("CRecovery", "Recovery [%s] end", StorageConfig()->strRecoveryDir.c_str());
     }
     return true;
 }
 
+void CRecovery::ReportImportStat(const int64 nImportTicks)
+{
+    storage::CSaveBlockStat stat;
+    pBlockChain->GetSaveBlockStat(stat);
+
+    // CTicks are microseconds
+    const double dSeconds = (double)nImportTicks / 1000000;
+    mtbase::StdLog("CRecovery", "Import stat: blocks: %" PRIu64 ", txs: %" PRIu64 ", time: %.3fs, blocks/s: %.2f, tx/s: %.2f",
+                   stat.nBlockCount, stat.nTxCount, dSeconds,
+                   (dSeconds > 0 ? stat.nBlockCount / dSeconds : 0.0), (dSeconds > 0 ? stat.nTxCount / dSeconds : 0.0));
+    for (int i = 0; i < storage::CSaveBlockStat::STAGE_MAX; i++)
+    {
+        mtbase::StdLog("CRecovery", "Import stat: stage [%s]: %.3fms, %.1f%%",
+                       storage::CSaveBlockStat::GetStageName(i), (double)stat.nStageTicks[i] / 1000,
+                       (nImportTicks > 0 ? stat.nStageTicks[i] * 100.0 / nImportTicks : 0.0));
+    }
+}
+
 } // namespace metabasenet
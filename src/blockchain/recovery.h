@@ -21,8 +21,11 @@ protected:
     void HandleDeinitialize() override;
     bool HandleInvoke() override;
 
+    void ReportImportStat(const int64 nImportTicks);
+
 protected:
     IDispatcher* pDispatcher;
+    IBlockChain* pBlockChain;
 };
 
 } // namespace metabasenet
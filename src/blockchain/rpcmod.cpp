@@ -311,11 +311,109 @@ static CEthBlock EthBlockToJSON(const CBlock& block, const bool fTxDetail)
     return data;
 }
 
+///////////////////////////////
+// CRPCResultCache
+
+CRPCResultCache::CRPCResultCache()
+  : nMaxBytes(0), nUsedBytes(0), nConfirmations(0)
+{
+}
+
+void CRPCResultCache::Configure(const size_t nMaxBytesIn, const uint32 nConfirmationsIn)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+    nMaxBytes = nMaxBytesIn;
+    nConfirmations = nConfirmationsIn;
+    cntrEntry.clear();
+    mapForkTip.clear();
+    nUsedBytes = 0;
+}
+
+bool CRPCResultCache::Retrieve(const string& strKey, string& strResult)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+    auto it = cntrEntry.find(strKey);
+    if (it == cntrEntry.end())
+    {
+        return false;
+    }
+    strResult = it->strResult;
+
+    CCacheEntryList& listEntry = cntrEntry.get<1>();
+    listEntry.relocate(listEntry.end(), cntrEntry.project<1>(it));
+    return true;
+}
+
+void CRPCResultCache::AddNew(const string& strKey, const uint256& hashFork, const uint64 nBlockNumber,
+                             const uint256& hashBlock, const string& strResult)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+    CCacheEntry entry(strKey, hashFork, nBlockNumber, hashBlock, strResult);
+    if (nMaxBytes == 0 || entry.GetSize() > nMaxBytes / 8)
+    {
+        return;
+    }
+    if (!cntrEntry.insert(entry).second)
+    {
+        return;
+    }
+    nUsedBytes += entry.GetSize();
+
+    CCacheEntryList& listEntry = cntrEntry.get<1>();
+    while (nUsedBytes > nMaxBytes && !listEntry.empty())
+    {
+        nUsedBytes -= listEntry.front().GetSize();
+        listEntry.pop_front();
+    }
+}
+
+void CRPCResultCache::GetForkTip(map<uint256, pair<uint64, uint256>>& mapTip)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+    mapTip = mapForkTip;
+}
+
+void CRPCResultCache::SetForkTip(const uint256& hashFork, const uint64 nBlockNumber, const uint256& hashBlock)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+    mapForkTip[hashFork] = make_pair(nBlockNumber, hashBlock);
+}
+
+size_t CRPCResultCache::RemoveOrphaned(const uint256& hashFork, std::function<bool(const uint64, const uint256&)> fnIsMainChain)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+    CCacheEntryForkIndex& idxFork = cntrEntry.get<2>();
+    auto itBegin = idxFork.lower_bound(boost::make_tuple(hashFork));
+    auto it = idxFork.upper_bound(boost::make_tuple(hashFork));
+    size_t nRemoved = 0;
+    // Anchors on the main chain form a prefix, so walk down from the highest one until an anchor is still valid
+    while (it != itBegin)
+    {
+        --it;
+        if (fnIsMainChain(it->nBlockNumber, it->hashBlock))
+        {
+            break;
+        }
+        nUsedBytes -= it->GetSize();
+        it = idxFork.erase(it);
+        nRemoved++;
+    }
+    return nRemoved;
+}
+
+void CRPCResultCache::Clear()
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+    cntrEntry.clear();
+    mapForkTip.clear();
+    nUsedBytes = 0;
+}
+
 ///////////////////////////////
 // CRPCMod
 
-CRPCMod::CRPCMod()
-  : IIOModule("rpcmod")
+CRPCMod::CRPCMod(const std::string& strOwnKeyIn, const bool fIsolatedIn)
+  : IIOModule(strOwnKeyIn), fIsolated(fIsolatedIn)
 {
     pHttpServer = nullptr;
     pCoreProtocol = nullptr;
@@ -381,6 +479,8 @@ CRPCMod::CRPCMod()
         ("gettimevault", &CRPCMod::RPCGetTimeVault)
         //
         ("getaddresscount", &CRPCMod::RPCGetAddressCount)
+        //
+        ("getaddresstxindexheight", &CRPCMod::RPCGetAddressTxIndexHeight)
         /* Wallet */
         ("listkey", &CRPCMod::RPCListKey)
         //
@@ -450,6 +550,8 @@ CRPCMod::CRPCMod()
         //
         ("getcontractcode", &CRPCMod::RPCGetContractCode)
         //
+        ("liststoragerange", &CRPCMod::RPCListStorageRange)
+        //
         ("addblacklistaddress", &CRPCMod::RPCAddBlacklistAddress)
         //
         ("removeblacklistaddress", &CRPCMod::RPCRemoveBlacklistAddress)
@@ -585,6 +687,10 @@ CRPCMod::CRPCMod()
         ;
     mapRPCFunc = temp_map;
     fWriteRPCLog = true;
+
+    // Handlers of these methods set CReqContext::hashAnchorBlock when their result is immutable
+    setCacheMethod = { "getblock", "gettransaction", "gettransactionreceipt",
+                       "eth_getBlockByHash", "eth_getTransactionReceipt", "eth_getLogs" };
 }
 
 CRPCMod::~CRPCMod()
@@ -627,10 +733,13 @@ bool CRPCMod::HandleInitialize()
         return false;
     }
     fWriteRPCLog = RPCServerConfig()->fRPCLogEnable;
+    cacheResult.Configure((size_t)RPCServerConfig()->nRPCCacheSize * 1024 * 1024, RPCServerConfig()->nRPCCacheDepth);
 
-    if (BasicConfig()->nModRpcThreads > 1)
+    // An isolated worker group serves the rpc ports of its own forks only, with its own threads, queue and result cache
+    const uint32 nThreads = (fIsolated ? RPCServerConfig()->nRPCIsolateThreads : BasicConfig()->nModRpcThreads);
+    if (nThreads > 1)
     {
-        AddEventThread(BasicConfig()->nModRpcThreads - 1);
+        AddEventThread(nThreads - 1);
     }
     return true;
 }
@@ -643,6 +752,7 @@ void CRPCMod::HandleDeinitialize()
     pDataStat = nullptr;
     pForkManager = nullptr;
     pBlockMaker = nullptr;
+    cacheResult.Clear();
 }
 
 bool CRPCMod::HandleEvent(CEventHttpReq& eventHttpReq)
@@ -698,16 +808,18 @@ bool CRPCMod::HandleEvent(CEventHttpReq& eventHttpReq)
         const std::set<std::string> setNoParserMethod = { "eth_getBlockByHash", "eth_getBlockByNumber", "eth_call", "eth_estimateGas", "eth_newFilter", "eth_getLogs" };
 
         bool fArray = false;
-        CRPCReqVec vecReq;
-        {
-            boost::unique_lock<boost::mutex> lock(mutexDec);
-            vecReq = DeserializeCRPCReq(eventHttpReq.data.strContent, setNoParserMethod, fArray);
-        }
+        CRPCReqVec vecReq = DeserializeCRPCReq(eventHttpReq.data.strContent, setNoParserMethod, fArray);
+        map<size_t, uint256> mapSentTxid;
+        size_t nSentRunEnd = 0;
+
         CRPCRespVec vecResp;
+        vector<string> vecCachedResult(vecReq.size());
+        bool fCacheChecked = false;
         for (auto& spReq : vecReq)
         {
             CRPCErrorPtr spError;
             CRPCResultPtr spResult;
+            string& strCachedResult = vecCachedResult[vecResp.size()];
             try
             {
                 map<string, RPCFunc>::iterator it = mapRPCFunc.find(spReq->strMethod);
@@ -722,8 +834,46 @@ bool CRPCMod::HandleEvent(CEventHttpReq& eventHttpReq)
                 // }
 
                 ctxReq.strMethod = spReq->strMethod;
+                ctxReq.hashAnchorBlock = 0;
 
-                spResult = (this->*(*it).second)(ctxReq, spReq->spParam);
+                string strCacheKey;
+                if (cacheResult.IsEnabled() && setCacheMethod.count(spReq->strMethod))
+                {
+                    if (!fCacheChecked)
+                    {
+                        CheckResultCacheReorg();
+                        fCacheChecked = true;
+                    }
+                    strCacheKey = GetResultCacheKey(ctxReq.hashFork, spReq);
+                    if (cacheResult.Retrieve(strCacheKey, strCachedResult))
+                    {
+                        vecResp.push_back(MakeCRPCRespPtr(spReq->valID, spResult));
+                        continue;
+                    }
+                }
+
+                // A run of consecutive raw txs is sent together, requests after it still see its result
+                if (fArray && vecResp.size() >= nSentRunEnd && spReq->strMethod == "eth_sendRawTransaction")
+                {
+                    nSentRunEnd = GetEthRawTxRunEnd(vecReq, vecResp.size());
+                    SendEthRawTxBatch(vecReq, vecResp.size(), nSentRunEnd, mapSentTxid);
+                }
+
+                auto mt = mapSentTxid.find(vecResp.size());
+                if (mt != mapSentTxid.end())
+                {
+                    spResult = MakeCeth_sendRawTransactionResultPtr(mt->second.GetHex());
+                }
+                else
+                {
+                    spResult = (this->*(*it).second)(ctxReq, spReq->spParam);
+                }
+
+                if (spResult && !strCacheKey.empty() && ctxReq.hashAnchorBlock != 0)
+                {
+                    strCachedResult = json_spirit::write_string<json_spirit::Value>(spResult->ToJSON(), false, RPC_DOUBLE_PRECISION);
+                    AddResultCache(strCacheKey, ctxReq.hashAnchorBlock, strCachedResult);
+                }
             }
             catch (CRPCException& e)
             {
@@ -749,13 +899,32 @@ bool CRPCMod::HandleEvent(CEventHttpReq& eventHttpReq)
             }
         }
 
+        // Responses with a cached result are spliced from the serialized result instead of writing it again
+        auto lmdSerializeResp = [&](const size_t i) -> string {
+            if (vecCachedResult[i].empty() || vecResp[i]->spError)
+            {
+                return vecResp[i]->Serialize();
+            }
+            return string("{\"id\":") + json_spirit::write_string<json_spirit::Value>(vecResp[i]->valID, false, RPC_DOUBLE_PRECISION)
+                   + ",\"jsonrpc\":" + json_spirit::write_string<json_spirit::Value>(vecResp[i]->strJSONRPC, false, RPC_DOUBLE_PRECISION)
+                   + ",\"result\":" + vecCachedResult[i] + "}";
+        };
         if (fArray)
         {
-            strResult = SerializeCRPCResp(vecResp);
+            strResult = "[";
+            for (size_t i = 0; i < vecResp.size(); i++)
+            {
+                if (i > 0)
+                {
+                    strResult += ",";
+                }
+                strResult += lmdSerializeResp(i);
+            }
+            strResult += "]";
         }
         else if (vecResp.size() > 0)
         {
-            strResult = vecResp[0]->Serialize();
+            strResult = lmdSerializeResp(0);
         }
         else
         {
@@ -996,15 +1165,29 @@ bool CRPCMod::VerifyClientOrder(const CReqContext& ctxReq)
     return true;
 }
 
-CLogsFilter CRPCMod::GetLogFilterFromJson(const uint256& hashFork, const std::string& strJsonValue)
+const json_spirit::Value& CRPCMod::GetCommonParamValue(const CRPCParamPtr& param, json_spirit::Value& valParamData)
 {
-    CLogsFilter logFilter;
-
-    json_spirit::Value valParam;
-    if (!json_spirit::read_string(strJsonValue, valParam, RPC_MAX_DEPTH))
+    // Methods in the no-parser set keep the decoded params, so they are not written and read again
+    auto spCommon = std::dynamic_pointer_cast<CRPCCommonParam>(param);
+    if (spCommon)
+    {
+        return spCommon->val;
+    }
+    if (!json_spirit::read_string(param->GetParamJson(), valParamData, RPC_MAX_DEPTH))
     {
         throw CRPCException(RPC_PARSE_ERROR, "Parse Error: request json string error.");
     }
+    return valParamData;
+}
+
+CLogsFilter CRPCMod::GetLogFilterFromJson(const uint256& hashFork, const json_spirit::Value& valParam, bool* pfFixedRange)
+{
+    CLogsFilter logFilter;
+    auto lmdIsFixedBlock = [](const json_spirit::Value& v) -> bool {
+        return (v.type() == json_spirit::str_type
+                && v.get_str() != "earliest" && v.get_str() != "latest" && v.get_str() != "pending");
+    };
+
     if (valParam.type() != json_spirit::array_type || valParam.get_array().size() == 0)
     {
         throw CRPCException(RPC_PARSE_ERROR, "Parse error: request must be an array and non empty.");
@@ -1034,6 +1217,10 @@ CLogsFilter CRPCMod::GetLogFilterFromJson(const uint256& hashFork, const std::st
     }
 
     json_spirit::Value to_block = find_value(item, "toBlock");
+    if (pfFixedRange)
+    {
+        *pfFixedRange = (lmdIsFixedBlock(from_block) && lmdIsFixedBlock(to_block));
+    }
     if (!to_block.is_null())
     {
         if (to_block.type() != json_spirit::str_type)
@@ -1138,6 +1325,139 @@ CLogsFilter CRPCMod::GetLogFilterFromJson(const uint256& hashFork, const std::st
     return logFilter;
 }
 
+string CRPCMod::GetResultCacheKey(const uint256& hashFork, const CRPCReqPtr& spReq)
+{
+    string strParam;
+    if (spReq->spParam)
+    {
+        strParam = spReq->spParam->GetParamJson();
+    }
+    return hashFork.GetHex() + ":" + spReq->strMethod + ":" + strParam;
+}
+
+bool CRPCMod::IsResultAnchorConfirmed(const uint256& hashBlock, CBlockStatus& statusAnchor, CBlockStatus& statusLast)
+{
+    if (!pService->GetBlockStatus(hashBlock, statusAnchor)
+        || !pService->GetLastBlockStatus(statusAnchor.hashFork, statusLast))
+    {
+        return false;
+    }
+    if (statusLast.nBlockNumber < statusAnchor.nBlockNumber + cacheResult.GetConfirmations())
+    {
+        return false;
+    }
+    uint256 hashMain;
+    return (pService->GetBlockNumberHash(statusAnchor.hashFork, statusAnchor.nBlockNumber, hashMain) && hashMain == hashBlock);
+}
+
+void CRPCMod::CheckResultCacheReorg()
+{
+    map<uint256, pair<uint64, uint256>> mapTip;
+    cacheResult.GetForkTip(mapTip);
+    for (const auto& kv : mapTip)
+    {
+        const uint256& hashFork = kv.first;
+        CBlockStatus statusLast;
+        if (!pService->GetLastBlockStatus(hashFork, statusLast) || statusLast.hashBlock == kv.second.second)
+        {
+            continue;
+        }
+        uint256 hashMain;
+        if (!pService->GetBlockNumberHash(hashFork, kv.second.first, hashMain) || hashMain != kv.second.second)
+        {
+            size_t nRemoved = cacheResult.RemoveOrphaned(hashFork, [&](const uint64 nNumber, const uint256& hashBlock) -> bool {
+                uint256 hash;
+                return (pService->GetBlockNumberHash(hashFork, nNumber, hash) && hash == hashBlock);
+            });
+            StdLog("CRPCMod", "Check result cache: fork reorganized, remove %lu results, fork: %s", nRemoved, hashFork.GetHex().c_str());
+        }
+        cacheResult.SetForkTip(hashFork, statusLast.nBlockNumber, statusLast.hashBlock);
+    }
+}
+
+void CRPCMod::AddResultCache(const string& strKey, const uint256& hashAnchorBlock, const string& strResult)
+{
+    CBlockStatus statusAnchor;
+    CBlockStatus statusLast;
+    if (IsResultAnchorConfirmed(hashAnchorBlock, statusAnchor, statusLast))
+    {
+        map<uint256, pair<uint64, uint256>> mapTip;
+        cacheResult.GetForkTip(mapTip);
+        if (!mapTip.count(statusAnchor.hashFork))
+        {
+            cacheResult.SetForkTip(statusAnchor.hashFork, statusLast.nBlockNumber, statusLast.hashBlock);
+        }
+        cacheResult.AddNew(strKey, statusAnchor.hashFork, statusAnchor.nBlockNumber, hashAnchorBlock, strResult);
+    }
+}
+
+bool CRPCMod::GetEthRawTxData(CRPCParamPtr param, bytes& txData)
+{
+    auto spParam = CastParamPtr<Ceth_sendRawTransactionParam>(param);
+    if (!spParam->vecParamlist.IsValid() || spParam->vecParamlist.size() == 0)
+    {
+        StdLog("CRPCMod", "RPC EthSendRawTransaction: Invalid paramlist");
+        return false;
+    }
+    string strTxData = spParam->vecParamlist.at(0);
+    if (strTxData.empty())
+    {
+        StdLog("CRPCMod", "RPC EthSendRawTransaction: Invalid txdata");
+        return false;
+    }
+
+    txData = ParseHexString(strTxData);
+    if (txData.empty())
+    {
+        StdLog("CRPCMod", "RPC EthSendRawTransaction: Invalid raw tx");
+        return false;
+    }
+    return true;
+}
+
+size_t CRPCMod::GetEthRawTxRunEnd(const CRPCReqVec& vecReq, const size_t nBegin)
+{
+    size_t nEnd = nBegin;
+    while (nEnd < vecReq.size() && vecReq[nEnd]->strMethod == "eth_sendRawTransaction")
+    {
+        nEnd++;
+    }
+    return nEnd;
+}
+
+void CRPCMod::SendEthRawTxBatch(const CRPCReqVec& vecReq, const size_t nBegin, const size_t nEnd, std::map<size_t, uint256>& mapSentTxid)
+{
+    // Raw txs of a run are decoded in parallel and admitted to the tx pool together,
+    // instead of taking the pool lock and broadcasting once per request
+    std::vector<size_t> vIndex;
+    std::vector<bytes> vRawTxData;
+    for (size_t i = nBegin; i < nEnd; i++)
+    {
+        bytes txData;
+        if (GetEthRawTxData(vecReq[i]->spParam, txData))
+        {
+            vIndex.push_back(i);
+            vRawTxData.push_back(std::move(txData));
+        }
+    }
+    if (vRawTxData.size() < 2)
+    {
+        return;
+    }
+
+    std::vector<uint256> vTxid;
+    std::vector<bool> vResult;
+    pService->SendEthRawTransaction(vRawTxData, vTxid, vResult);
+    for (size_t n = 0; n < vIndex.size(); n++)
+    {
+        // A failed tx is left to the single request call, which returns its error
+        if (vResult[n])
+        {
+            mapSentTxid[vIndex[n]] = vTxid[n];
+        }
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 /* System */
 CRPCResultPtr CRPCMod::RPCHelp(const CReqContext& ctxReq, CRPCParamPtr param)
@@ -1493,6 +1813,7 @@ CRPCResultPtr CRPCMod::RPCGetBlock(const CReqContext& ctxReq, CRPCParamPtr param
     {
         throw CRPCException(RPC_INVALID_PARAMETER, "Unknown block");
     }
+    ctxReq.hashAnchorBlock = hashBlock;
 
     return MakeCGetBlockResultPtr(BlockToJSON(hashBlock, block, nChainId, fork, height, block.GetBlockTotalReward()));
 }
@@ -1722,6 +2043,7 @@ CRPCResultPtr CRPCMod::RPCGetTransaction(const CReqContext& ctxReq, CRPCParamPtr
         CBufStream ss;
         ss << tx;
         spResult->strSerialization = ToHexString((const unsigned char*)ss.GetData(), ss.GetSize());
+        ctxReq.hashAnchorBlock = hashBlock;
         return spResult;
     }
 
@@ -2085,6 +2407,28 @@ CRPCResultPtr CRPCMod::RPCGetAddressCount(const CReqContext& ctxReq, CRPCParamPt
     return MakeCGetAddressCountResultPtr(hashRefBlock.ToString(), nAddressCount, nNewAddressCount);
 }
 
+CRPCResultPtr CRPCMod::RPCGetAddressTxIndexHeight(const CReqContext& ctxReq, CRPCParamPtr param)
+{
+    if (!BasicConfig()->fFullDb)
+    {
+        throw CRPCException(RPC_INVALID_REQUEST, "If you need this function, please set config 'fulldb=true' and restart");
+    }
+
+    auto spParam = CastParamPtr<CGetAddressTxIndexHeightParam>(param);
+
+    uint256 hashFork;
+    if (!GetForkHashOfDef(spParam->strFork, ctxReq.hashFork, hashFork))
+    {
+        throw CRPCException(RPC_INVALID_PARAMETER, "Invalid fork");
+    }
+    if (!pService->HaveFork(hashFork))
+    {
+        throw CRPCException(RPC_INVALID_PARAMETER, "Unknown fork");
+    }
+
+    return MakeCGetAddressTxIndexHeightResultPtr(pService->GetAddressTxIndexHeight(hashFork));
+}
+
 /* Wallet */
 CRPCResultPtr CRPCMod::RPCListKey(const CReqContext& ctxReq, CRPCParamPtr param)
 {
@@ -2725,7 +3069,7 @@ CRPCResultPtr CRPCMod::RPCListTransaction(const CReqContext& ctxReq, CRPCParamPt
     vector<CDestTxInfo> vTx;
     if (!pService->ListTransaction(hashFork, hashBlock, dest, spParam->nOffset, spParam->nCount, spParam->fReverse, vTx))
     {
-        throw CRPCException(RPC_WALLET_ERROR, "Failed list transactions");
+        throw CRPCException(RPC_WALLET_ERROR, string("Failed list transactions, indexed height: ") + to_string(pService->GetAddressTxIndexHeight(hashFork)));
     }
 
     auto spResult = MakeCListTransactionResultPtr();
@@ -3706,6 +4050,7 @@ CRPCResultPtr CRPCMod::RPCGetTransactionReceipt(const CReqContext& ctxReq, CRPCP
     {
         throw CRPCException(RPC_DATABASE_ERROR, "Get transaction receipt fail");
     }
+    ctxReq.hashAnchorBlock = receipt.hashBlock;
 
     auto spResult = MakeCGetTransactionReceiptResultPtr();
 
@@ -4150,6 +4495,55 @@ CRPCResultPtr CRPCMod::RPCGetContractCode(const CReqContext& ctxReq, CRPCParamPt
     return MakeCGetContractCodeResultPtr(ToHexString(btData));
 }
 
+CRPCResultPtr CRPCMod::RPCListStorageRange(const CReqContext& ctxReq, CRPCParamPtr param)
+{
+    auto spParam = CastParamPtr<CListStorageRangeParam>(param);
+
+    CDestination dest;
+    dest.ParseString(spParam->strAddress);
+    if (dest.IsNull())
+    {
+        throw CRPCException(RPC_INVALID_PARAMETER, "Invalid address");
+    }
+
+    uint256 keyBegin;
+    if (spParam->strStart.IsValid() && !spParam->strStart.empty())
+    {
+        if (keyBegin.SetHex(spParam->strStart) != spParam->strStart.size())
+        {
+            throw CRPCException(RPC_INVALID_PARAMETER, "Invalid start key");
+        }
+    }
+    uint64 nCount = spParam->nCount.IsValid() ? uint64(spParam->nCount) : 100;
+
+    uint256 hashFork;
+    if (!GetForkHashOfDef(spParam->strFork, ctxReq.hashFork, hashFork))
+    {
+        throw CRPCException(RPC_INVALID_PARAMETER, "Invalid fork");
+    }
+    if (!pService->HaveFork(hashFork))
+    {
+        throw CRPCException(RPC_INVALID_PARAMETER, "Unknown fork");
+    }
+
+    uint256 hashBlock = GetRefBlock(hashFork, spParam->strBlock);
+
+    std::vector<std::pair<uint256, bytes>> vContractKv;
+    uint256 keyNext;
+    if (!pService->ListContractKvValue(hashFork, hashBlock, dest, keyBegin, nCount, vContractKv, keyNext))
+    {
+        throw CRPCException(RPC_INVALID_ADDRESS_OR_KEY, "Address error");
+    }
+
+    auto spResult = MakeCListStorageRangeResultPtr();
+    for (const auto& kv : vContractKv)
+    {
+        spResult->vecStorage.push_back({ kv.first.GetHex(), ToHexString(kv.second) });
+    }
+    spResult->strNextkey = keyNext.GetHex();
+    return spResult;
+}
+
 CRPCResultPtr CRPCMod::RPCAddBlacklistAddress(const CReqContext& ctxReq, CRPCParamPtr param)
 {
     auto spParam = CastParamPtr<CAddBlacklistAddressParam>(param);
@@ -5493,25 +5887,9 @@ CRPCResultPtr CRPCMod::RPCEthSendTransaction(const CReqContext& ctxReq, CRPCPara
 
 CRPCResultPtr CRPCMod::RPCEthSendRawTransaction(const CReqContext& ctxReq, CRPCParamPtr param)
 {
-    auto spParam = CastParamPtr<Ceth_sendRawTransactionParam>(param);
-    if (!spParam->vecParamlist.IsValid() || spParam->vecParamlist.size() == 0)
-    {
-        StdLog("CRPCMod", "RPC EthSendRawTransaction: Invalid paramlist");
-        uint256 txid = 0;
-        return MakeCeth_sendRawTransactionResultPtr(txid.GetHex());
-    }
-    string strTxData = spParam->vecParamlist.at(0);
-    if (strTxData.empty())
-    {
-        StdLog("CRPCMod", "RPC EthSendRawTransaction: Invalid txdata");
-        uint256 txid = 0;
-        return MakeCeth_sendRawTransactionResultPtr(txid.GetHex());
-    }
-
-    bytes txData = ParseHexString(strTxData);
-    if (txData.empty())
+    bytes txData;
+    if (!GetEthRawTxData(param, txData))
     {
-        StdLog("CRPCMod", "RPC EthSendRawTransaction: Invalid raw tx");
         uint256 txid = 0;
         return MakeCeth_sendRawTransactionResultPtr(txid.GetHex());
     }
@@ -5536,11 +5914,8 @@ CRPCResultPtr CRPCMod::RPCEthCall(const CReqContext& ctxReq, CRPCParamPtr param)
     bytes btData;
     uint256 hashBlock;
 
-    json_spirit::Value valParam;
-    if (!json_spirit::read_string(param->GetParamJson(), valParam, RPC_MAX_DEPTH))
-    {
-        throw CRPCException(RPC_PARSE_ERROR, "Parse Error: request json string error.");
-    }
+    json_spirit::Value valParamData;
+    const json_spirit::Value& valParam = GetCommonParamValue(param, valParamData);
     if (valParam.type() != json_spirit::array_type)
     {
         throw CRPCException(RPC_PARSE_ERROR, "Parse error: request must be an array.");
@@ -5655,11 +6030,8 @@ CRPCResultPtr CRPCMod::RPCEthEstimateGas(const CReqContext& ctxReq, CRPCParamPtr
     bytes btData;
     uint256 hashBlock;
 
-    json_spirit::Value valParam;
-    if (!json_spirit::read_string(param->GetParamJson(), valParam, RPC_MAX_DEPTH))
-    {
-        throw CRPCException(RPC_PARSE_ERROR, "Parse Error: request json string error.");
-    }
+    json_spirit::Value valParamData;
+    const json_spirit::Value& valParam = GetCommonParamValue(param, valParamData);
     if (valParam.type() != json_spirit::array_type)
     {
         throw CRPCException(RPC_PARSE_ERROR, "Parse error: request must be an array.");
@@ -5830,11 +6202,8 @@ CRPCResultPtr CRPCMod::RPCEthGetBlockByHash(const CReqContext& ctxReq, CRPCParam
     uint256 hashBlock;
     bool fTxDetail = false;
 
-    json_spirit::Value valParam;
-    if (!json_spirit::read_string(param->GetParamJson(), valParam, RPC_MAX_DEPTH))
-    {
-        throw CRPCException(RPC_PARSE_ERROR, "Parse Error: request json string error.");
-    }
+    json_spirit::Value valParamData;
+    const json_spirit::Value& valParam = GetCommonParamValue(param, valParamData);
     if (valParam.type() != json_spirit::array_type)
     {
         throw CRPCException(RPC_PARSE_ERROR, "Parse error: request must be an array.");
@@ -5870,6 +6239,7 @@ CRPCResultPtr CRPCMod::RPCEthGetBlockByHash(const CReqContext& ctxReq, CRPCParam
         StdLog("CRPCMod", "RPC EthGetBlockByHash: Get block fail, block: %s", hashBlock.ToString().c_str());
         return nullptr;
     }
+    ctxReq.hashAnchorBlock = hashBlock;
 
     return MakeCeth_getBlockByHashResultPtr(EthBlockToJSON(block, fTxDetail));
 }
@@ -5879,11 +6249,8 @@ CRPCResultPtr CRPCMod::RPCEthGetBlockByNumber(const CReqContext& ctxReq, CRPCPar
     uint256 hashBlock;
     bool fTxDetail = false;
 
-    json_spirit::Value valParam;
-    if (!json_spirit::read_string(param->GetParamJson(), valParam, RPC_MAX_DEPTH))
-    {
-        throw CRPCException(RPC_PARSE_ERROR, "Parse Error: request json string error.");
-    }
+    json_spirit::Value valParamData;
+    const json_spirit::Value& valParam = GetCommonParamValue(param, valParamData);
     if (valParam.type() != json_spirit::array_type)
     {
         throw CRPCException(RPC_PARSE_ERROR, "Parse error: request must be an array.");
@@ -6031,6 +6398,7 @@ CRPCResultPtr CRPCMod::RPCEthGetTransactionReceipt(const CReqContext& ctxReq, CR
         StdLog("CRPCMod", "RPC EthGetTransactionReceipt: Get transaction receipt fail, txid: %s", txid.ToString().c_str());
         return nullptr;
     }
+    ctxReq.hashAnchorBlock = receipt.hashBlock;
 
     auto spResult = MakeCeth_getTransactionReceiptResultPtr();
 
@@ -6120,7 +6488,8 @@ CRPCResultPtr CRPCMod::RPCEthGetUncleByBlockNumberAndIndex(const CReqContext& ct
 
 CRPCResultPtr CRPCMod::RPCEthNewFilter(const CReqContext& ctxReq, CRPCParamPtr param)
 {
-    CLogsFilter logFilter = GetLogFilterFromJson(ctxReq.hashFork, param->GetParamJson());
+    json_spirit::Value valParamData;
+    CLogsFilter logFilter = GetLogFilterFromJson(ctxReq.hashFork, GetCommonParamValue(param, valParamData));
 
     // StdLog("CRPCMod", "RPC EthNewFilter: fromBlock: %s", logFilter.hashFromBlock.ToString().c_str());
     // StdLog("CRPCMod", "RPC EthNewFilter: toBlock: %s", logFilter.hashToBlock.ToString().c_str());
@@ -6357,7 +6726,9 @@ CRPCResultPtr CRPCMod::RPCEthGetFilterLogs(const CReqContext& ctxReq, CRPCParamP
 
 CRPCResultPtr CRPCMod::RPCEthGetLogs(const CReqContext& ctxReq, CRPCParamPtr param)
 {
-    CLogsFilter logsFilter = GetLogFilterFromJson(ctxReq.hashFork, param->GetParamJson());
+    bool fFixedRange = false;
+    json_spirit::Value valParamData;
+    CLogsFilter logsFilter = GetLogFilterFromJson(ctxReq.hashFork, GetCommonParamValue(param, valParamData), &fFixedRange);
 
     // StdLog("CRPCMod", "RPC EthGetLogs: fromBlock: %s", logsFilter.hashFromBlock.ToString().c_str());
     // StdLog("CRPCMod", "RPC EthGetLogs: toBlock: %s", logsFilter.hashToBlock.ToString().c_str());
@@ -6379,6 +6750,10 @@ CRPCResultPtr CRPCMod::RPCEthGetLogs(const CReqContext& ctxReq, CRPCParamPtr par
         StdLog("CRPCMod", "RPC EthGetLogs: Get logs fail");
         return MakeCeth_getLogsResultPtr();
     }
+    if (fFixedRange)
+    {
+        ctxReq.hashAnchorBlock = logsFilter.hashToBlock;
+    }
 
     auto spResult = MakeCeth_getLogsResultPtr();
     for (auto& v : vReceiptLogs)
@@ -7,6 +7,7 @@
 
 #include "json/json_spirit.h"
 #include <boost/function.hpp>
+#include <boost/multi_index/composite_key.hpp>
 
 #include "base.h"
 #include "mtbase.h"
@@ -30,17 +31,89 @@ public:
     uint16 nPeerPort;
 
     std::string strMethod;
+    // Set by a handler whose result never changes once this block is confirmed
+    mutable uint256 hashAnchorBlock;
+};
+
+class CRPCResultCache
+{
+    class CCacheEntry
+    {
+    public:
+        CCacheEntry(const std::string& strKeyIn, const uint256& hashForkIn, const uint64 nBlockNumberIn,
+                    const uint256& hashBlockIn, const std::string& strResultIn)
+          : strKey(strKeyIn), hashFork(hashForkIn), nBlockNumber(nBlockNumberIn), hashBlock(hashBlockIn), strResult(strResultIn) {}
+        std::size_t GetSize() const
+        {
+            return (strKey.size() + strResult.size() + ENTRY_OVERHEAD);
+        }
+
+    public:
+        enum
+        {
+            ENTRY_OVERHEAD = 160
+        };
+        std::string strKey;
+        uint256 hashFork;
+        uint64 nBlockNumber;
+        uint256 hashBlock;
+        std::string strResult;
+    };
+    typedef boost::multi_index_container<
+        CCacheEntry,
+        boost::multi_index::indexed_by<
+            boost::multi_index::ordered_unique<boost::multi_index::member<CCacheEntry, std::string, &CCacheEntry::strKey>>,
+            boost::multi_index::sequenced<>,
+            boost::multi_index::ordered_non_unique<
+                boost::multi_index::composite_key<
+                    CCacheEntry,
+                    boost::multi_index::member<CCacheEntry, uint256, &CCacheEntry::hashFork>,
+                    boost::multi_index::member<CCacheEntry, uint64, &CCacheEntry::nBlockNumber>>>>>
+        CCacheEntryContainer;
+    typedef CCacheEntryContainer::nth_index<1>::type CCacheEntryList;
+    typedef CCacheEntryContainer::nth_index<2>::type CCacheEntryForkIndex;
+
+public:
+    CRPCResultCache();
+    void Configure(const std::size_t nMaxBytesIn, const uint32 nConfirmationsIn);
+    bool IsEnabled() const
+    {
+        return (nMaxBytes > 0);
+    }
+    uint32 GetConfirmations() const
+    {
+        return nConfirmations;
+    }
+    bool Retrieve(const std::string& strKey, std::string& strResult);
+    void AddNew(const std::string& strKey, const uint256& hashFork, const uint64 nBlockNumber,
+                const uint256& hashBlock, const std::string& strResult);
+    void GetForkTip(std::map<uint256, std::pair<uint64, uint256>>& mapTip);
+    void SetForkTip(const uint256& hashFork, const uint64 nBlockNumber, const uint256& hashBlock);
+    // Drop the entries of a fork whose anchor block has left the main chain
+    std::size_t RemoveOrphaned(const uint256& hashFork, std::function<bool(const uint64, const uint256&)> fnIsMainChain);
+    void Clear();
+
+protected:
+    boost::mutex mtxCache;
+    std::size_t nMaxBytes;
+    std::size_t nUsedBytes;
+    uint32 nConfirmations;
+    CCacheEntryContainer cntrEntry;
+    std::map<uint256, std::pair<uint64, uint256>> mapForkTip;
 };
 
 class CRPCMod : public mtbase::IIOModule, virtual public mtbase::CHttpEventListener
 {
 public:
     typedef rpc::CRPCResultPtr (CRPCMod::*RPCFunc)(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
-    CRPCMod();
+    CRPCMod(const std::string& strOwnKeyIn = "rpcmod", const bool fIsolatedIn = false);
     ~CRPCMod();
     bool HandleEvent(mtbase::CEventHttpReq& eventHttpReq) override;
     bool HandleEvent(mtbase::CEventHttpBroken& eventHttpBroken) override;
 
+    // End of the run of eth_sendRawTransaction requests starting at nBegin, which is sent as one batch
+    static size_t GetEthRawTxRunEnd(const rpc::CRPCReqVec& vecReq, const size_t nBegin);
+
 protected:
     bool HandleInitialize() override;
     void HandleDeinitialize() override;
@@ -69,7 +142,14 @@ protected:
     std::string GetWidthString(uint64 nCount, int nWidth);
     uint256 GetRefBlock(const uint256& hashFork, const string& strRefBlock, const bool fDefZero = false);
     bool VerifyClientOrder(const CReqContext& ctxReq);
-    CLogsFilter GetLogFilterFromJson(const uint256& hashFork, const std::string& strJsonValue);
+    const json_spirit::Value& GetCommonParamValue(const rpc::CRPCParamPtr& param, json_spirit::Value& valParamData);
+    CLogsFilter GetLogFilterFromJson(const uint256& hashFork, const json_spirit::Value& valParam, bool* pfFixedRange = nullptr);
+    std::string GetResultCacheKey(const uint256& hashFork, const rpc::CRPCReqPtr& spReq);
+    bool IsResultAnchorConfirmed(const uint256& hashBlock, CBlockStatus& statusAnchor, CBlockStatus& statusLast);
+    void CheckResultCacheReorg();
+    void AddResultCache(const std::string& strKey, const uint256& hashAnchorBlock, const std::string& strResult);
+    bool GetEthRawTxData(rpc::CRPCParamPtr param, bytes& txData);
+    void SendEthRawTxBatch(const rpc::CRPCReqVec& vecReq, const size_t nBegin, const size_t nEnd, std::map<size_t, uint256>& mapSentTxid);
 
 private:
     /* System */
@@ -103,6 +183,7 @@ private:
     rpc::CRPCResultPtr RPCGetUserVotes(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCGetTimeVault(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCGetAddressCount(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
+    rpc::CRPCResultPtr RPCGetAddressTxIndexHeight(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     /* Wallet */
     rpc::CRPCResultPtr RPCListKey(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCGetNewKey(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
@@ -138,6 +219,7 @@ private:
     rpc::CRPCResultPtr RPCGetDestContract(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCGetContractSource(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCGetContractCode(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
+    rpc::CRPCResultPtr RPCListStorageRange(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCAddBlacklistAddress(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCRemoveBlacklistAddress(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
     rpc::CRPCResultPtr RPCListBlacklistAddress(const CReqContext& ctxReq, rpc::CRPCParamPtr param);
@@ -215,11 +297,13 @@ protected:
     IDataStat* pDataStat;
     IForkManager* pForkManager;
     IBlockMaker* pBlockMaker;
-    boost::mutex mutexDec;
 
 private:
     std::map<std::string, RPCFunc> mapRPCFunc;
+    const bool fIsolated;
     bool fWriteRPCLog;
+    std::set<std::string> setCacheMethod;
+    CRPCResultCache cacheResult;
 };
 
 } // namespace metabasenet
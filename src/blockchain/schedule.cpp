@@ -203,6 +203,11 @@ void CSchedule::RemoveInvState(const network::CInv& inv)
     }
     else if (inv.nType == network::CInv::MSG_BLOCK)
     {
+        uint64 nNonceSender = 0;
+        if (GetBlock(inv.nHash, nNonceSender) != nullptr)
+        {
+            vRemovedBlock.push_back(inv.nHash);
+        }
         RemoveHeightBlock(CBlock::GetBlockHeightByHash(inv.nHash), inv.nHash);
         RemoveRefBlock(inv.nHash);
     }
@@ -299,6 +304,12 @@ void CSchedule::GetNextBlock(const uint256& hash, vector<uint256>& vNext)
     orphanBlock.GetNext(hash, vNext);
 }
 
+void CSchedule::GetRemovedBlock(vector<uint256>& vRemovedBlockOut)
+{
+    vRemovedBlockOut.swap(vRemovedBlock);
+    vRemovedBlock.clear();
+}
+
 uint256 CSchedule::GetNextTx(const CDestination& destFrom, const uint64 nNextTxNonce)
 {
     auto it = mapRecvTxDest.find(destFrom);
@@ -260,6 +260,7 @@ public:
     void AddOrphanBlockPrev(const uint256& hash, const uint256& prev);
     void AddOrphanTxPrev(const uint256& txid, const uint256& prev);
     void GetNextBlock(const uint256& hash, std::vector<uint256>& vNext);
+    void GetRemovedBlock(std::vector<uint256>& vRemovedBlockOut);
     uint256 GetNextTx(const CDestination& destFrom, const uint64 nNextTxNonce);
     void InvalidateBlock(const uint256& hash, std::set<uint64>& setMisbehavePeer);
     void InvalidateTx(const uint256& txid, std::set<uint64>& setMisbehavePeer);
@@ -304,6 +305,7 @@ protected:
     std::map<uint256, std::map<uint256, uint256>> mapRefBlock;
     std::map<int, std::vector<std::pair<uint256, int>>> mapHeightBlock;
     std::map<int, CBlock> mapKcPowBlock;
+    std::vector<uint256> vRemovedBlock;
 };
 
 } // namespace metabasenet
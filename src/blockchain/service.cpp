@@ -6,6 +6,7 @@
 
 #include "devcommon/util.h"
 #include "event.h"
+#include "parallel.h"
 #include "libethcore/TransactionBase.h"
 #include "template/activatecode.h"
 #include "template/delegate.h"
@@ -540,6 +541,11 @@ bool CService::RetrieveContractKvValue(const uint256& hashFork, const uint256& h
     return pBlockChain->RetrieveContractKvValue(hashFork, hashBlock, dest, key, value);
 }
 
+bool CService::ListContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext)
+{
+    return pBlockChain->ListContractKvValue(hashFork, hashBlock, dest, keyBegin, nGetCount, vContractKv, keyNext);
+}
+
 uint256 CService::AddLogsFilter(const uint256& hashClient, const uint256& hashFork, const CLogsFilter& logsFilter)
 {
     return pBlockChain->AddLogsFilter(hashClient, hashFork, logsFilter);
@@ -764,6 +770,16 @@ bool CService::ListTransaction(const uint256& hashFork, const uint256& hashRefBl
     return pBlockChain->ListAddressTxInfo(hashFork, hashRefBlock, dest, nOffset, nCount, fReverse, vTx);
 }
 
+int CService::GetAddressTxIndexHeight(const uint256& hashFork)
+{
+    uint256 hashIndexBlock;
+    if (!pBlockChain->GetAddressTxIndexLast(hashFork, hashIndexBlock))
+    {
+        return -1;
+    }
+    return CBlock::GetBlockHeightByHash(hashIndexBlock);
+}
+
 boost::optional<std::string> CService::CreateTransaction(const uint256& hashFork, const CDestination& destFrom, const CDestination& destTo, const bytes& btToData,
                                                          const uint256& nAmount, const uint64 nNonce, const uint256& nGasPrice, const uint256& nGas, const bytes& btData,
                                                          const bytes& btFormatData, const bytes& btContractCode, const bytes& btContractParam, CTransaction& txNew)
@@ -1050,88 +1066,100 @@ boost::optional<std::string> CService::SignEthTransaction(const uint256& hashFor
 
 bool CService::SendEthRawTransaction(const bytes& btRawTxData, uint256& txid)
 {
-    try
+    uint256 hashFork;
+    CTransaction tx;
+    if (!DecodeEthRawTransaction(btRawTxData, hashFork, tx))
     {
-        TransactionBase txEth(btRawTxData, CheckTransaction::Everything);
+        return false;
+    }
+    txid = tx.GetHash();
 
-        // StdDebug("CService", "eth tx hash: 0x%s", txEth.sha3().hex().c_str());
-        // StdDebug("CService", "chainId: %lu", txEth.getChainId());
-        // StdDebug("CService", "nonce: %ld", (uint64)(txEth.nonce()));
-        // StdDebug("CService", "from: %s", address_to_hex(txEth.from()).c_str());
-        // StdDebug("CService", "to: %s", address_to_hex(txEth.to()).c_str());
-        // StdDebug("CService", "value: %s", u256_to_hex(txEth.value()).c_str());
-        // StdDebug("CService", "gas: %s", u256_to_hex(txEth.gas()).c_str());
-        // StdDebug("CService", "gasPrice: %s", u256_to_hex(txEth.gasPrice()).c_str());
-        // StdDebug("CService", "data: %s", ToHexString(txEth.data()).c_str());
-        // StdDebug("CService", "sig: %s", ToHexString(txEth.getSignature()).c_str());
+    CTransactionReceiptEx receiptex;
+    if (pBlockChain->GetTransactionReceipt(hashFork, txid, receiptex))
+    {
+        StdLog("CService", "Send eth raw tx: tx is existed, txid: %s", txid.GetHex().c_str());
+        return true;
+    }
 
-        // StdDebug("CService", "rlp: %s", ToHexString(txEth.rlp()).c_str());
+    if (SendTransaction(hashFork, tx) != OK)
+    {
+        StdError("CService", "Send eth raw tx: send tx fail");
+        return false;
+    }
 
-        // if (nNonce == 0)
-        // {
-        //     nNonce = pTxPool->GetDestNextTxNonce(pCoreProtocol->GetGenesisBlockHash(), destFrom);
-        //     if (nNonce == 0)
-        //     {
-        //         StdError("CService", "Send eth raw tx: Nonce error");
-        //         return false;
-        //     }
-        // }
+    StdLog("CService", "Send eth raw tx success, txid: %s", txid.GetHex().c_str());
+    return true;
+}
 
-        uint256 hashFork;
-        uint64 nChainId = txEth.getChainId();
-        if (/*nChainId == 0 || nChainId == 1 ||*/ nChainId == pCoreProtocol->GetGenesisChainId())
-        {
-            hashFork = pCoreProtocol->GetGenesisBlockHash();
-        }
-        else
-        {
-            if (!pBlockChain->GetForkHashByChainId((CChainId)nChainId, hashFork))
-            {
-                StdError("CService", "Send eth raw tx: Get fork hash error");
-                return false;
-            }
-        }
+void CService::SendEthRawTransaction(const std::vector<bytes>& vRawTxData, std::vector<uint256>& vTxid, std::vector<bool>& vResult)
+{
+    const size_t nCount = vRawTxData.size();
+    std::vector<uint256> vForkDecoded(nCount);
+    std::vector<CTransaction> vTxDecoded(nCount);
+    std::vector<uint8> vDecodeResult(nCount, 0);
 
-        bool fLinkToPubkeyAddress = false;
-        if (txEth.to() != ZeroAddress)
+    // RLP decoding and sender recovery dominate the cost of a raw tx, decode the batch in parallel
+    auto fnDecode = [&](const size_t i) {
+        vDecodeResult[i] = DecodeEthRawTransaction(vRawTxData[i], vForkDecoded[i], vTxDecoded[i]) ? 1 : 0;
+    };
+    if (nCount < PARALLEL_DECODE_MIN_COUNT)
+    {
+        for (size_t i = 0; i < nCount; i++)
         {
-            CDestination destTo(address_to_hex(txEth.to()));
-            CAddressContext ctxAddress;
-            if (!pBlockChain->RetrieveAddressContext(hashFork, uint256(), destTo, ctxAddress))
-            {
-                fLinkToPubkeyAddress = true;
-            }
+            fnDecode(i);
         }
+    }
+    else
+    {
+        ParallelComputer computer;
+        computer.Execute(
+            nCount, [](const size_t i) { return i; }, fnDecode);
+    }
 
-        CTransaction tx;
-        if (!tx.SetEthTx(btRawTxData, fLinkToPubkeyAddress))
+    vTxid.assign(nCount, uint256());
+    vResult.assign(nCount, false);
+
+    std::map<uint256, std::pair<std::vector<CTransaction>, std::vector<size_t>>> mapForkTx;
+    for (size_t i = 0; i < nCount; i++)
+    {
+        if (!vDecodeResult[i])
         {
-            StdError("CService", "Send eth raw tx: Nonce error");
-            return false;
+            continue;
         }
-        txid = tx.GetHash();
+        const uint256& hashFork = vForkDecoded[i];
+        vTxid[i] = vTxDecoded[i].GetHash();
 
         CTransactionReceiptEx receiptex;
-        if (pBlockChain->GetTransactionReceipt(hashFork, txid, receiptex))
+        if (pBlockChain->GetTransactionReceipt(hashFork, vTxid[i], receiptex))
         {
-            StdLog("CService", "Send eth raw tx: tx is existed, txid: %s", txid.GetHex().c_str());
-            return true;
+            StdLog("CService", "Send eth raw tx: tx is existed, txid: %s", vTxid[i].GetHex().c_str());
+            vResult[i] = true;
+            continue;
         }
+        auto& forkTx = mapForkTx[hashFork];
+        forkTx.first.push_back(std::move(vTxDecoded[i]));
+        forkTx.second.push_back(i);
+    }
+
+    for (const auto& kv : mapForkTx)
+    {
+        const std::vector<CTransaction>& vtx = kv.second.first;
+        const std::vector<size_t>& vIndex = kv.second.second;
 
-        if (SendTransaction(hashFork, tx) != OK)
+        std::vector<Errno> vErr;
+        pDispatcher->AddNewTx(kv.first, vtx, vErr);
+        for (size_t n = 0; n < vtx.size(); n++)
         {
-            StdError("CService", "Send eth raw tx: send tx fail");
-            return false;
+            const size_t i = vIndex[n];
+            if (vErr[n] != OK)
+            {
+                StdError("CService", "Send eth raw tx: send tx fail, txid: %s", vTxid[i].GetHex().c_str());
+                continue;
+            }
+            vResult[i] = true;
         }
-
-        StdLog("CService", "Send eth raw tx success, txid: %s", txid.GetHex().c_str());
-    }
-    catch (exception& e)
-    {
-        StdError("CService", "Send eth raw tx: Parse eth raw tx fail: %s", e.what());
-        return false;
+        StdLog("CService", "Send eth raw tx batch, count: %lu, fork: %s", vtx.size(), kv.first.GetHex().c_str());
     }
-    return true;
 }
 
 bool CService::SendEthTransaction(const uint256& hashFork, const CDestination& destFrom, const CDestination& destTo, const uint256& nAmount,
@@ -1588,6 +1616,44 @@ Errno CService::SubmitWork(const vector<unsigned char>& vchWorkData,
 }
 
 ////////////////////////////////////////////////////////////////////////
+bool CService::DecodeEthRawTransaction(const bytes& btRawTxData, uint256& hashFork, CTransaction& tx)
+{
+    if (!tx.SetEthTx(btRawTxData, false))
+    {
+        StdError("CService", "Decode eth raw tx: Parse eth raw tx fail");
+        return false;
+    }
+
+    uint64 nChainId = tx.GetChainId();
+    if (/*nChainId == 0 || nChainId == 1 ||*/ nChainId == pCoreProtocol->GetGenesisChainId())
+    {
+        hashFork = pCoreProtocol->GetGenesisBlockHash();
+    }
+    else
+    {
+        if (!pBlockChain->GetForkHashByChainId((CChainId)nChainId, hashFork))
+        {
+            StdError("CService", "Decode eth raw tx: Get fork hash error");
+            return false;
+        }
+    }
+
+    if (!tx.GetToAddress().IsNull())
+    {
+        CAddressContext ctxAddress;
+        if (!pBlockChain->RetrieveAddressContext(hashFork, uint256(), tx.GetToAddress(), ctxAddress))
+        {
+            // The to address is not on chain yet, link it as a pubkey address
+            if (!tx.SetEthTx(btRawTxData, true))
+            {
+                StdError("CService", "Decode eth raw tx: Parse eth raw tx fail");
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool CService::SetContractTransaction(const uint256& hashFork, const uint256& hashLastBlock, const bytes& btFormatData, const bytes& btContractCode, const bytes& btContractParam, CTransaction& txNew, std::string& strErr)
 {
     auto funcContractCreateContext = [&](const uint256& hashContractCreateCode) -> bool {
@@ -60,6 +60,7 @@ public:
                       const uint256& nGas, const bytes& btContractParam, uint256& nUsedGas, uint64& nGasLeft, int& nStatus, bytes& btResult) override;
     bool GetForkHashByChainId(const CChainId nChainIdIn, uint256& hashFork) override;
     bool RetrieveContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& key, bytes& value) override;
+    bool ListContractKvValue(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext) override;
     uint256 AddLogsFilter(const uint256& hashClient, const uint256& hashFork, const CLogsFilter& logsFilter) override;
     void RemoveFilter(const uint256& nFilterId) override;
     bool GetTxReceiptLogsByFilterId(const uint256& nFilterId, const bool fAll, ReceiptLogsVec& receiptLogs) override;
@@ -91,12 +92,14 @@ public:
     CTemplatePtr GetTemplate(const CDestination& dest) override;
     bool RemoveTemplate(const CDestination& dest) override;
     bool ListTransaction(const uint256& hashFork, const uint256& hashRefBlock, const CDestination& dest, const uint64 nOffset, const uint64 nCount, const bool fReverse, std::vector<CDestTxInfo>& vTx) override;
+    int GetAddressTxIndexHeight(const uint256& hashFork) override;
     boost::optional<std::string> CreateTransaction(const uint256& hashFork, const CDestination& destFrom, const CDestination& destTo, const bytes& btToData,
                                                    const uint256& nAmount, const uint64 nNonce, const uint256& nGasPriceIn, const uint256& nGasIn, const bytes& vchData,
                                                    const bytes& btFormatData, const bytes& btContractCode, const bytes& btContractParam, CTransaction& txNew) override;
     boost::optional<std::string> SignEthTransaction(const uint256& hashFork, const CDestination& destFrom, const CDestination& destTo, const uint256& nAmount,
                                                     const uint64 nNonce, const uint256& nGasPrice, const uint256& nGas, const bytes& btData, const uint64 nAddGas, uint256& txid, bytes& btSignTxData) override;
     bool SendEthRawTransaction(const bytes& btRawTxData, uint256& txid) override;
+    void SendEthRawTransaction(const std::vector<bytes>& vRawTxData, std::vector<uint256>& vTxid, std::vector<bool>& vResult) override;
     bool SendEthTransaction(const uint256& hashFork, const CDestination& destFrom, const CDestination& destTo, const uint256& nAmount,
                             const uint64 nNonce, const uint256& nGasPrice, const uint256& nGas, const bytes& btData, const uint64 nAddGas, uint256& txid) override;
     void GetWalletDestinations(std::set<CDestination>& setDest) override;
@@ -137,6 +140,7 @@ protected:
     bool HandleInvoke() override;
     void HandleHalt() override;
 
+    bool DecodeEthRawTransaction(const bytes& btRawTxData, uint256& hashFork, CTransaction& tx);
     bool SetContractTransaction(const uint256& hashFork, const uint256& hashLastBlock, const bytes& btFormatData, const bytes& btContractCode, const bytes& btContractParam, CTransaction& txNew, std::string& strErr);
     bool SetTemplateTransaction(const uint256& hashFork, const uint256& hashLastBlock, const uint8 nToTemplateType, const bytes& btFormatData, const bytes& vchData, const bytes& btToData, CTransaction& txNew, std::string& strErr);
 
@@ -146,6 +150,11 @@ protected:
     }
 
 protected:
+    enum
+    {
+        PARALLEL_DECODE_MIN_COUNT = 4
+    };
+
     ICoreProtocol* pCoreProtocol;
     IBlockChain* pBlockChain;
     ITxPool* pTxPool;
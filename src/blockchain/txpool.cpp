@@ -8,6 +8,8 @@
 #include <boost/range/adaptor/reversed.hpp>
 #include <deque>
 
+#include "parallel.h"
+
 using namespace std;
 using namespace mtbase;
 
@@ -17,15 +19,72 @@ namespace metabasenet
 //////////////////////////////
 // CAddressTxState
 
-void CAddressTxState::AddAddressTx(const uint256& txid, const CPooledTxPtr& ptx)
+void CAddressTxState::AddAddressTx(const uint256& txid, const CPooledTxPtr& ptx, const bool fFromTx)
 {
-    mapDestTx.insert(std::make_pair(txid, ptx));
+    if (mapDestTx.insert(std::make_pair(txid, ptx)).second && fFromTx && ptx->GetTxType() != CTransaction::TX_CERT)
+    {
+        mapFromTxNonce.insert(std::make_pair(ptx->GetNonce(), txid));
+    }
     RemoveMissTx(txid);
 }
 
 void CAddressTxState::RemoveAddressTx(const uint256& txid)
 {
-    mapDestTx.erase(txid);
+    auto it = mapDestTx.find(txid);
+    if (it == mapDestTx.end())
+    {
+        return;
+    }
+    if (it->second)
+    {
+        auto mt = mapFromTxNonce.find(it->second->GetNonce());
+        if (mt != mapFromTxNonce.end() && mt->second == txid)
+        {
+            mapFromTxNonce.erase(mt);
+        }
+    }
+    mapDestTx.erase(it);
+}
+
+void CAddressTxState::ListFromTx(std::vector<std::pair<uint256, CPooledTxPtr>>& vFromTx) const
+{
+    vFromTx.reserve(vFromTx.size() + mapFromTxNonce.size());
+    for (const auto& kv : mapFromTxNonce)
+    {
+        auto it = mapDestTx.find(kv.second);
+        if (it != mapDestTx.end() && it->second)
+        {
+            vFromTx.push_back(*it);
+        }
+    }
+}
+
+bool CAddressTxState::IsNextFromTx(const uint256& txid, const uint64 nTxNonce) const
+{
+    auto it = mapFromTxNonce.begin();
+    return (it != mapFromTxNonce.end() && it->first == nTxNonce && it->second == txid);
+}
+
+void CAddressTxState::ListResetTx(const std::vector<std::pair<uint256, CTransaction>>& vDisconnectTx, std::vector<std::pair<uint256, CTransaction>>& vResetTx) const
+{
+    std::map<uint64, std::pair<uint256, CTransaction>> mapResetTx;
+    for (const auto& kv : vDisconnectTx)
+    {
+        mapResetTx.insert(std::make_pair(kv.second.GetNonce(), kv));
+    }
+    for (const auto& kv : mapFromTxNonce)
+    {
+        auto it = mapDestTx.find(kv.second);
+        if (it != mapDestTx.end() && it->second)
+        {
+            mapResetTx.insert(std::make_pair(kv.first, std::make_pair(kv.second, *static_cast<CTransaction*>(it->second.get()))));
+        }
+    }
+    vResetTx.reserve(vResetTx.size() + mapResetTx.size());
+    for (const auto& kv : mapResetTx)
+    {
+        vResetTx.push_back(kv.second);
+    }
 }
 
 bool CAddressTxState::IsEmptyAddressTx() const
@@ -128,6 +187,8 @@ void CForkTxPool::ClearTxPool()
     setTxLinkIndex.clear();
     mapTx.clear();
     mapAddressTxState.clear();
+    setRelayTx.clear();
+    mapRelayTx.clear();
     StdLog("CForkTxPool", "Clear Tx Pool: Clear tx pool success, fork: %s", hashFork.ToString().c_str());
 }
 
@@ -155,11 +216,22 @@ bool CForkTxPool::AddPooledTx(const uint256& txid, const CTransaction& tx, const
 
     if (!tx.GetFromAddress().IsNull())
     {
-        mapAddressTxState[tx.GetFromAddress()].AddAddressTx(txid, ptx);
+        mapAddressTxState[tx.GetFromAddress()].AddAddressTx(txid, ptx, true);
     }
     if (!tx.GetToAddress().IsNull() && tx.GetFromAddress() != tx.GetToAddress())
     {
-        mapAddressTxState[tx.GetToAddress()].AddAddressTx(txid, ptx);
+        mapAddressTxState[tx.GetToAddress()].AddAddressTx(txid, ptx, false);
+    }
+
+    if (tx.GetTxType() == CTransaction::TX_CERT)
+    {
+        CPooledTxRelay relay(tx.GetGasPrice(), ptx->nSequenceNumber, tx.GetNonce(), txid);
+        setRelayTx.insert(relay);
+        mapRelayTx.insert(make_pair(txid, relay));
+    }
+    else if (!tx.GetFromAddress().IsNull())
+    {
+        UpdateRelayTx(tx.GetFromAddress(), tx.GetNonce());
     }
     return true;
 }
@@ -207,6 +279,12 @@ bool CForkTxPool::RemovePooledTx(const uint256& txid, const CTransaction& tx, co
         setTxLinkIndex.erase(txid);
         mapTx.erase(it);
 
+        RemoveRelayTx(txid);
+        if (tx.GetTxType() != CTransaction::TX_CERT && !tx.GetFromAddress().IsNull())
+        {
+            UpdateRelayTx(tx.GetFromAddress(), tx.GetNonce());
+        }
+
         if (mapTx.empty() && nTxSequenceNumber > 0xFFFFFFFFFFFFFFFL)
         {
             nTxSequenceNumber = INIT_TX_SEQUENCE_NUMBER;
@@ -227,19 +305,7 @@ bool CForkTxPool::RemovePooledTx(const uint256& txid, const CTransaction& tx, co
             auto mt = mapAddressTxState.find(tx.GetFromAddress());
             if (mt != mapAddressTxState.end())
             {
-                for (const auto& kv : mt->second.mapDestTx)
-                {
-                    if (kv.second == nullptr)
-                    {
-                        continue;
-                    }
-                    const uint256& txidn = kv.first;
-                    const CPooledTxPtr& ptx = kv.second;
-                    if (ptx->GetFromAddress() == tx.GetFromAddress() /*&& ptx->GetNonce() >= tx.GetNonce()*/)
-                    {
-                        vDelTx.push_back(make_pair(txidn, ptx));
-                    }
-                }
+                mt->second.ListFromTx(vDelTx);
             }
             for (auto& kv : vDelTx)
             {
@@ -259,7 +325,7 @@ bool CForkTxPool::RemovePooledTx(const uint256& txid, const CTransaction& tx, co
     return true;
 }
 
-Errno CForkTxPool::AddTx(const uint256& txid, const CTransaction& tx)
+Errno CForkTxPool::AddTx(const uint256& txid, const CTransaction& tx, const bool fSignVerified)
 {
     if (mapTx.find(txid) != mapTx.end())
     {
@@ -318,7 +384,7 @@ Errno CForkTxPool::AddTx(const uint256& txid, const CTransaction& tx)
     }
 
     Errno err;
-    if ((err = pCoreProtocol->VerifyTransaction(txid, tx, hashFork, hashLastBlock, CBlock::GetBlockHeightByHash(hashLastBlock) + 1, stateFrom, mapBlockAddress)) != OK)
+    if ((err = pCoreProtocol->VerifyTransaction(txid, tx, hashFork, hashLastBlock, CBlock::GetBlockHeightByHash(hashLastBlock) + 1, stateFrom, mapBlockAddress, fSignVerified)) != OK)
     {
         StdLog("CForkTxPool", "Add Tx: Verify transaction fail, from: %s, txid: %s", tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
         if (err == ERR_MISSING_PREV)
@@ -552,50 +618,114 @@ bool CForkTxPool::FetchArrangeBlockTx(const uint256& hashPrev, const int64 nBloc
 
 bool CForkTxPool::SynchronizeBlockChain(const CBlockChainUpdate& update)
 {
+    // Each sender keeps an executable prefix and a queued tail. A mined tx at the front of its
+    // sender's prefix is dropped alone. Any other mined tx, or a disconnected tx, resets the sender:
+    // its prefix is re-admitted in nonce order against the state of the new last block.
+    hashLastBlock = update.hashLastBlock;
+    nLastBlockTime = update.nLastBlockTime;
+
+    std::map<CDestination, vector<pair<uint256, CTransaction>>> mapResetAddress;
+    for (const CBlockEx& block : update.vBlockRemove)
+    {
+        for (const auto& tx : block.vtx)
+        {
+            if (tx.GetTxType() != CTransaction::TX_VOTE_REWARD && tx.GetTxType() != CTransaction::TX_CERT && !tx.GetFromAddress().IsNull())
+            {
+                mapResetAddress[tx.GetFromAddress()].push_back(make_pair(tx.GetHash(), tx));
+            }
+        }
+    }
+
     std::set<CDestination> setAddAddress;
     for (const CBlockEx& block : update.vBlockAddNew)
     {
         for (const auto& tx : block.vtx)
         {
-            if (tx.GetTxType() != CTransaction::TX_VOTE_REWARD)
+            if (tx.GetTxType() == CTransaction::TX_VOTE_REWARD || tx.GetFromAddress().IsNull())
+            {
+                continue;
+            }
+            const uint256 txid = tx.GetHash();
+            const CDestination& destFrom = tx.GetFromAddress();
+            if (mapTx.count(txid) > 0)
             {
-                const uint256 txid = tx.GetHash();
-                if (!RemovePooledTx(txid, tx, false))
+                auto it = mapAddressTxState.find(destFrom);
+                const bool fNextTx = (tx.GetTxType() == CTransaction::TX_CERT
+                                      || (it != mapAddressTxState.end() && it->second.IsNextFromTx(txid, tx.GetNonce())));
+                if (!RemovePooledTx(txid, tx, true))
                 {
                     StdLog("CForkTxPool", "Synchronize Block Chain: Remove pooled tx fail, new block: %s, txid: %s",
                            block.GetHash().GetHex().c_str(), txid.GetHex().c_str());
                     return false;
                 }
-                if (!tx.GetFromAddress().IsNull())
+                if (fNextTx && mapResetAddress.count(destFrom) == 0)
                 {
-                    setAddAddress.insert(tx.GetFromAddress());
+                    setAddAddress.insert(destFrom);
+                    continue;
                 }
             }
+            mapResetAddress[destFrom];
         }
     }
 
-    for (const CBlockEx& block : boost::adaptors::reverse(update.vBlockRemove))
+    for (const auto& kv : mapResetAddress)
     {
-        for (const auto& tx : block.vtx)
+        const CDestination& dest = kv.first;
+        vector<pair<uint256, CTransaction>> vResetTx;
+        auto it = mapAddressTxState.find(dest);
+        if (it != mapAddressTxState.end())
+        {
+            it->second.ListResetTx(kv.second, vResetTx);
+        }
+        else
+        {
+            CAddressTxState().ListResetTx(kv.second, vResetTx);
+        }
+
+        for (const auto& vd : vResetTx)
         {
-            if (tx.GetTxType() != CTransaction::TX_VOTE_REWARD && tx.GetTxType() != CTransaction::TX_CERT)
+            if (mapTx.count(vd.first) > 0 && !RemovePooledTx(vd.first, vd.second, true))
             {
-                if (!AddTx(tx.GetHash(), tx))
-                {
-                    StdLog("CForkTxPool", "Synchronize Block Chain: Add tx fail, remove block: %s, txid: %s",
-                           block.GetHash().GetHex().c_str(), tx.GetHash().GetHex().c_str());
-                }
+                StdLog("CForkTxPool", "Synchronize Block Chain: Remove reset tx fail, from: %s, txid: %s",
+                       dest.ToString().c_str(), vd.first.GetHex().c_str());
+                return false;
+            }
+        }
+
+        it = mapAddressTxState.find(dest);
+        if (it != mapAddressTxState.end())
+        {
+            CDestState stateDb;
+            if (!pBlockChain->RetrieveDestState(hashFork, hashLastBlock, dest, stateDb))
+            {
+                stateDb.SetNull();
+            }
+            it->second.SetAddressState(stateDb);
+        }
+
+        for (const auto& vd : vResetTx)
+        {
+            Errno err = AddTx(vd.first, vd.second);
+            if (err != OK)
+            {
+                StdDebug("CForkTxPool", "Synchronize Block Chain: Reset tx not added, err: %s, nonce: %lu, from: %s, txid: %s",
+                         ErrorString(err), vd.second.GetNonce(), dest.ToString().c_str(), vd.first.GetHex().c_str());
             }
         }
+        setAddAddress.insert(dest);
     }
 
     for (auto& dest : setAddAddress)
     {
         CDestState stateDb;
-        if (!pBlockChain->RetrieveDestState(hashFork, update.hashLastBlock, dest, stateDb))
+        if (!pBlockChain->RetrieveDestState(hashFork, hashLastBlock, dest, stateDb))
         {
+            if (mapResetAddress.count(dest) > 0)
+            {
+                continue;
+            }
             StdLog("CForkTxPool", "Synchronize Block Chain: Get address state fail, dest: %s, last block: %s",
-                   dest.ToString().c_str(), update.hashLastBlock.GetHex().c_str());
+                   dest.ToString().c_str(), hashLastBlock.GetHex().c_str());
             return false;
         }
         auto it = mapAddressTxState.find(dest);
@@ -625,9 +755,6 @@ bool CForkTxPool::SynchronizeBlockChain(const CBlockChainUpdate& update)
     {
         RemoveObsoletedCertTx();
     }
-
-    hashLastBlock = update.hashLastBlock;
-    nLastBlockTime = update.nLastBlockTime;
     return true;
 }
 
@@ -649,6 +776,15 @@ void CForkTxPool::ListTx(vector<uint256>& vTxPool)
     }
 }
 
+void CForkTxPool::ListRelayTx(vector<uint256>& vTxPool)
+{
+    vTxPool.reserve(vTxPool.size() + setRelayTx.size());
+    for (const CPooledTxRelay& relay : setRelayTx)
+    {
+        vTxPool.push_back(relay.txid);
+    }
+}
+
 bool CForkTxPool::ListTx(const CDestination& dest, vector<CTxInfo>& vTxPool, const int64 nGetOffset, const int64 nGetCount)
 {
     uint64 nTxSeq = 0;
@@ -835,10 +971,134 @@ void CForkTxPool::RemoveObsoletedCertTx()
     }
 }
 
+void CForkTxPool::UpdateRelayTx(const CDestination& destFrom, const uint64 nBeginNonce)
+{
+    // Walk the sender's prefix in nonce order from nBeginNonce. A tx never ranks above a lower
+    // nonce of its sender, and the txs after a nonce gap are not relayed. Stops at the first
+    // tx whose rank is unchanged, the rest of the prefix depends only on it.
+    auto it = mapAddressTxState.find(destFrom);
+    if (it == mapAddressTxState.end())
+    {
+        return;
+    }
+    const CAddressTxState& state = it->second;
+    auto mt = state.mapFromTxNonce.lower_bound(nBeginNonce);
+    if (mt == state.mapFromTxNonce.end())
+    {
+        return;
+    }
+
+    bool fRelay = true;
+    CPooledTxRelay relayPrev;
+    if (mt != state.mapFromTxNonce.begin())
+    {
+        auto pt = std::prev(mt);
+        auto rt = mapRelayTx.find(pt->second);
+        if (rt != mapRelayTx.end() && pt->first + 1 == mt->first)
+        {
+            relayPrev = rt->second;
+        }
+        else
+        {
+            fRelay = false;
+        }
+    }
+
+    for (; mt != state.mapFromTxNonce.end(); ++mt)
+    {
+        auto dt = state.mapDestTx.find(mt->second);
+        if (fRelay && (dt == state.mapDestTx.end() || !dt->second || (relayPrev.txid != 0 && relayPrev.nTxNonce + 1 != mt->first)))
+        {
+            fRelay = false;
+        }
+
+        auto rt = mapRelayTx.find(mt->second);
+        if (!fRelay)
+        {
+            if (rt == mapRelayTx.end())
+            {
+                break;
+            }
+            setRelayTx.erase(rt->second);
+            mapRelayTx.erase(rt);
+            continue;
+        }
+
+        const CPooledTx& tx = *dt->second;
+        CPooledTxRelay relay(tx.GetGasPrice(), tx.nSequenceNumber, mt->first, mt->second);
+        if (relayPrev.txid != 0)
+        {
+            relay.nGasPrice = std::min(relay.nGasPrice, relayPrev.nGasPrice);
+            relay.nSequenceNumber = std::max(relay.nSequenceNumber, relayPrev.nSequenceNumber);
+        }
+        if (rt != mapRelayTx.end())
+        {
+            if (rt->second == relay)
+            {
+                break;
+            }
+            setRelayTx.erase(rt->second);
+            rt->second = relay;
+        }
+        else
+        {
+            mapRelayTx.insert(make_pair(mt->second, relay));
+        }
+        setRelayTx.insert(relay);
+        relayPrev = relay;
+    }
+}
+
+void CForkTxPool::RemoveRelayTx(const uint256& txid)
+{
+    auto it = mapRelayTx.find(txid);
+    if (it != mapRelayTx.end())
+    {
+        setRelayTx.erase(it->second);
+        mapRelayTx.erase(it);
+    }
+}
+
+//////////////////////////////
+// CRejectedTxCache
+
+bool CRejectedTxCache::Get(const uint256& txid, Errno& err, const int64 nTime)
+{
+    CRejectedTx rejected;
+    if (!cacheRejectedTx.Retrieve(txid, rejected))
+    {
+        return false;
+    }
+    if (rejected.nExpiredTime < nTime)
+    {
+        cacheRejectedTx.Remove(txid);
+        return false;
+    }
+    err = rejected.err;
+    return true;
+}
+
+void CRejectedTxCache::Add(const uint256& txid, const Errno err, const int64 nTime)
+{
+    // Txs waiting for a previous nonce or already known are not rejections
+    if (err == OK || err == ERR_MISSING_PREV || err == ERR_ALREADY_HAVE)
+    {
+        return;
+    }
+    // Every error may clear with the chain state, even a signature error of a tx whose template address is not known yet
+    cacheRejectedTx.AddNew(txid, CRejectedTx(err, nTime + nExpiredSeconds));
+}
+
+void CRejectedTxCache::Clear()
+{
+    cacheRejectedTx.Clear();
+}
+
 //////////////////////////////
 // CTxPool
 
 CTxPool::CTxPool()
+  : cacheRejectedTx(MAX_REJECTED_TX_COUNT, REJECTED_TX_EXPIRED_TIME)
 {
     pCoreProtocol = nullptr;
     pBlockChain = nullptr;
@@ -916,6 +1176,7 @@ void CTxPool::HandleHalt()
     {
         Error("Failed to save txpool data");
     }
+    cacheRejectedTx.Clear();
     //Clear();
 }
 
@@ -986,6 +1247,51 @@ CForkTxPool* CTxPool::GetForkTxPool(const uint256& hashFork)
     return &(it->second);
 }
 
+void CTxPool::PreVerifyTx(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<uint256>& vTxid, std::vector<uint8>& vSignVerified, std::vector<Errno>& vKnownErr)
+{
+    // Hash and signature checks do not touch pool state, so they run before the write lock is taken
+    vTxid.resize(vtx.size());
+    vSignVerified.assign(vtx.size(), 0);
+    vKnownErr.assign(vtx.size(), OK);
+    for (size_t i = 0; i < vtx.size(); i++)
+    {
+        vTxid[i] = vtx[i].GetHash();
+    }
+
+    // Pooled and recently rejected txs are answered by the txid, without the signature check
+    {
+        boost::shared_lock<boost::shared_mutex> rlock(rwAccess);
+        auto it = mapForkPool.find(hashFork);
+        for (size_t i = 0; i < vtx.size(); i++)
+        {
+            if (!cacheRejectedTx.Get(vTxid[i], vKnownErr[i], GetTime()) && it != mapForkPool.end() && it->second.Exists(vTxid[i]))
+            {
+                vKnownErr[i] = ERR_ALREADY_HAVE;
+            }
+        }
+    }
+
+    auto fnVerify = [&](const size_t i) {
+        const CTransaction& tx = vtx[i];
+        if (vKnownErr[i] == OK)
+        {
+            vSignVerified[i] = (!tx.IsRewardTx() && tx.VerifyTxSignature(tx.GetFromAddress())) ? 1 : 0;
+        }
+    };
+    if (vtx.size() < PARALLEL_VERIFY_MIN_COUNT)
+    {
+        for (size_t i = 0; i < vtx.size(); i++)
+        {
+            fnVerify(i);
+        }
+        return;
+    }
+    ParallelComputer computer;
+    computer.Execute(
+        vtx.size(), [](const size_t i) { return i; }, fnVerify);
+}
+
+
 ///////////////////////////////////////////////////////////
 void CTxPool::ClearTxPool(const uint256& hashFork)
 {
@@ -1048,7 +1354,48 @@ Errno CTxPool::Push(const uint256& hashFork, const CTransaction& tx)
         return ERR_TRANSACTION_INVALID;
     }
 
-    return pFork->AddTx(txid, tx);
+    Errno err;
+    if (cacheRejectedTx.Get(txid, err, GetTime()))
+    {
+        StdDebug("CTxPool", "Push: Tx rejected recently, err: %s, txid: %s", ErrorString(err), txid.GetHex().c_str());
+        return err;
+    }
+    err = pFork->AddTx(txid, tx);
+    cacheRejectedTx.Add(txid, err, GetTime());
+    return err;
+}
+
+void CTxPool::Push(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<Errno>& vErr)
+{
+    std::vector<uint256> vTxid;
+    std::vector<uint8> vSignVerified;
+    std::vector<Errno> vKnownErr;
+    PreVerifyTx(hashFork, vtx, vTxid, vSignVerified, vKnownErr);
+
+    vErr.assign(vtx.size(), ERR_TRANSACTION_INVALID);
+
+    boost::unique_lock<boost::shared_mutex> wlock(rwAccess);
+    CForkTxPool* pFork = GetForkTxPool(hashFork);
+    if (pFork == nullptr)
+    {
+        StdError("CTxPool", "Push: Get fork tx pool failed, fork: %s", hashFork.GetHex().c_str());
+        return;
+    }
+    for (size_t i = 0; i < vtx.size(); i++)
+    {
+        if (vtx[i].IsRewardTx())
+        {
+            StdError("CTxPool", "Push: tx is mint, txid: %s", vTxid[i].GetHex().c_str());
+            continue;
+        }
+        if (vKnownErr[i] != OK)
+        {
+            vErr[i] = vKnownErr[i];
+            continue;
+        }
+        vErr[i] = pFork->AddTx(vTxid[i], vtx[i], vSignVerified[i] != 0);
+        cacheRejectedTx.Add(vTxid[i], vErr[i], GetTime());
+    }
 }
 
 bool CTxPool::Get(const uint256& hashFork, const uint256& txid, CTransaction& tx, uint256& hashAtFork) const
@@ -1100,6 +1447,16 @@ void CTxPool::ListTx(const uint256& hashFork, vector<uint256>& vTxPool)
     }
 }
 
+void CTxPool::ListRelayTx(const uint256& hashFork, vector<uint256>& vTxPool)
+{
+    boost::shared_lock<boost::shared_mutex> rlock(rwAccess);
+    auto it = mapForkPool.find(hashFork);
+    if (it != mapForkPool.end())
+    {
+        it->second.ListRelayTx(vTxPool);
+    }
+}
+
 bool CTxPool::ListTx(const uint256& hashFork, const CDestination& dest, vector<CTxInfo>& vTxPool, const int64 nGetOffset, const int64 nGetCount)
 {
     boost::shared_lock<boost::shared_mutex> rlock(rwAccess);
@@ -1137,6 +1494,11 @@ bool CTxPool::SynchronizeBlockChain(const CBlockChainUpdate& update)
 bool CTxPool::PushCertTx(const uint64 nRecvNetNonce, const std::vector<CTransaction>& vtx)
 {
     const uint256 hashFork = pCoreProtocol->GetGenesisBlockHash();
+    std::vector<uint256> vTxid;
+    std::vector<uint8> vSignVerified;
+    std::vector<Errno> vKnownErr;
+    PreVerifyTx(hashFork, vtx, vTxid, vSignVerified, vKnownErr);
+
     std::vector<CTransaction> vBroadTx;
     {
         boost::unique_lock<boost::shared_mutex> wlock(rwAccess);
@@ -1145,9 +1507,15 @@ bool CTxPool::PushCertTx(const uint64 nRecvNetNonce, const std::vector<CTransact
         {
             return false;
         }
-        for (auto& tx : vtx)
+        for (size_t i = 0; i < vtx.size(); i++)
         {
-            Errno err = pFork->AddTx(tx.GetHash(), tx);
+            const CTransaction& tx = vtx[i];
+            if (vKnownErr[i] != OK)
+            {
+                continue;
+            }
+            Errno err = pFork->AddTx(vTxid[i], tx, vSignVerified[i] != 0);
+            cacheRejectedTx.Add(vTxid[i], err, GetTime());
             if (err == OK)
             {
                 vBroadTx.push_back(tx);
@@ -1165,6 +1533,11 @@ bool CTxPool::PushCertTx(const uint64 nRecvNetNonce, const std::vector<CTransact
 
 bool CTxPool::PushUserTx(const uint64 nRecvNetNonce, const uint256& hashFork, const std::vector<CTransaction>& vtx)
 {
+    std::vector<uint256> vTxid;
+    std::vector<uint8> vSignVerified;
+    std::vector<Errno> vKnownErr;
+    PreVerifyTx(hashFork, vtx, vTxid, vSignVerified, vKnownErr);
+
     std::vector<CTransaction> vBroadTx;
     {
         boost::unique_lock<boost::shared_mutex> wlock(rwAccess);
@@ -1173,9 +1546,15 @@ bool CTxPool::PushUserTx(const uint64 nRecvNetNonce, const uint256& hashFork, co
         {
             return false;
         }
-        for (auto& tx : vtx)
+        for (size_t i = 0; i < vtx.size(); i++)
         {
-            Errno err = pFork->AddTx(tx.GetHash(), tx);
+            const CTransaction& tx = vtx[i];
+            if (vKnownErr[i] != OK)
+            {
+                continue;
+            }
+            Errno err = pFork->AddTx(vTxid[i], tx, vSignVerified[i] != 0);
+            cacheRejectedTx.Add(vTxid[i], err, GetTime());
             if (err == OK /*|| err == ERR_MISSING_PREV*/)
             {
                 vBroadTx.push_back(tx);
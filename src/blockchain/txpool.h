@@ -39,8 +39,11 @@ class CAddressTxState
 public:
     CAddressTxState() {}
 
-    void AddAddressTx(const uint256& txid, const CPooledTxPtr& ptx);
+    void AddAddressTx(const uint256& txid, const CPooledTxPtr& ptx, const bool fFromTx);
     void RemoveAddressTx(const uint256& txid);
+    void ListFromTx(std::vector<std::pair<uint256, CPooledTxPtr>>& vFromTx) const;
+    bool IsNextFromTx(const uint256& txid, const uint64 nTxNonce) const;
+    void ListResetTx(const std::vector<std::pair<uint256, CTransaction>>& vDisconnectTx, std::vector<std::pair<uint256, CTransaction>>& vResetTx) const;
     bool IsEmptyAddressTx() const;
     CDestState& GetAddressState();
     void SetAddressState(const CDestState& state);
@@ -50,9 +53,10 @@ public:
 
 public:
     std::map<uint256, CPooledTxPtr> mapDestTx;
+    std::map<uint64, uint256> mapFromTxNonce; // executable prefix: pooled txs sent by this address, nonce-contiguous after the chain nonce
     CDestState stateAddress;
     CAddressContext ctxAddress;
-    std::map<uint256, CTransaction> mapMissTx;
+    std::map<uint256, CTransaction> mapMissTx; // queued tail: txs waiting for a missing nonce
     std::map<uint64, uint256> mapMissNonce;
 };
 
@@ -90,6 +94,43 @@ typedef CPooledTxLinkSet::nth_index<0>::type CPooledTxLinkSetByTxHash;
 typedef CPooledTxLinkSet::nth_index<1>::type CPooledTxLinkSetBySequenceNumber;
 typedef CPooledTxLinkSet::nth_index<2>::type CPooledTxLinkSetByTxType;
 
+class CPooledTxRelay
+{
+public:
+    CPooledTxRelay()
+      : nSequenceNumber(0), nTxNonce(0) {}
+    CPooledTxRelay(const uint256& nGasPriceIn, const uint64 nSequenceNumberIn, const uint64 nTxNonceIn, const uint256& txidIn)
+      : nGasPrice(nGasPriceIn), nSequenceNumber(nSequenceNumberIn), nTxNonce(nTxNonceIn), txid(txidIn) {}
+
+    // Highest gas price first, then entry sequence, then nonce
+    bool operator<(const CPooledTxRelay& r) const
+    {
+        if (nGasPrice != r.nGasPrice)
+        {
+            return (nGasPrice > r.nGasPrice);
+        }
+        if (nSequenceNumber != r.nSequenceNumber)
+        {
+            return (nSequenceNumber < r.nSequenceNumber);
+        }
+        if (nTxNonce != r.nTxNonce)
+        {
+            return (nTxNonce < r.nTxNonce);
+        }
+        return (txid < r.txid);
+    }
+    bool operator==(const CPooledTxRelay& r) const
+    {
+        return (nGasPrice == r.nGasPrice && nSequenceNumber == r.nSequenceNumber && nTxNonce == r.nTxNonce && txid == r.txid);
+    }
+
+public:
+    uint256 nGasPrice;       // capped by the sender's lower nonces
+    uint64 nSequenceNumber; // raised to the sender's lower nonces
+    uint64 nTxNonce;
+    uint256 txid;
+};
+
 class CForkTxPool
 {
 public:
@@ -104,7 +145,7 @@ public:
     bool AddPooledTx(const uint256& txid, const CTransaction& tx, const int64 nTxSeq);
     bool RemovePooledTx(const uint256& txid, const CTransaction& tx, const bool fInvalidTx);
 
-    Errno AddTx(const uint256& txid, const CTransaction& tx);
+    Errno AddTx(const uint256& txid, const CTransaction& tx, const bool fSignVerified = false);
 
     bool Exists(const uint256& txid);
     bool CheckTxNonce(const CDestination& destFrom, const uint64 nTxNonce);
@@ -119,6 +160,7 @@ public:
 
     void ListTx(std::vector<std::pair<uint256, std::size_t>>& vTxPool);
     void ListTx(std::vector<uint256>& vTxPool);
+    void ListRelayTx(std::vector<uint256>& vTxPool);
     bool ListTx(const CDestination& dest, std::vector<CTxInfo>& vTxPool, const int64 nGetOffset, const int64 nGetCount);
     void GetDestBalance(const CDestination& dest, uint8& nDestType, uint8& nTemplateType, uint64& nTxNonce, uint256& nAvail,
                         uint256& nUnconfirmedIn, uint256& nUnconfirmedOut, CAddressContext& ctxAddress, const uint256& hashBlock = uint256());
@@ -129,6 +171,8 @@ protected:
     int64 GetMinTxSequenceNumber();
     bool VerifyRepeatCertTx(const CTransaction& tx);
     void RemoveObsoletedCertTx();
+    void UpdateRelayTx(const CDestination& destFrom, const uint64 nBeginNonce);
+    void RemoveRelayTx(const uint256& txid);
 
 protected:
     ICoreProtocol* pCoreProtocol;
@@ -139,11 +183,40 @@ protected:
     CPooledTxLinkSet setTxLinkIndex;
     std::map<uint256, CPooledTxPtr> mapTx;
     std::map<CDestination, CAddressTxState> mapAddressTxState;
+    std::set<CPooledTxRelay> setRelayTx;
+    std::map<uint256, CPooledTxRelay> mapRelayTx;
 
     uint256 hashLastBlock;
     int64 nLastBlockTime;
 };
 
+class CRejectedTxCache
+{
+public:
+    CRejectedTxCache(const std::size_t nMaxCount, const int64 nExpiredSecondsIn)
+      : nExpiredSeconds(nExpiredSecondsIn), cacheRejectedTx(nMaxCount) {}
+    bool Get(const uint256& txid, Errno& err, const int64 nTime);
+    void Add(const uint256& txid, const Errno err, const int64 nTime);
+    void Clear();
+
+protected:
+    class CRejectedTx
+    {
+    public:
+        CRejectedTx()
+          : err(OK), nExpiredTime(0) {}
+        CRejectedTx(const Errno errIn, const int64 nExpiredTimeIn)
+          : err(errIn), nExpiredTime(nExpiredTimeIn) {}
+
+    public:
+        Errno err;
+        int64 nExpiredTime;
+    };
+
+    const int64 nExpiredSeconds;
+    mtbase::CCache<uint256, CRejectedTx> cacheRejectedTx;
+};
+
 class CTxPool : public ITxPool
 {
 public:
@@ -154,9 +227,11 @@ public:
     bool CheckTxNonce(const uint256& hashFork, const CDestination& destFrom, const uint64 nTxNonce) override;
     std::size_t Count(const uint256& hashFork) const override;
     Errno Push(const uint256& hashFork, const CTransaction& tx) override;
+    void Push(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<Errno>& vErr) override;
     bool Get(const uint256& hashFork, const uint256& txid, CTransaction& tx, uint256& hashAtFork) const override;
     void ListTx(const uint256& hashFork, std::vector<std::pair<uint256, std::size_t>>& vTxPool) override;
     void ListTx(const uint256& hashFork, std::vector<uint256>& vTxPool) override;
+    void ListRelayTx(const uint256& hashFork, std::vector<uint256>& vTxPool) override;
     bool ListTx(const uint256& hashFork, const CDestination& dest, std::vector<CTxInfo>& vTxPool, const int64 nGetOffset = 0, const int64 nGetCount = 0) override;
     bool FetchArrangeBlockTx(const uint256& hashFork, const uint256& hashPrev, const int64 nBlockTime,
                              const std::size_t nMaxSize, std::vector<CTransaction>& vtx, uint256& nTotalTxFee) override;
@@ -177,8 +252,16 @@ protected:
     bool LoadData();
     bool SaveData();
     CForkTxPool* GetForkTxPool(const uint256& hashFork);
+    void PreVerifyTx(const uint256& hashFork, const std::vector<CTransaction>& vtx, std::vector<uint256>& vTxid, std::vector<uint8>& vSignVerified, std::vector<Errno>& vKnownErr);
 
 protected:
+    enum
+    {
+        PARALLEL_VERIFY_MIN_COUNT = 16,
+        MAX_REJECTED_TX_COUNT = 0x10000,
+        REJECTED_TX_EXPIRED_TIME = 15
+    };
+
     ICoreProtocol* pCoreProtocol;
     IBlockChain* pBlockChain;
     IDataStat* pDataStat;
@@ -189,6 +272,8 @@ protected:
 
     mutable boost::shared_mutex rwAccess;
     std::map<uint256, CForkTxPool> mapForkPool;
+
+    CRejectedTxCache cacheRejectedTx;
 };
 
 } // namespace metabasenet
@@ -6,6 +6,7 @@
 
 #include "crypto.h"
 #include "mtbase.h"
+#include "parallel.h"
 
 using namespace std;
 using namespace mtbase;
@@ -16,6 +17,66 @@ using namespace metabasenet::crypto;
 namespace metabasenet
 {
 
+//////////////////////////////
+// CMerkleTree
+
+static void HashMerkleLevel(std::vector<uint256>& vMerkleTree, const size_t nLevelBegin, const size_t nPrevBegin, const size_t nPrevSize,
+                            const size_t nBegin, const size_t nEnd)
+{
+    for (size_t n = nBegin; n < nEnd; n++)
+    {
+        size_t i = n * 2;
+        size_t i2 = std::min(i + 1, nPrevSize - 1);
+        vMerkleTree[nLevelBegin + n] = crypto::CryptoHash(vMerkleTree[nPrevBegin + i], vMerkleTree[nPrevBegin + i2]);
+    }
+}
+
+uint256 CMerkleTree::BuildMerkleTree(std::vector<uint256>& vMerkleTree, const std::size_t nLeafCount)
+{
+    size_t j = 0;
+    for (size_t nSize = nLeafCount; nSize > 1; nSize = (nSize + 1) / 2)
+    {
+        const size_t nLevelBegin = vMerkleTree.size();
+        const size_t nLevelCount = (nSize + 1) / 2;
+        vMerkleTree.resize(nLevelBegin + nLevelCount);
+
+        // Only the first level over the leaves is worth the threads, the levels above halve each time
+        bool fDone = false;
+        if (j == 0 && nLevelCount >= PARALLEL_HASH_MIN_COUNT)
+        {
+            ParallelComputer computer;
+            fDone = computer.Execute(
+                nLevelCount, [](const size_t n) { return n; },
+                [&](const size_t n) { HashMerkleLevel(vMerkleTree, nLevelBegin, j, nSize, n, n + 1); });
+        }
+        if (!fDone)
+        {
+            HashMerkleLevel(vMerkleTree, nLevelBegin, j, nSize, 0, nLevelCount);
+        }
+        j += nSize;
+    }
+    return (vMerkleTree.empty() ? uint64(0) : vMerkleTree.back());
+}
+
+void CMerkleTree::CalcDataHashList(const std::vector<bytes>& vData, std::vector<uint256>& vHash)
+{
+    vHash.resize(vData.size());
+    if (vData.size() >= PARALLEL_HASH_MIN_COUNT)
+    {
+        ParallelComputer computer;
+        if (computer.Execute(
+                vData.size(), [](const size_t i) { return i; },
+                [&](const size_t i) { vHash[i] = crypto::CryptoHash(vData[i].data(), vData[i].size()); }))
+        {
+            return;
+        }
+    }
+    for (size_t i = 0; i < vData.size(); i++)
+    {
+        vHash[i] = crypto::CryptoHash(vData[i].data(), vData[i].size());
+    }
+}
+
 //////////////////////////////
 // CBlock
 
@@ -209,9 +270,36 @@ void CBlock::SetBlockTime(const uint64 nTime)
     nTimeStamp = nTime;
 }
 
+void CBlock::GetTxHashList(std::vector<uint256>& vTxHash) const
+{
+    vTxHash.resize(vtx.size());
+    if (vtx.size() >= CMerkleTree::PARALLEL_HASH_MIN_COUNT)
+    {
+        ParallelComputer computer;
+        if (computer.Execute(
+                vtx.size(), [](const size_t i) { return i; },
+                [&](const size_t i) { vTxHash[i] = vtx[i].GetHash(); }))
+        {
+            return;
+        }
+    }
+    for (size_t i = 0; i < vtx.size(); i++)
+    {
+        vTxHash[i] = vtx[i].GetHash();
+    }
+}
+
 uint256 CBlock::CalcMerkleTreeRoot() const
+{
+    std::vector<uint256> vTxHash;
+    GetTxHashList(vTxHash);
+    return CalcMerkleTreeRoot(vTxHash);
+}
+
+uint256 CBlock::CalcMerkleTreeRoot(const std::vector<uint256>& vTxHash) const
 {
     std::vector<uint256> vMerkleTree;
+    vMerkleTree.reserve(vTxHash.size() * 2 + 2);
     uint256 hashBloom;
     if (!btBloomData.empty())
     {
@@ -219,21 +307,9 @@ uint256 CBlock::CalcMerkleTreeRoot() const
     }
     vMerkleTree.push_back(hashBloom);
     vMerkleTree.push_back(txMint.GetHash());
-    for (const CTransaction& tx : vtx)
-    {
-        vMerkleTree.push_back(tx.GetHash());
-    }
-    size_t j = 0;
-    for (size_t nSize = vtx.size(); nSize > 1; nSize = (nSize + 1) / 2)
-    {
-        for (size_t i = 0; i < nSize; i += 2)
-        {
-            size_t i2 = std::min(i + 1, nSize - 1);
-            vMerkleTree.push_back(crypto::CryptoHash(vMerkleTree[j + i], vMerkleTree[j + i2]));
-        }
-        j += nSize;
-    }
-    return (vMerkleTree.empty() ? uint64(0) : vMerkleTree.back());
+    vMerkleTree.insert(vMerkleTree.end(), vTxHash.begin(), vTxHash.end());
+    // The leaf count is the tx count, not the node count, keep it for root compatibility
+    return CMerkleTree::BuildMerkleTree(vMerkleTree, vTxHash.size());
 }
 
 void CBlock::SetSignData(const bytes& btSigData)
@@ -91,7 +91,9 @@ public:
     uint256 GetBlockTotalReward() const;
     uint256 GetBlockMoneyDestroy() const;
     void SetBlockTime(const uint64 nTime);
+    void GetTxHashList(std::vector<uint256>& vTxHash) const;
     uint256 CalcMerkleTreeRoot() const;
+    uint256 CalcMerkleTreeRoot(const std::vector<uint256>& vTxHash) const;
     void SetSignData(const bytes& btSigData);
     bool VerifyBlockSignature(const CDestination& destBlockSign) const;
     bool VerifyBlockProof() const;
@@ -755,6 +757,21 @@ protected:
     }
 };
 
+class CMerkleTree
+{
+public:
+    enum
+    {
+        PARALLEL_HASH_MIN_COUNT = 1024
+    };
+
+    // Build levels over the first nLeafCount nodes, appending inner nodes to vMerkleTree.
+    // Leaf sets and the first level of at least PARALLEL_HASH_MIN_COUNT nodes are hashed in parallel,
+    // a failed parallel run falls back to hashing in sequence.
+    static uint256 BuildMerkleTree(std::vector<uint256>& vMerkleTree, const std::size_t nLeafCount);
+    static void CalcDataHashList(const std::vector<bytes>& vData, std::vector<uint256>& vHash);
+};
+
 class CReceiptMerkleTree
 {
 public:
@@ -762,17 +779,7 @@ public:
     {
         std::vector<uint256> vMerkleTree;
         vMerkleTree = vReceipt;
-        size_t j = 0;
-        for (size_t nSize = vReceipt.size(); nSize > 1; nSize = (nSize + 1) / 2)
-        {
-            for (size_t i = 0; i < nSize; i += 2)
-            {
-                size_t i2 = std::min(i + 1, nSize - 1);
-                vMerkleTree.push_back(crypto::CryptoHash(vMerkleTree[j + i], vMerkleTree[j + i2]));
-            }
-            j += nSize;
-        }
-        return (vMerkleTree.empty() ? uint64(0) : vMerkleTree.back());
+        return CMerkleTree::BuildMerkleTree(vMerkleTree, vReceipt.size());
     }
 };
 
@@ -796,6 +803,7 @@ public:
         nLastMintType = pIndex->nMintType;
         nMoneySupply = pIndex->GetMoneySupply();
         nMoneyDestroy = pIndex->GetMoneyDestroy();
+        fForkDelta = false;
     }
     void SetNull()
     {
@@ -804,6 +812,7 @@ public:
         nLastBlockHeight = -1;
         nLastBlockNumber = 0;
         nLastMintType = 0;
+        fForkDelta = false;
     }
     bool IsNull() const
     {
@@ -825,6 +834,9 @@ public:
     std::set<uint256> setTxUpdate;
     std::vector<CBlockEx> vBlockAddNew;
     std::vector<CBlockEx> vBlockRemove;
+    bool fForkDelta;                   // vForkCreated and vForkRemoved cover every primary block added and removed
+    std::vector<uint256> vForkCreated; // forks created by the blocks of vBlockAddNew
+    std::vector<uint256> vForkRemoved; // forks created by the blocks of vBlockRemove
 };
 
 } // namespace metabasenet
@@ -4,6 +4,8 @@
 
 #include "transaction.h"
 
+#include <algorithm>
+
 #include "bloomfilter/bloomfilter.h"
 #include "devcommon/util.h"
 #include "mtbase.h"
@@ -19,6 +21,9 @@ using namespace dev::eth;
 namespace metabasenet
 {
 
+// Stack buffer for the big endian fields of a serialized tx, GetHash serializes every tx
+static const std::size_t TX_FIELD_ARENA_SIZE = 256;
+
 //////////////////////////////
 // CTransaction
 
@@ -547,11 +552,14 @@ void CTransaction::Serialize(mtbase::CStream& s, mtbase::SaveType&) const
     {
         //s << nType << nChainId << nTxNonce << destFrom << destTo << nAmount << nGasPrice << nGasLimit << mapTxData << vchSig;
 
-        bytes btFrom = destFrom.ToValidBigEndianData();
-        bytes btTo = destTo.ToValidBigEndianData();
-        bytes btAmount = nAmount.ToValidBigEndianData();
-        bytes btGasPrice = nGasPrice.ToValidBigEndianData();
-        bytes btGasLimit = nGasLimit.ToValidBigEndianData();
+        uint8 bufArena[TX_FIELD_ARENA_SIZE];
+        CArena arena(bufArena, sizeof(bufArena));
+        CArenaBytes btFrom(arena), btTo(arena), btAmount(arena), btGasPrice(arena), btGasLimit(arena);
+        destFrom.ToValidBigEndianData(btFrom);
+        destTo.ToValidBigEndianData(btTo);
+        nAmount.ToValidBigEndianData(btAmount);
+        nGasPrice.ToValidBigEndianData(btGasPrice);
+        nGasLimit.ToValidBigEndianData(btGasLimit);
 
         s << nType << CVarInt((uint64)nChainId) << CVarInt(nTxNonce) << btFrom << btTo << btAmount << btGasPrice << btGasLimit << mapTxData << vchSig;
     }
@@ -580,11 +588,9 @@ void CTransaction::Serialize(mtbase::CStream& s, mtbase::LoadType&)
 
         CVarInt varChainId;
         CVarInt varTxNonce;
-        bytes btFrom;
-        bytes btTo;
-        bytes btAmount;
-        bytes btGasPrice;
-        bytes btGasLimit;
+        uint8 bufArena[TX_FIELD_ARENA_SIZE];
+        CArena arena(bufArena, sizeof(bufArena));
+        CArenaBytes btFrom(arena), btTo(arena), btAmount(arena), btGasPrice(arena), btGasLimit(arena);
 
         s >> varChainId >> varTxNonce >> btFrom >> btTo >> btAmount >> btGasPrice >> btGasLimit >> mapTxData >> vchSig;
 
@@ -611,17 +617,49 @@ void CTransaction::Serialize(mtbase::CStream& s, std::size_t& serSize) const
     {
         //ss << nType << nChainId << nTxNonce << destFrom << destTo << nAmount << nGasPrice << nGasLimit << mapTxData << vchSig;
 
-        bytes btFrom = destFrom.ToValidBigEndianData();
-        bytes btTo = destTo.ToValidBigEndianData();
-        bytes btAmount = nAmount.ToValidBigEndianData();
-        bytes btGasPrice = nGasPrice.ToValidBigEndianData();
-        bytes btGasLimit = nGasLimit.ToValidBigEndianData();
+        uint8 bufArena[TX_FIELD_ARENA_SIZE];
+        CArena arena(bufArena, sizeof(bufArena));
+        CArenaBytes btFrom(arena), btTo(arena), btAmount(arena), btGasPrice(arena), btGasLimit(arena);
+        destFrom.ToValidBigEndianData(btFrom);
+        destTo.ToValidBigEndianData(btTo);
+        nAmount.ToValidBigEndianData(btAmount);
+        nGasPrice.ToValidBigEndianData(btGasPrice);
+        nGasLimit.ToValidBigEndianData(btGasLimit);
 
         ss << nType << CVarInt((uint64)nChainId) << CVarInt(nTxNonce) << btFrom << btTo << btAmount << btGasPrice << btGasLimit << mapTxData << vchSig;
     }
     serSize = ss.GetSize();
 }
 
+//////////////////////////////
+// CBloomDataSet
+
+void CBloomDataSet::GetBloomData(bytes& btBloomData)
+{
+    std::sort(vDest.begin(), vDest.end());
+    vDest.erase(std::unique(vDest.begin(), vDest.end()), vDest.end());
+    std::sort(vHash.begin(), vHash.end());
+    vHash.erase(std::unique(vHash.begin(), vHash.end()), vHash.end());
+
+    // Addresses and hashes differ in length, so they never collide with each other.
+    // The filter has 4 bits per distinct item, as sized from the former std::set<bytes>.
+    const std::size_t nCount = vDest.size() + vHash.size();
+    if (nCount == 0)
+    {
+        return;
+    }
+    CNhBloomFilter bf(nCount * 4);
+    for (const CDestination& dest : vDest)
+    {
+        bf.Add(dest.begin(), dest.size());
+    }
+    for (const uint256& hash : vHash)
+    {
+        bf.Add(hash.begin(), hash.size());
+    }
+    bf.GetData(btBloomData);
+}
+
 //////////////////////////////
 // CTransactionLogs
 
@@ -636,12 +674,12 @@ uint2048 CTransactionLogs::GetLogsBloom() const
     return uint2048(bf.GetData());
 }
 
-void CTransactionLogs::GetBloomDataSet(std::set<bytes>& setBloomData) const
+void CTransactionLogs::GetBloomDataSet(CBloomDataSet& setBloomData) const
 {
-    setBloomData.insert(address.GetBytes());
+    setBloomData.Insert(address);
     for (auto& t : topics)
     {
-        setBloomData.insert(t.GetBytes());
+        setBloomData.Insert(t);
     }
 }
 
@@ -650,14 +688,24 @@ void CTransactionLogs::GetBloomDataSet(std::set<bytes>& setBloomData) const
 
 void CTransactionReceipt::CalcLogsBloom()
 {
+    // A fixed size bloom of all logs equals the union of the per-log blooms
     nLogsBloom = 0;
-    for (auto& logs : vLogs)
+    if (!vLogs.empty())
     {
-        nLogsBloom |= logs.GetLogsBloom();
+        CNhBloomFilter bf(2048);
+        for (auto& logs : vLogs)
+        {
+            bf.Add(logs.address.begin(), logs.address.size());
+            for (auto& t : logs.topics)
+            {
+                bf.Add(t.begin(), t.size());
+            }
+        }
+        nLogsBloom = uint2048(bf.GetData());
     }
 }
 
-void CTransactionReceipt::GetBloomDataSet(std::set<bytes>& setBloomData) const
+void CTransactionReceipt::GetBloomDataSet(CBloomDataSet& setBloomData) const
 {
     for (auto& logs : vLogs)
     {
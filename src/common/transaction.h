@@ -85,6 +85,11 @@ public:
     {
         SetNull();
     }
+    // Declared with the virtual destructor so vectors of txs move them instead of copying
+    CTransaction(const CTransaction&) = default;
+    CTransaction(CTransaction&&) = default;
+    CTransaction& operator=(const CTransaction&) = default;
+    CTransaction& operator=(CTransaction&&) = default;
     virtual ~CTransaction() = default;
 
     virtual void SetNull();
@@ -452,13 +457,42 @@ protected:
     }
 };
 
+// Block bloom inputs. Addresses and hashes are kept as flat fixed-size values
+// and deduplicated once, when the block bloom is built.
+class CBloomDataSet
+{
+public:
+    void Insert(const CDestination& dest)
+    {
+        vDest.push_back(dest);
+    }
+    void Insert(const uint256& hash)
+    {
+        vHash.push_back(hash);
+    }
+    bool IsEmpty() const
+    {
+        return (vDest.empty() && vHash.empty());
+    }
+    void Clear()
+    {
+        vDest.clear();
+        vHash.clear();
+    }
+    void GetBloomData(bytes& btBloomData);
+
+protected:
+    std::vector<CDestination> vDest;
+    std::vector<uint256> vHash;
+};
+
 class CTransactionLogs
 {
     friend class mtbase::CStream;
 
 public:
     uint2048 GetLogsBloom() const;
-    void GetBloomDataSet(std::set<bytes>& setBloomData) const;
+    void GetBloomDataSet(CBloomDataSet& setBloomData) const;
 
 public:
     CDestination address;
@@ -522,7 +556,7 @@ public:
         return (nReceiptType == RECEIPT_TYPE_CONTRACT);
     }
     void CalcLogsBloom();
-    void GetBloomDataSet(std::set<bytes>& setBloomData) const;
+    void GetBloomDataSet(CBloomDataSet& setBloomData) const;
 
 public:
     enum
@@ -109,14 +109,16 @@ uint256 CryptoHash(const void* msg, size_t len)
     return hash;
 }
 
+// Merkle nodes hash the two children as one 64-byte message,
+// the one-shot call skips the streaming state of init/update/final.
 uint256 CryptoHash(const uint256& h1, const uint256& h2)
 {
+    uint8 buf[64];
+    memcpy(buf, h1.begin(), 32);
+    memcpy(buf + 32, h2.begin(), 32);
+
     uint256 hash;
-    crypto_generichash_blake2b_state state;
-    crypto_generichash_blake2b_init(&state, nullptr, 0, sizeof(hash));
-    crypto_generichash_blake2b_update(&state, h1.begin(), sizeof(h1));
-    crypto_generichash_blake2b_update(&state, h2.begin(), sizeof(h2));
-    crypto_generichash_blake2b_final(&state, hash.begin(), sizeof(hash));
+    crypto_generichash_blake2b(hash.begin(), sizeof(hash), buf, sizeof(buf), nullptr, 0);
     return hash;
 }
 
@@ -5,6 +5,7 @@
 #ifndef CRYPTO_UINT256_H
 #define CRYPTO_UINT256_H
 
+#include <algorithm>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <limits.h>
 #include <stdio.h>
@@ -577,6 +578,14 @@ public:
     }
 
     bytes ToValidBigEndianData() const
+    {
+        bytes btData;
+        ToValidBigEndianData(btData);
+        return btData;
+    }
+
+    template <typename A>
+    void ToValidBigEndianData(std::vector<unsigned char, A>& btData) const
     {
         unsigned char us[sizeof(pn)];
         ToBigEndian(&(us[0]), sizeof(pn));
@@ -589,12 +598,11 @@ public:
             }
             n++;
         }
-        bytes btData;
+        btData.clear();
         if (n != sizeof(pn))
         {
             btData.assign(&(us[0]) + n, &(us[0]) + sizeof(pn));
         }
-        return btData;
     }
 
     void FromBigEndian(const unsigned char* buf, const size_t bsize)
@@ -614,7 +622,8 @@ public:
         FromBigEndian(_data.data(), _data.size());
     }
 
-    void FromValidBigEndianData(const bytes& _data)
+    template <typename A>
+    void FromValidBigEndianData(const std::vector<unsigned char, A>& _data)
     {
         if (_data.size() >= sizeof(pn))
         {
@@ -622,10 +631,9 @@ public:
         }
         else
         {
-            bytes btData;
-            btData.resize(sizeof(pn) - _data.size(), 0);
-            btData.insert(btData.end(), _data.begin(), _data.end());
-            FromBigEndian(btData.data(), btData.size());
+            unsigned char us[sizeof(pn)] = { 0 };
+            std::copy(_data.begin(), _data.end(), &(us[0]) + sizeof(pn) - _data.size());
+            FromBigEndian(&(us[0]), sizeof(pn));
         }
     }
 
@@ -1957,4 +1965,16 @@ inline bool operator!=(const uint2048& a, const uint2048& b)
     return (base_uint2048)a != (base_uint2048)b;
 }
 
+// Hasher for unordered containers keyed by hashes or addresses,
+// their low 64 bits are already evenly distributed
+class CUintHasher
+{
+public:
+    template <unsigned int BITS>
+    std::size_t operator()(const base_uint<BITS>& n) const
+    {
+        return (std::size_t)n.Get64();
+    }
+};
+
 #endif // CRYPTO_UINT256_H
@@ -13,7 +13,7 @@
 #include "json_spirit_error_position.h"
 #include "json_spirit_value.h"
 
-//#define BOOST_SPIRIT_THREADSAFE  // uncomment for multithreaded use, requires linking to boost.thread
+#define BOOST_SPIRIT_THREADSAFE // requests are decoded on multiple threads, requires linking to boost.thread
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
@@ -117,14 +117,14 @@ CRPCReqVec DeserializeCRPCReq(const std::string& str, const std::set<std::string
         }
 
         // Parse jsonrpc
-        json_spirit::Value valJsonRPC = find_value(request, "jsonrpc");
+        const json_spirit::Value& valJsonRPC = find_value(request, "jsonrpc");
         if (valJsonRPC.type() == json_spirit::str_type)
         {
             req->strJSONRPC = valJsonRPC.get_str();
         }
 
         // Parse method
-        json_spirit::Value valMethod = find_value(request, "method");
+        const json_spirit::Value& valMethod = find_value(request, "method");
         if (valMethod.is_null())
         {
             throw CRPCException(RPC_INVALID_REQUEST, "Missing method", req->valID);
@@ -137,7 +137,7 @@ CRPCReqVec DeserializeCRPCReq(const std::string& str, const std::set<std::string
         req->strMethod = valMethod.get_str();
 
         // Parse params
-        json_spirit::Value valParams = find_value(request, "params");
+        const json_spirit::Value& valParams = find_value(request, "params");
         try
         {
             if (setNoParserMethod.find(req->strMethod) != setNoParserMethod.end())
@@ -150,10 +150,6 @@ CRPCReqVec DeserializeCRPCReq(const std::string& str, const std::set<std::string
             {
                 req->spParam = CreateCRPCParam(req->strMethod, valParams);
             }
-            if (req->spParam)
-            {
-                req->spParam->SetParamJson(json_spirit::write_string<json_spirit::Value>(valParams, 0, RPC_DOUBLE_PRECISION));
-            }
         }
         catch (CRPCException& e)
         {
@@ -32,13 +32,18 @@ public:
     {
         strParamJson = str;
     }
+    // Serialized on first use, most methods never need the raw params
     const std::string& GetParamJson() const
     {
+        if (strParamJson.empty())
+        {
+            strParamJson = json_spirit::write_string<json_spirit::Value>(ToJSON(), false, RPC_DOUBLE_PRECISION);
+        }
         return strParamJson;
     }
 
 protected:
-    std::string strParamJson;
+    mutable std::string strParamJson;
 };
 
 typedef std::shared_ptr<CRPCParam> CRPCParamPtr;
@@ -30,7 +30,32 @@ evmc_result execute(evmc_vm* _instance, const evmc_host_interface* _host,
     size_t _codeSize) noexcept
 {
     (void)_instance;
-    std::unique_ptr<dev::eth::VM> vm{new dev::eth::VM};
+    // Nested calls re-enter on the same thread, so take the instance of the current
+    // call depth and reset it rather than constructing a VM for every frame.
+    // Each VM carries a full data stack, so once the outermost call returns only the
+    // first few frames are kept; a deep call chain does not pin its frames per thread.
+    static const size_t c_maxKeptFrames = 16;
+    thread_local std::vector<std::unique_ptr<dev::eth::VM>> t_vmFrames;
+    thread_local size_t t_nFrameDepth = 0;
+    if (t_nFrameDepth >= t_vmFrames.size())
+        t_vmFrames.emplace_back(new dev::eth::VM);
+    dev::eth::VM* vm = t_vmFrames[t_nFrameDepth].get();
+    vm->reset();
+    struct FrameGuard
+    {
+        size_t& depth;
+        std::vector<std::unique_ptr<dev::eth::VM>>& frames;
+        FrameGuard(size_t& _depth, std::vector<std::unique_ptr<dev::eth::VM>>& _frames)
+          : depth(_depth), frames(_frames) { ++depth; }
+        ~FrameGuard()
+        {
+            if (--depth == 0 && frames.size() > c_maxKeptFrames)
+            {
+                frames.resize(c_maxKeptFrames);
+                frames.shrink_to_fit();
+            }
+        }
+    } frameGuard(t_nFrameDepth, t_vmFrames);
 
     evmc_result result = {};
     dev::eth::owning_bytes_ref output;
@@ -236,6 +261,39 @@ evmc_tx_context const& VM::getTxContext()
 //
 // interpreter entry point
 
+void VM::reset()
+{
+    m_io_gas = 0;
+    m_message = nullptr;
+    m_tx_context.reset();
+    m_bounce = nullptr;
+    m_nSteps = 0;
+    m_output = owning_bytes_ref();
+    // keep small buffers for the next frame, but release one a memory-hungry call grew
+    if (m_mem.capacity() > c_maxKeptBufferSize)
+        bytes().swap(m_mem);
+    else
+        m_mem.clear();
+    m_analysis.reset();
+    m_code = nullptr;
+    m_pool = nullptr;
+    m_jumpDests = nullptr;
+    if (m_returnData.capacity() > c_maxKeptBufferSize)
+        bytes().swap(m_returnData);
+    else
+        m_returnData.clear();
+    m_PC = 0;
+    m_SP = m_stackEnd;
+    m_SPP = m_SP;
+    m_runGas = 0;
+    m_newMemSize = 0;
+    m_copyMemSize = 0;
+    if (m_beginSubs.capacity() > c_maxKeptBufferSize / sizeof(uint64_t))
+        std::vector<uint64_t>().swap(m_beginSubs);
+    else
+        m_beginSubs.clear();
+}
+
 owning_bytes_ref VM::exec(const evmc_host_interface* _host, evmc_host_context* _context,
     evmc_revision _rev, const evmc_message* _msg, uint8_t const* _code, size_t _codeSize)
 {
@@ -317,7 +375,8 @@ void VM::interpretCases()
 
             uint64_t b = (uint64_t)m_SP[0];
             uint64_t s = (uint64_t)m_SP[1];
-            m_output = owning_bytes_ref{std::move(m_mem), b, s};
+            // copy the returned slice only, the memory buffer stays with this VM for the next frame
+            m_output = owning_bytes_ref{s ? bytes(m_mem.data() + b, m_mem.data() + b + s) : bytes(), 0, s};
             m_bounce = 0;
         }
         BREAK
@@ -335,7 +394,7 @@ void VM::interpretCases()
 
             uint64_t b = (uint64_t)m_SP[0];
             uint64_t s = (uint64_t)m_SP[1];
-            owning_bytes_ref output{std::move(m_mem), b, s};
+            owning_bytes_ref output{s ? bytes(m_mem.data() + b, m_mem.data() + b + s) : bytes(), 0, s};
             throwRevertInstruction(std::move(output));
         }
         BREAK;
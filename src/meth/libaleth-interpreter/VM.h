@@ -48,6 +48,15 @@ struct VMSchedule
     static constexpr int64_t callSelfGas = 40;
 };
 
+// Code copied, extended and rewritten by the optimizer, shared by every frame running the same code
+struct CodeAnalysis
+{
+    bytes code;
+    std::vector<intx::uint256> pool;
+    std::vector<uint64_t> jumpDests;
+};
+using CodeAnalysisPtr = std::shared_ptr<const CodeAnalysis>;
+
 class VM
 {
 public:
@@ -58,6 +67,10 @@ public:
     owning_bytes_ref exec(const evmc_host_interface* _host, evmc_host_context* _context,
         evmc_revision _rev, const evmc_message* _msg, uint8_t const* _code, size_t _codeSize);
 
+    // clear per-frame state so the instance can run the next frame, keeping buffer capacity
+    // up to c_maxKeptBufferSize
+    void reset();
+
     uint64_t m_io_gas = 0;
 private:
     const evmc_host_interface* m_host = nullptr;
@@ -67,7 +80,7 @@ private:
     evmc_message const* m_message = nullptr;
     boost::optional<evmc_tx_context> m_tx_context;
     static std::array<std::array<evmc_instruction_metrics, 256>, EVMC_MAX_REVISION + 1> s_metrics;
-    void copyCode(int);
+    void copyCode(bytes& o_code, int _extraBytes);
     typedef void (VM::*MemFnPtr)();
     MemFnPtr m_bounce = nullptr;
     uint64_t m_nSteps = 0;
@@ -75,13 +88,17 @@ private:
     // return bytes
     owning_bytes_ref m_output;
 
+    // largest buffer capacity reset() keeps for the next frame
+    static constexpr size_t c_maxKeptBufferSize = 64 * 1024;
+
     // space for memory
     bytes m_mem;
 
     uint8_t const* m_pCode = nullptr;
     size_t m_codeSize = 0;
-    // space for code
-    bytes m_code;
+    // shared analysed code
+    CodeAnalysisPtr m_analysis;
+    uint8_t const* m_code = nullptr;
 
     /// RETURNDATA buffer for memory returned from direct subcalls.
     bytes m_returnData;
@@ -92,7 +109,7 @@ private:
     size_t stackSize() { return m_stackEnd - m_SP; }
     
     // constant pool
-    std::vector<intx::uint256> m_pool;
+    intx::uint256 const* m_pool = nullptr;
 
     // interpreter state
     Instruction m_OP;         // current operation
@@ -108,6 +125,9 @@ private:
     // initialize interpreter
     void initEntry();
     void optimize();
+    void analyse(CodeAnalysis& _analysis);
+    static CodeAnalysisPtr findAnalysis(h256 const& _codeHash);
+    static void addAnalysis(h256 const& _codeHash, CodeAnalysisPtr const& _analysis);
 
     // interpreter loop & switch
     void interpretCases();
@@ -132,7 +152,7 @@ private:
     void throwBufferOverrun(intx::uint512 const& _enfOfAccess);
 
     std::vector<uint64_t> m_beginSubs;
-    std::vector<uint64_t> m_jumpDests;
+    std::vector<uint64_t> const* m_jumpDests = nullptr;
     int64_t verifyJumpDest(intx::uint256 const& _dest, bool _throw = true);
 
     void onOperation() {}
@@ -3,6 +3,8 @@
 // Licensed under the GNU General Public License, Version 3.
 #include "VM.h"
 
+#include <unordered_map>
+
 namespace dev
 {
 namespace eth
@@ -28,20 +30,64 @@ bool VM::initMetrics()
     return true;
 }
 
-void VM::copyCode(int _extraBytes)
+void VM::copyCode(bytes& o_code, int _extraBytes)
 {
     // Copy code so that it can be safely modified and extend code by
     // _extraBytes zero bytes to allow reading virtual data at the end
     // of the code without bounds checks.
     auto extendedSize = m_codeSize + _extraBytes;
-    m_code.reserve(extendedSize);
-    m_code.assign(m_pCode, m_pCode + m_codeSize);
-    m_code.resize(extendedSize);
+    o_code.reserve(extendedSize);
+    o_code.assign(m_pCode, m_pCode + m_codeSize);
+    o_code.resize(extendedSize);
+}
+
+namespace
+{
+// Per-thread cache of analysed code, nested frames and later txs running the
+// same contract reuse it instead of copying and rescanning the code.
+constexpr size_t c_maxCodeAnalysisCache = 256;
+thread_local std::unordered_map<h256, CodeAnalysisPtr> t_codeAnalysisCache;
+}  // namespace
+
+CodeAnalysisPtr VM::findAnalysis(h256 const& _codeHash)
+{
+    auto it = t_codeAnalysisCache.find(_codeHash);
+    if (it == t_codeAnalysisCache.end())
+        return CodeAnalysisPtr();
+    return it->second;
+}
+
+void VM::addAnalysis(h256 const& _codeHash, CodeAnalysisPtr const& _analysis)
+{
+    if (t_codeAnalysisCache.size() >= c_maxCodeAnalysisCache)
+        t_codeAnalysisCache.clear();
+    t_codeAnalysisCache[_codeHash] = _analysis;
 }
 
 void VM::optimize()
 {
-    copyCode(33);
+    h256 const codeHash = sha3(bytesConstRef(m_pCode, m_codeSize));
+    CodeAnalysisPtr analysis = findAnalysis(codeHash);
+    if (!analysis)
+    {
+        auto newAnalysis = std::make_shared<CodeAnalysis>();
+        analyse(*newAnalysis);
+        analysis = newAnalysis;
+        addAnalysis(codeHash, analysis);
+    }
+    m_analysis = analysis;
+    m_code = m_analysis->code.data();
+    m_pool = m_analysis->pool.data();
+    m_jumpDests = &m_analysis->jumpDests;
+}
+
+void VM::analyse(CodeAnalysis& _analysis)
+{
+    bytes& code = _analysis.code;
+    std::vector<intx::uint256>& pool = _analysis.pool;
+    m_jumpDests = &_analysis.jumpDests;
+
+    copyCode(code, 33);
 
     size_t const nBytes = m_codeSize;
 
@@ -50,7 +96,7 @@ void VM::optimize()
     TRACE_STR(1, "Build JUMPDEST table")
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
         TRACE_OP(2, pc, op);
                 
         // make synthetic ops in user code trigger invalid instruction if run
@@ -61,12 +107,12 @@ void VM::optimize()
         )
         {
             TRACE_OP(1, pc, op);
-            m_code[pc] = (byte)Instruction::UNDEFINED;
+            code[pc] = (byte)Instruction::UNDEFINED;
         }
 
         if (op == Instruction::JUMPDEST)
         {
-            m_jumpDests.push_back(pc);
+            _analysis.jumpDests.push_back(pc);
         }
         else if (
             (byte)Instruction::PUSH1 <= (byte)op &&
@@ -83,16 +129,16 @@ void VM::optimize()
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
         intx::uint256 val = 0;
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
 
         if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
             byte nPush = (byte)op - (byte)Instruction::PUSH1 + 1;
 
             // decode pushed bytes to integral value
-            val = m_code[pc+1];
+            val = code[pc+1];
             for (uint64_t i = pc+2, n = nPush; --n; ++i) {
-                val = (val << 8) | m_code[i];
+                val = (val << 8) | code[i];
             }
 
         #if EVM_USE_CONSTANT_POOL
@@ -102,16 +148,16 @@ void VM::optimize()
             // followed by one byte count of remaining pushed bytes
             if (5 < nPush)
             {
-                uint16_t pool_off = m_pool.size();
+                uint16_t pool_off = pool.size();
                 TRACE_VAL(1, "stash", val);
                 TRACE_VAL(1, "... in pool at offset" , pool_off);
-                m_pool.push_back(val);
+                pool.push_back(val);
 
                 TRACE_PRE_OPT(1, pc, op);
-                m_code[pc] = byte(op = Instruction::PUSHC);
-                m_code[pc+3] = nPush - 2;
-                m_code[pc+2] = pool_off & 0xff;
-                m_code[pc+1] = pool_off >> 8;
+                code[pc] = byte(op = Instruction::PUSHC);
+                code[pc+3] = nPush - 2;
+                code[pc+2] = pool_off & 0xff;
+                code[pc+1] = pool_off >> 8;
                 TRACE_POST_OPT(1, pc, op);
             }
 
@@ -123,14 +169,14 @@ void VM::optimize()
             // outer loop is N = number of bytes in code array
             // so complexity is N log M, worst case is N log N
             size_t i = pc + nPush + 1;
-            op = Instruction(m_code[i]);
+            op = Instruction(code[i]);
             if (op == Instruction::JUMP)
             {
                 TRACE_VAL(1, "Replace const JUMP with JUMPC to", val)
                 TRACE_PRE_OPT(1, i, op);
                 
                 if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPC);
+                    code[i] = byte(op = Instruction::JUMPC);
                 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -140,7 +186,7 @@ void VM::optimize()
                 TRACE_PRE_OPT(1, i, op);
                 
                 if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPCI);
+                    code[i] = byte(op = Instruction::JUMPCI);
                 
                 TRACE_POST_OPT(1, i, op);
             }
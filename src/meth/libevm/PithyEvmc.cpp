@@ -65,7 +65,9 @@ PithyEVMC::PithyEVMC(evmc_vm* _vm)
 
 PVMPtr PithyEVMC::createVm()
 {
-    return std::shared_ptr<PithyEVMC>(new PithyEVMC(evmc_create_aleth_interpreter()));
+    // The interpreter keeps its frames per thread, so one stateless handle serves every execution
+    static PVMPtr s_vm(new PithyEVMC(evmc_create_aleth_interpreter()));
+    return s_vm;
 }
 
 evmc::result PithyEVMC::exec(evmc::Host& host, const bool fCreate, const uint64_t gas, const evmc::address& destination, const evmc::address& sender,
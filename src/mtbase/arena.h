@@ -0,0 +1,165 @@
+// Copyright (c) 2022-2024 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef MTBASE_ARENA_H
+#define MTBASE_ARENA_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "type.h"
+
+namespace mtbase
+{
+
+// Monotonic arena: allocations are carved from large chunks and never freed
+// one by one. Reset rewinds to the start and keeps the chunks for reuse, all
+// chunks are released together when the arena is destroyed. The first chunk
+// may be a buffer of the caller, e.g. on the stack.
+class CArena
+{
+public:
+    CArena(const std::size_t nChunkSizeIn = DEFAULT_CHUNK_SIZE)
+      : nChunkSize(nChunkSizeIn), pBuffer(nullptr), nBufferSize(0), nChunk(0), pCurrent(nullptr), nLeft(0), nAllocated(0) {}
+    CArena(void* pBufferIn, const std::size_t nBufferSizeIn, const std::size_t nChunkSizeIn = DEFAULT_CHUNK_SIZE)
+      : nChunkSize(nChunkSizeIn), pBuffer((uint8*)pBufferIn), nBufferSize(nBufferSizeIn), nChunk(0), pCurrent(pBuffer), nLeft(nBufferSizeIn), nAllocated(0) {}
+    CArena(const CArena&) = delete;
+    CArena& operator=(const CArena&) = delete;
+
+    void* Allocate(const std::size_t nSize, const std::size_t nAlign)
+    {
+        std::size_t nPad = GetPadding(nAlign);
+        if (pCurrent == nullptr || nPad + nSize > nLeft)
+        {
+            NextChunk(nSize + nAlign);
+            nPad = GetPadding(nAlign);
+        }
+        uint8* p = pCurrent + nPad;
+        pCurrent = p + nSize;
+        nLeft -= (nPad + nSize);
+        nAllocated += nSize;
+        return p;
+    }
+    // Only when nothing allocated from the arena is in use any more
+    void Reset()
+    {
+        nChunk = 0;
+        if (pBuffer != nullptr)
+        {
+            pCurrent = pBuffer;
+            nLeft = nBufferSize;
+        }
+        else
+        {
+            pCurrent = nullptr;
+            nLeft = 0;
+        }
+        nAllocated = 0;
+    }
+    void Release()
+    {
+        vChunk.clear();
+        Reset();
+    }
+    std::size_t GetChunkCount() const
+    {
+        return vChunk.size();
+    }
+    std::size_t GetAllocatedSize() const
+    {
+        return nAllocated;
+    }
+
+protected:
+    std::size_t GetPadding(const std::size_t nAlign) const
+    {
+        return (nAlign - ((std::uintptr_t)pCurrent & (nAlign - 1))) & (nAlign - 1);
+    }
+    void NextChunk(const std::size_t nMinSize)
+    {
+        // Reuse the chunks kept by Reset, a chunk too small for this allocation is skipped
+        while (nChunk < vChunk.size())
+        {
+            CChunk& chunk = vChunk[nChunk++];
+            if (chunk.nSize >= nMinSize)
+            {
+                pCurrent = chunk.pData.get();
+                nLeft = chunk.nSize;
+                return;
+            }
+        }
+        const std::size_t nSize = (nMinSize > nChunkSize ? nMinSize : nChunkSize);
+        vChunk.emplace_back(nSize);
+        nChunk = vChunk.size();
+        pCurrent = vChunk.back().pData.get();
+        nLeft = nSize;
+    }
+
+protected:
+    enum
+    {
+        DEFAULT_CHUNK_SIZE = 0x10000
+    };
+    class CChunk
+    {
+    public:
+        CChunk(const std::size_t nSizeIn)
+          : pData(new uint8[nSizeIn]), nSize(nSizeIn) {}
+
+    public:
+        std::unique_ptr<uint8[]> pData;
+        std::size_t nSize;
+    };
+    const std::size_t nChunkSize;
+    uint8* pBuffer;
+    const std::size_t nBufferSize;
+    std::vector<CChunk> vChunk;
+    std::size_t nChunk; // chunks in use
+    uint8* pCurrent;
+    std::size_t nLeft;
+    std::size_t nAllocated;
+};
+
+// Allocator for standard containers living no longer than their arena,
+// wrap it in std::scoped_allocator_adaptor when nested containers share the arena.
+template <typename T>
+class CArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    CArenaAllocator(CArena& arenaIn) noexcept
+      : pArena(&arenaIn) {}
+    template <typename U>
+    CArenaAllocator(const CArenaAllocator<U>& other) noexcept
+      : pArena(other.pArena) {}
+
+    T* allocate(const std::size_t n)
+    {
+        return static_cast<T*>(pArena->Allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, const std::size_t) noexcept {}
+
+public:
+    CArena* pArena;
+};
+
+template <typename T, typename U>
+inline bool operator==(const CArenaAllocator<T>& a, const CArenaAllocator<U>& b)
+{
+    return a.pArena == b.pArena;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const CArenaAllocator<T>& a, const CArenaAllocator<U>& b)
+{
+    return a.pArena != b.pArena;
+}
+
+typedef std::vector<uint8, CArenaAllocator<uint8>> CArenaBytes;
+
+} // namespace mtbase
+
+#endif //MTBASE_ARENA_H
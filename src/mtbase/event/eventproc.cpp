@@ -60,6 +60,11 @@ void CEventProc::PostEvent(CEvent* pEvent)
     queEvent.AddNew(pEvent);
 }
 
+std::size_t CEventProc::GetPendingEventCount()
+{
+    return queEvent.GetSize();
+}
+
 void CEventProc::EventThreadFunc()
 {
     CEvent* pEvent = nullptr;
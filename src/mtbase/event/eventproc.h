@@ -57,6 +57,11 @@ public:
         }
         fAbort = false;
     }
+    std::size_t GetSize()
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        return que.size();
+    }
     void Interrupt()
     {
         {
@@ -83,6 +88,7 @@ class CEventProc : public IBase
 public:
     CEventProc(const std::string& ownKeyIn, const uint32 nThreadCount = 1);
     void PostEvent(CEvent* pEvent);
+    std::size_t GetPendingEventCount();
 
     void AddEventThread(const uint32 nCount);
 
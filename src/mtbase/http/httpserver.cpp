@@ -224,6 +224,7 @@ bool CHttpServer::CreateProfile(const CHttpHostConfig& confHost)
 
     profile.nMaxConnections = confHost.nMaxConnections;
     profile.vAllowMask = confHost.vAllowMask;
+    profile.nMaxPending = confHost.nMaxPending;
 
     mapProfile[confHost.epHost] = profile;
 
@@ -348,6 +349,12 @@ void CHttpServer::HandleClientRecv(CHttpClient* pHttpClient, MAPIKeyValue& mapHe
             return;
         }
     }
+    if (pHttpProfile->nMaxPending > 0 && pHttpProfile->pIOModule->GetPendingEventCount() >= pHttpProfile->nMaxPending)
+    {
+        RespondError(pHttpClient, 503);
+        delete pEventHttpReq;
+        return;
+    }
     pHttpProfile->pIOModule->PostEvent(pEventHttpReq);
 }
 
@@ -431,6 +438,8 @@ void CHttpServer::RespondError(CHttpClient* pHttpClient, int nStatusCode, const
             strStatus = "Not Found";
         if (nStatusCode == 500)
             strStatus = "Internal Server Error";
+        if (nStatusCode == 503)
+            strStatus = "Service Unavailable";
         strContent = "<!DOCTYPE HTML PUBLIC \"-//IETF//DTD HTML 2.0//EN\">"
                      "<html><head><title>"
                      + strStatus + "</title></head>"
@@ -17,12 +17,13 @@ class CHttpServer;
 class CHttpHostConfig
 {
 public:
-    CHttpHostConfig() {}
+    CHttpHostConfig()
+      : nMaxPending(0) {}
     CHttpHostConfig(const uint32 nLinkChainIdIn, const boost::asio::ip::tcp::endpoint& epHostIn, unsigned int nMaxConnectionsIn,
                     const CIOSSLOption& optSSLIn, const std::map<std::string, std::string>& mapUserPassIn,
-                    const std::vector<std::string>& vAllowMaskIn, const std::string& strIOModuleIn)
+                    const std::vector<std::string>& vAllowMaskIn, const std::string& strIOModuleIn, unsigned int nMaxPendingIn = 0)
       : nLinkChainId(nLinkChainIdIn), epHost(epHostIn), nMaxConnections(nMaxConnectionsIn), optSSL(optSSLIn),
-        mapUserPass(mapUserPassIn), vAllowMask(vAllowMaskIn), strIOModule(strIOModuleIn)
+        mapUserPass(mapUserPassIn), vAllowMask(vAllowMaskIn), strIOModule(strIOModuleIn), nMaxPending(nMaxPendingIn)
     {
     }
 
@@ -34,13 +35,14 @@ public:
     std::map<std::string, std::string> mapUserPass;
     std::vector<std::string> vAllowMask;
     std::string strIOModule;
+    unsigned int nMaxPending; // 0: no limit on requests queued in the io module
 };
 
 class CHttpProfile
 {
 public:
     CHttpProfile(const uint32 nProChainIdIn = 0, const boost::asio::ip::tcp::endpoint& epHostIn = {})
-      : nProChainId(nProChainIdIn), epHost(epHostIn), pIOModule(nullptr), pSSLContext(nullptr), nMaxConnections(0) {}
+      : nProChainId(nProChainIdIn), epHost(epHostIn), pIOModule(nullptr), pSSLContext(nullptr), nMaxConnections(0), nMaxPending(0) {}
 
 public:
     uint32 nProChainId;
@@ -50,6 +52,7 @@ public:
     std::map<std::string, std::string> mapAuthrizeUser;
     std::vector<std::string> vAllowMask;
     unsigned int nMaxConnections;
+    unsigned int nMaxPending;
 };
 
 class CHttpClient
@@ -5,6 +5,7 @@
 #ifndef MTBASE_MTBASE_H
 #define MTBASE_MTBASE_H
 
+#include <arena.h>
 #include <base/base.h>
 #include <cache.h>
 #include <compacttv.h>
@@ -0,0 +1,140 @@
+// Copyright (c) 2022-2024 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php
+
+#include "addrbook.h"
+
+#include "util.h"
+
+using namespace std;
+using namespace boost::filesystem;
+using boost::asio::ip::tcp;
+
+namespace mtbase
+{
+
+///////////////////////////////
+// CAddressBookEntry
+
+bool CAddressBookEntry::GetEndpoint(tcp::endpoint& ep) const
+{
+    boost::system::error_code ec;
+    boost::asio::ip::address addr = boost::asio::ip::address::from_string(strAddress, ec);
+    if (ec)
+    {
+        return false;
+    }
+    ep = tcp::endpoint(addr, nPort);
+    return true;
+}
+
+void CAddressBookEntry::SetEndpoint(const tcp::endpoint& ep)
+{
+    boost::system::error_code ec;
+    strAddress = ep.address().to_string(ec);
+    nPort = ep.port();
+}
+
+bool CAddressBookEntry::IsBetterThan(const CAddressBookEntry& entry) const
+{
+    if (nScore != entry.nScore)
+    {
+        return (nScore > entry.nScore);
+    }
+    if (nFailures != entry.nFailures)
+    {
+        return (nFailures < entry.nFailures);
+    }
+    if ((nLatency == 0) != (entry.nLatency == 0))
+    {
+        return (nLatency != 0);
+    }
+    if (nLatency != entry.nLatency)
+    {
+        return (nLatency < entry.nLatency);
+    }
+    return (nLastSuccess > entry.nLastSuccess);
+}
+
+///////////////////////////////
+// CAddressBook
+
+CAddressBook::CAddressBook()
+{
+}
+
+void CAddressBook::SetPath(const path& pathFileIn)
+{
+    pathFile = pathFileIn;
+}
+
+bool CAddressBook::Load(vector<CAddressBookEntry>& vEntry)
+{
+    vEntry.clear();
+    if (pathFile.empty() || !is_regular_file(pathFile))
+    {
+        return true;
+    }
+    try
+    {
+        uint32 nVersion = 0;
+        CFileStream fs(pathFile.string().c_str());
+        fs >> nVersion;
+        if (nVersion != ADDRBOOK_VERSION)
+        {
+            StdWarn("CAddressBook", "Load: unknown version %u, ignore address book", nVersion);
+            return true;
+        }
+        fs >> vEntry;
+    }
+    catch (std::exception& e)
+    {
+        vEntry.clear();
+        StdError("CAddressBook", "Load: %s", e.what());
+        return false;
+    }
+    return true;
+}
+
+bool CAddressBook::Save(const vector<CAddressBookEntry>& vEntry)
+{
+    if (pathFile.empty())
+    {
+        return false;
+    }
+
+    // Write a temporary file and rename it over the old one,
+    // so a crash during flush never leaves a truncated address book.
+    path pathTemp = pathFile;
+    pathTemp += ".tmp";
+    FILE* fp = fopen(pathTemp.string().c_str(), "w");
+    if (fp == nullptr)
+    {
+        StdError("CAddressBook", "Save: open file fail, file: %s", pathTemp.string().c_str());
+        return false;
+    }
+    fclose(fp);
+
+    try
+    {
+        uint32 nVersion = ADDRBOOK_VERSION;
+        CFileStream fs(pathTemp.string().c_str());
+        fs << nVersion << vEntry;
+    }
+    catch (std::exception& e)
+    {
+        StdError("CAddressBook", "Save: %s", e.what());
+        return false;
+    }
+
+    boost::system::error_code ec;
+    rename(pathTemp, pathFile, ec);
+    if (ec)
+    {
+        StdError("CAddressBook", "Save: rename fail, file: %s, err: %s", pathFile.string().c_str(), ec.message().c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace mtbase
@@ -0,0 +1,84 @@
+// Copyright (c) 2022-2024 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef MTBASE_PEERNET_ADDRBOOK_H
+#define MTBASE_PEERNET_ADDRBOOK_H
+
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
+
+#include "stream/stream.h"
+#include "type.h"
+
+namespace mtbase
+{
+
+class CAddressBookEntry
+{
+    friend class CStream;
+
+public:
+    CAddressBookEntry()
+      : nPort(0), nService(0), nScore(0), nLastSeen(0), nLastSuccess(0), nLatency(0), nFailures(0), nBanTo(0) {}
+
+    bool IsDialable() const
+    {
+        return (nPort != 0 && nService != 0);
+    }
+    bool GetEndpoint(boost::asio::ip::tcp::endpoint& ep) const;
+    void SetEndpoint(const boost::asio::ip::tcp::endpoint& ep);
+    bool IsBetterThan(const CAddressBookEntry& entry) const;
+
+protected:
+    template <typename O>
+    void Serialize(CStream& s, O& opt)
+    {
+        s.Serialize(strAddress, opt);
+        s.Serialize(nPort, opt);
+        s.Serialize(nService, opt);
+        s.Serialize(nScore, opt);
+        s.Serialize(nLastSeen, opt);
+        s.Serialize(nLastSuccess, opt);
+        s.Serialize(nLatency, opt);
+        s.Serialize(nFailures, opt);
+        s.Serialize(nBanTo, opt);
+    }
+
+public:
+    std::string strAddress;
+    uint16 nPort; // 0: status only, not an out-bound candidate
+    uint64 nService;
+    int nScore;
+    int64 nLastSeen;
+    int64 nLastSuccess;
+    int nLatency; // ping-pong round trip, ms
+    int nFailures;
+    int64 nBanTo;
+};
+
+class CAddressBook
+{
+public:
+    CAddressBook();
+    void SetPath(const boost::filesystem::path& pathFileIn);
+    bool IsEnabled() const
+    {
+        return !pathFile.empty();
+    }
+    bool Load(std::vector<CAddressBookEntry>& vEntry);
+    bool Save(const std::vector<CAddressBookEntry>& vEntry);
+
+protected:
+    enum
+    {
+        ADDRBOOK_VERSION = 1
+    };
+    boost::filesystem::path pathFile;
+};
+
+} // namespace mtbase
+
+#endif //MTBASE_PEERNET_ADDRBOOK_H
@@ -4,6 +4,8 @@
 
 #include "epmngr.h"
 
+#include <algorithm>
+#include <set>
 #include <vector>
 
 #include "util.h"
@@ -56,7 +58,7 @@ bool CConnAttempt::Attempt(int64 ts)
 // CAddressStatus
 
 CAddressStatus::CAddressStatus()
-  : nScore(0), nLastSeen(), nBanTo(0), nConnections(0)
+  : nScore(0), nLastSeen(), nBanTo(0), nLastSuccess(0), nLatency(0), nFailures(0), nConnections(0)
 {
 }
 
@@ -120,6 +122,30 @@ void CAddressStatus::Penalize(int nPoints, int64 ts)
     }
 }
 
+void CAddressStatus::Succeed(int64 ts)
+{
+    nLastSuccess = ts;
+    nLastSeen = ts;
+    nFailures = 0;
+}
+
+void CAddressStatus::Fail()
+{
+    if (nFailures < MAX_FAILURES)
+    {
+        nFailures++;
+    }
+}
+
+void CAddressStatus::UpdateLatency(int nLatencyIn)
+{
+    if (nLatencyIn <= 0)
+    {
+        return;
+    }
+    nLatency = (nLatency == 0 ? nLatencyIn : (nLatency * 3 + nLatencyIn) / 4);
+}
+
 ///////////////////////////////
 // CEndpointManager
 
@@ -278,6 +304,10 @@ void CEndpointManager::CloseEndpoint(const tcp::endpoint& ep, CloseReason reason
     {
         status.Penalize(lost[index], now);
     }
+    if (reason == CONNECT_FAILURE || reason == NETWORK_ERROR || reason == RESPONSE_FAILURE)
+    {
+        status.Fail();
+    }
     mngrNode.Dismiss(ep, (reason == NETWORK_ERROR), false);
     status.RemoveConnection();
 
@@ -318,6 +348,126 @@ void CEndpointManager::RetrieveGoodNode(vector<CNodeAvail>& vGoodNode,
     }
 }
 
+void CEndpointManager::ActivateEndpoint(const tcp::endpoint& ep)
+{
+    mapAddressStatus[ep.address()].Succeed(GetTime());
+}
+
+void CEndpointManager::SetEndpointLatency(const tcp::endpoint& ep, int nLatency)
+{
+    map<boost::asio::ip::address, CAddressStatus>::iterator it = mapAddressStatus.find(ep.address());
+    if (it != mapAddressStatus.end())
+    {
+        (*it).second.UpdateLatency(nLatency);
+    }
+}
+
+void CEndpointManager::ExportAddressBook(vector<CAddressBookEntry>& vEntry, size_t nMaxCount)
+{
+    int64 now = GetTime();
+    int64 inactive = now - MAX_INACTIVE_TIME;
+    vector<CNode> vNode;
+    mngrNode.Retrieve(vNode);
+
+    vector<CAddressBookEntry> vDialable;
+    set<boost::asio::ip::address> setExported;
+    for (const CNode& node : vNode)
+    {
+        if (node.strName == "connect" || node.strName == "dnseed" || node.data.type() != typeid(uint64))
+        {
+            continue;
+        }
+        CAddressBookEntry entry;
+        entry.SetEndpoint(node.ep);
+        entry.nService = boost::any_cast<uint64>(node.data);
+        map<boost::asio::ip::address, CAddressStatus>::iterator it = mapAddressStatus.find(node.ep.address());
+        if (it != mapAddressStatus.end())
+        {
+            const CAddressStatus& status = (*it).second;
+            if (status.nLastSeen <= inactive && status.nBanTo <= now)
+            {
+                continue;
+            }
+            entry.nScore = status.nScore;
+            entry.nLastSeen = status.nLastSeen;
+            entry.nLastSuccess = status.nLastSuccess;
+            entry.nLatency = status.nLatency;
+            entry.nFailures = status.nFailures;
+            entry.nBanTo = status.nBanTo;
+        }
+        else
+        {
+            entry.nLastSeen = now;
+        }
+        vDialable.push_back(entry);
+        setExported.insert(node.ep.address());
+    }
+
+    sort(vDialable.begin(), vDialable.end(),
+         [](const CAddressBookEntry& a, const CAddressBookEntry& b) { return a.IsBetterThan(b); });
+    if (vDialable.size() > nMaxCount)
+    {
+        vDialable.resize(nMaxCount);
+    }
+    vEntry.insert(vEntry.end(), vDialable.begin(), vDialable.end());
+
+    // Keep the ban state of addresses we never dial, e.g. misbehaving in-bound peers
+    for (const auto& kv : mapAddressStatus)
+    {
+        const CAddressStatus& status = kv.second;
+        if (now < status.nBanTo && !setExported.count(kv.first))
+        {
+            CAddressBookEntry entry;
+            entry.SetEndpoint(tcp::endpoint(kv.first, 0));
+            entry.nScore = status.nScore;
+            entry.nLastSeen = status.nLastSeen;
+            entry.nBanTo = status.nBanTo;
+            vEntry.push_back(entry);
+        }
+    }
+}
+
+size_t CEndpointManager::ImportAddressBook(const vector<CAddressBookEntry>& vEntry)
+{
+    int64 now = GetTime();
+    int64 inactive = now - MAX_INACTIVE_TIME;
+    vector<CAddressBookEntry> vSorted(vEntry);
+    stable_sort(vSorted.begin(), vSorted.end(),
+                [](const CAddressBookEntry& a, const CAddressBookEntry& b) { return a.IsBetterThan(b); });
+
+    size_t nDialable = 0;
+    for (const CAddressBookEntry& entry : vSorted)
+    {
+        tcp::endpoint ep;
+        if (!entry.GetEndpoint(ep) || (entry.nLastSeen <= inactive && entry.nBanTo <= now))
+        {
+            continue;
+        }
+        CAddressStatus& status = mapAddressStatus[ep.address()];
+        status.nScore = entry.nScore;
+        status.nLastSeen = entry.nLastSeen;
+        status.nBanTo = entry.nBanTo;
+        status.nLastSuccess = entry.nLastSuccess;
+        status.nLatency = entry.nLatency;
+        status.nFailures = entry.nFailures;
+
+        if (entry.IsDialable())
+        {
+            mngrNode.AddNew(ep, entry.strAddress, boost::any(entry.nService));
+            if (now < entry.nBanTo)
+            {
+                mngrNode.Ban(ep.address(), entry.nBanTo);
+            }
+            else
+            {
+                nDialable++;
+            }
+        }
+    }
+    CleanInactiveAddress();
+    return nDialable;
+}
+
 void CEndpointManager::CleanInactiveAddress()
 {
     if (mapAddressStatus.size() <= MAX_ADDRESS_COUNT)
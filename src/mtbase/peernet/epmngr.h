@@ -10,6 +10,7 @@
 #include <map>
 #include <vector>
 
+#include "peernet/addrbook.h"
 #include "peernet/nodemngr.h"
 #include "type.h"
 
@@ -48,6 +49,9 @@ public:
     void RemoveConnection();
     void Reward(int nPoints, int64 ts);
     void Penalize(int nPoints, int64 ts);
+    void Succeed(int64 ts);
+    void Fail();
+    void UpdateLatency(int nLatencyIn);
 
 public:
     enum
@@ -64,9 +68,16 @@ public:
         BANTIME_BASE = 20,
         ATTEMPT_PENALTY = 50
     };
+    enum
+    {
+        MAX_FAILURES = 1024
+    };
     int nScore;
     int64 nLastSeen;
     int64 nBanTo;
+    int64 nLastSuccess;
+    int nLatency;
+    int nFailures;
 
 protected:
     CConnAttempt connAttempt;
@@ -142,6 +153,10 @@ public:
     void CloseEndpoint(const boost::asio::ip::tcp::endpoint& ep, CloseReason reason);
     void RetrieveGoodNode(std::vector<CNodeAvail>& vGoodNode,
                           int64 nActiveTime, std::size_t nMaxCount);
+    void ActivateEndpoint(const boost::asio::ip::tcp::endpoint& ep);
+    void SetEndpointLatency(const boost::asio::ip::tcp::endpoint& ep, int nLatency);
+    void ExportAddressBook(std::vector<CAddressBookEntry>& vEntry, std::size_t nMaxCount);
+    std::size_t ImportAddressBook(const std::vector<CAddressBookEntry>& vEntry);
     int GetCandidateNodeCount()
     {
         return mngrNode.GetCandidateNodeCount();
@@ -23,7 +23,7 @@ namespace mtbase
 // CPeerNet
 
 CPeerNet::CPeerNet(const string& ownKeyIn)
-  : CIOProc(ownKeyIn), confNetwork{}, pGarbagePeer(nullptr)
+  : CIOProc(ownKeyIn), confNetwork{}, nAddrBookFlushTime(0), nFastDialCount(0), pGarbagePeer(nullptr)
 {
 }
 
@@ -76,6 +76,8 @@ void CPeerNet::EnterLoop()
         }
     }
 
+    LoadAddressBook();
+
     for (const CNetHost& host : confNetwork.vecNode)
     {
         AddNewNode(host);
@@ -100,59 +102,103 @@ void CPeerNet::LeaveLoop()
         StopService(service.epListen);
     }
 
+    FlushAddressBook();
     epMngr.Clear();
 }
 
 void CPeerNet::HeartBeat()
 {
-    if (GetOutBoundIdleCount() != 0)
+    // Right after start, dial all restored good peers at once instead of one per beat
+    size_t nDialCount = (nFastDialCount > 0 ? nFastDialCount : 1);
+    size_t nDialed = 0;
+    tcp::endpoint epRemote;
+    while (nDialed < nDialCount && GetOutBoundIdleCount() != 0 && epMngr.FetchOutBound(epRemote))
+    {
+        if (!ConnectOutBound(epRemote))
+        {
+            StdLog("CPeerNet", "Connect peer fail, peer: %s", GetEpString(epRemote).c_str());
+            epMngr.CloseEndpoint(epRemote, CEndpointManager::CONNECT_FAILURE);
+        }
+        else
+        {
+            StdLog("CPeerNet", "Start connecting peer, peer: %s", GetEpString(epRemote).c_str());
+        }
+        nDialed++;
+    }
+    nFastDialCount = (nFastDialCount > nDialed ? nFastDialCount - nDialed : 0);
+    if (GetOutBoundIdleCount() == 0)
+    {
+        nFastDialCount = 0;
+    }
+
+    if (addrBook.IsEnabled() && GetTime() - nAddrBookFlushTime >= ADDRBOOK_FLUSH_INTERVAL)
+    {
+        FlushAddressBook();
+    }
+}
+
+bool CPeerNet::ConnectOutBound(const tcp::endpoint& epRemote)
+{
+    if (epRemote.address().is_v4() && !confNetwork.strSocketBindLocalIpV4.empty())
     {
-        tcp::endpoint epRemote;
-        if (epMngr.FetchOutBound(epRemote))
+        boost::system::error_code ec;
+        tcp::endpoint epLocal(boost::asio::ip::address_v4::from_string(confNetwork.strSocketBindLocalIpV4, ec), 0);
+        if (ec)
+        {
+            StdLog("CPeerNet", "from_string local fail, local: %s, err: %s", confNetwork.strSocketBindLocalIpV4.c_str(), ec.message().c_str());
+            return false;
+        }
+        return ConnectByBindAddress(epLocal, epRemote, CONNECT_TIMEOUT);
+    }
+    else if (epRemote.address().is_v6() && !confNetwork.strSocketBindLocalIpV6.empty())
+    {
+        boost::system::error_code ec;
+        tcp::endpoint epLocal(boost::asio::ip::address_v6::from_string(confNetwork.strSocketBindLocalIpV6, ec), 0);
+        if (ec)
         {
-            bool fRet = true;
-            if (epRemote.address().is_v4() && !confNetwork.strSocketBindLocalIpV4.empty())
-            {
-                boost::system::error_code ec;
-                tcp::endpoint epLocal(boost::asio::ip::address_v4::from_string(confNetwork.strSocketBindLocalIpV4, ec), 0);
-                if (ec)
-                {
-                    StdLog("CPeerNet", "from_string local fail, local: %s, err: %s", confNetwork.strSocketBindLocalIpV4.c_str(), ec.message().c_str());
-                    fRet = false;
-                }
-                else
-                {
-                    fRet = ConnectByBindAddress(epLocal, epRemote, CONNECT_TIMEOUT);
-                }
-            }
-            else if (epRemote.address().is_v6() && !confNetwork.strSocketBindLocalIpV6.empty())
-            {
-                boost::system::error_code ec;
-                tcp::endpoint epLocal(boost::asio::ip::address_v6::from_string(confNetwork.strSocketBindLocalIpV6, ec), 0);
-                if (ec)
-                {
-                    StdLog("CPeerNet", "from_string local fail, local: %s, err: %s", confNetwork.strSocketBindLocalIpV6.c_str(), ec.message().c_str());
-                    fRet = false;
-                }
-                else
-                {
-                    fRet = ConnectByBindAddress(epLocal, epRemote, CONNECT_TIMEOUT);
-                }
-            }
-            else
-            {
-                fRet = Connect(epRemote, CONNECT_TIMEOUT);
-            }
-            if (!fRet)
-            {
-                StdLog("CPeerNet", "Connect peer fail, peer: %s", GetEpString(epRemote).c_str());
-                epMngr.CloseEndpoint(epRemote, CEndpointManager::CONNECT_FAILURE);
-            }
-            else
-            {
-                StdLog("CPeerNet", "Start connecting peer, peer: %s", GetEpString(epRemote).c_str());
-            }
+            StdLog("CPeerNet", "from_string local fail, local: %s, err: %s", confNetwork.strSocketBindLocalIpV6.c_str(), ec.message().c_str());
+            return false;
         }
+        return ConnectByBindAddress(epLocal, epRemote, CONNECT_TIMEOUT);
+    }
+    return Connect(epRemote, CONNECT_TIMEOUT);
+}
+
+void CPeerNet::LoadAddressBook()
+{
+    nFastDialCount = 0;
+    nAddrBookFlushTime = GetTime();
+    addrBook.SetPath(confNetwork.pathAddressBook);
+    if (!addrBook.IsEnabled())
+    {
+        return;
+    }
+
+    vector<CAddressBookEntry> vEntry;
+    if (!addrBook.Load(vEntry))
+    {
+        StdError("CPeerNet", "Load address book fail, file: %s", confNetwork.pathAddressBook.string().c_str());
+        return;
+    }
+    size_t nDialable = epMngr.ImportAddressBook(vEntry);
+    nFastDialCount = min(nDialable, confNetwork.nMaxOutBounds);
+    StdLog("CPeerNet", "Load address book: entries: %lu, dialable: %lu, fast dial: %lu",
+           vEntry.size(), nDialable, nFastDialCount);
+}
+
+void CPeerNet::FlushAddressBook()
+{
+    if (!addrBook.IsEnabled())
+    {
+        return;
+    }
+    nAddrBookFlushTime = GetTime();
+
+    vector<CAddressBookEntry> vEntry;
+    epMngr.ExportAddressBook(vEntry, ADDRBOOK_MAX_DIALABLE);
+    if (!addrBook.Save(vEntry))
+    {
+        StdError("CPeerNet", "Flush address book fail, file: %s", confNetwork.pathAddressBook.string().c_str());
     }
 }
 
@@ -385,6 +431,16 @@ void CPeerNet::AddProtocolInvalidPeer(CPeer* pPeer)
     setProtocolInvalidIP.insert(pPeer->GetRemote().address());
 }
 
+void CPeerNet::ActivatePeer(CPeer* pPeer)
+{
+    epMngr.ActivateEndpoint(pPeer->GetRemote());
+}
+
+void CPeerNet::SetPeerLatency(CPeer* pPeer, int nLatency)
+{
+    epMngr.SetEndpointLatency(pPeer->GetRemote(), nLatency);
+}
+
 string CPeerNet::GetNodeName(const tcp::endpoint& epNode)
 {
     return epMngr.GetOutBoundName(epNode);
@@ -7,6 +7,7 @@
 
 #include <boost/any.hpp>
 #include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
 #include <map>
 #include <set>
 #include <string>
@@ -44,6 +45,7 @@ public:
     unsigned short nPortDefault;
     std::string strSocketBindLocalIpV4;
     std::string strSocketBindLocalIpV6;
+    boost::filesystem::path pathAddressBook; // empty: address book disabled
 };
 
 class CPeerNet : public CIOProc, virtual public CPeerEventListener
@@ -67,6 +69,9 @@ protected:
     bool ClientConnected(CIOClient* pClient) override;
     void ClientFailToConnect(const boost::asio::ip::tcp::endpoint& epRemote) override;
     void HostResolved(const CNetHost& host, const boost::asio::ip::tcp::endpoint& ep) override;
+    bool ConnectOutBound(const boost::asio::ip::tcp::endpoint& epRemote);
+    void LoadAddressBook();
+    void FlushAddressBook();
     CPeer* AddNewPeer(CIOClient* pClient, bool fInBound);
     void RewardPeer(CPeer* pPeer, const CEndpointManager::Bonus& bonus);
     void RemovePeer(CPeer* pPeer, const CEndpointManager::CloseReason& reason);
@@ -78,6 +83,8 @@ protected:
     void RemoveNode(const CNetHost& host);
     void RemoveNode(const boost::asio::ip::tcp::endpoint& epNode);
     void AddProtocolInvalidPeer(CPeer* pPeer);
+    void ActivatePeer(CPeer* pPeer);
+    void SetPeerLatency(CPeer* pPeer, int nLatency);
     std::string GetNodeName(const boost::asio::ip::tcp::endpoint& epNode);
     bool GetNodeData(const boost::asio::ip::tcp::endpoint& epNode, boost::any& data);
     bool SetNodeData(const boost::asio::ip::tcp::endpoint& epNode, const boost::any& data);
@@ -107,7 +114,15 @@ protected:
     std::set<boost::asio::ip::address> setProtocolInvalidIP;
 
 private:
+    enum
+    {
+        ADDRBOOK_FLUSH_INTERVAL = 300,
+        ADDRBOOK_MAX_DIALABLE = 1024
+    };
     CEndpointManager epMngr;
+    CAddressBook addrBook;
+    int64 nAddrBookFlushTime;
+    std::size_t nFastDialCount;
     std::map<uint64, CPeer*> mapPeer;
     CPeer* pGarbagePeer;
 };
@@ -537,16 +537,13 @@ inline CStream& CStream::Serialize(std::vector<T, A>& t, ObjectType&, LoadType&)
         }
         else
         {
-            std::list<T> l;
+            // Decode in place, reserving no more than the stream holds against a bad length
+            t.reserve(std::min<uint64>(var.nValue, GetSize() / sizeof(T) + 1));
             for (uint64 i = 0; i < var.nValue; i++)
             {
-                T data;
-                *this >> data;
-                l.push_back(std::move(data));
+                t.emplace_back();
+                *this >> t.back();
             }
-
-            t.reserve(var.nValue);
-            t.insert(t.end(), std::make_move_iterator(l.begin()), std::make_move_iterator(l.end()));
         }
     }
 
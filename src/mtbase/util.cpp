@@ -427,4 +427,29 @@ bool BtUncompress(const bytes& btSrc, bytes& btDst)
     return true;
 }
 
+bool BtCompress(const char* pSrc, const std::size_t nSrcSize, bytes& btDst)
+{
+    btDst.resize(snappy::MaxCompressedLength(nSrcSize));
+    size_t dstlen = btDst.size();
+    snappy::RawCompress(pSrc, nSrcSize, (char*)btDst.data(), &dstlen);
+    btDst.resize(dstlen);
+    return true;
+}
+
+bool BtUncompress(const char* pSrc, const std::size_t nSrcSize, bytes& btDst, const std::size_t nMaxDstSize)
+{
+    // Check the declared length before allocating, untrusted input must not expand beyond nMaxDstSize
+    size_t ulength = 0;
+    if (!snappy::GetUncompressedLength(pSrc, nSrcSize, &ulength) || ulength > nMaxDstSize)
+    {
+        return false;
+    }
+    btDst.resize(ulength);
+    if (!snappy::RawUncompress(pSrc, nSrcSize, (char*)btDst.data()))
+    {
+        return false;
+    }
+    return true;
+}
+
 } // namespace mtbase
\ No newline at end of file
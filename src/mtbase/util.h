@@ -430,6 +430,8 @@ bool SplitNumber(const std::string& strNumber, std::string& strInteger, std::str
 
 bool BtCompress(const bytes& btSrc, bytes& btDst);
 bool BtUncompress(const bytes& btSrc, bytes& btDst);
+bool BtCompress(const char* pSrc, const std::size_t nSrcSize, bytes& btDst);
+bool BtUncompress(const char* pSrc, const std::size_t nSrcSize, bytes& btDst, const std::size_t nMaxDstSize);
 
 } // namespace mtbase
 
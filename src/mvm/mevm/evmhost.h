@@ -43,7 +43,7 @@ public:
         auto it = cacheKv.find(dest);
         if (it != cacheKv.end())
         {
-            out = it->second;
+            out.swap(it->second);
             cacheKv.erase(it);
             return true;
         }
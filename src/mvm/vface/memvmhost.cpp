@@ -85,7 +85,7 @@ void CMemVmHost::SaveGasUsed(const CDestination& destCodeOwnerIn, const uint64 n
 {
 }
 
-void CMemVmHost::SaveRunResult(const CDestination& destContractIn, const std::vector<CTransactionLogs>& vLogsIn, const std::map<uint256, bytes>& mapCacheKv)
+void CMemVmHost::SaveRunResult(const CDestination& destContractIn, std::vector<CTransactionLogs>& vLogsIn, std::map<uint256, bytes>& mapCacheKv)
 {
 }
 
@@ -42,7 +42,7 @@ public:
     virtual bool GetContractCreateCode(const CDestination& destContractIn, CTxContractData& txcd);
     virtual CVmHostFaceDBPtr CloneHostDB(const CDestination& destContractIn);
     virtual void SaveGasUsed(const CDestination& destCodeOwnerIn, const uint64 nGasUsed);
-    virtual void SaveRunResult(const CDestination& destContractIn, const std::vector<CTransactionLogs>& vLogsIn, const std::map<uint256, bytes>& mapCacheKv);
+    virtual void SaveRunResult(const CDestination& destContractIn, std::vector<CTransactionLogs>& vLogsIn, std::map<uint256, bytes>& mapCacheKv);
     virtual bool SaveContractRunCode(const CDestination& destContractIn, const bytes& btContractRunCode, const CTxContractData& txcd);
     virtual bool ExecFunctionContract(const CDestination& destFromIn, const CDestination& destToIn, const bytes& btData, const uint64 nGasLimit, uint64& nGasLeft, bytes& btResult);
     virtual bool Selfdestruct(const CDestination& destBeneficiaryIn);
@@ -37,7 +37,8 @@ public:
     virtual bool GetContractCreateCode(const CDestination& destContractIn, CTxContractData& txcd) = 0;
     virtual CVmHostFaceDBPtr CloneHostDB(const CDestination& destContractIn) = 0;
     virtual void SaveGasUsed(const CDestination& destCodeOwner, const uint64 nGasUsed) = 0;
-    virtual void SaveRunResult(const CDestination& destContractIn, const std::vector<CTransactionLogs>& vLogsIn, const std::map<uint256, bytes>& mapCacheKv) = 0;
+    // vLogsIn and mapCacheKv are taken over by the host db and left empty
+    virtual void SaveRunResult(const CDestination& destContractIn, std::vector<CTransactionLogs>& vLogsIn, std::map<uint256, bytes>& mapCacheKv) = 0;
     virtual bool SaveContractRunCode(const CDestination& destContractIn, const bytes& btContractRunCode, const CTxContractData& txcd) = 0;
     virtual bool ExecFunctionContract(const CDestination& destFromIn, const CDestination& destToIn, const bytes& btData, const uint64 nGasLimit, uint64& nGasLeft, bytes& btResult) = 0;
     virtual bool Selfdestruct(const CDestination& destBeneficiaryIn) = 0;
@@ -19,8 +19,8 @@ namespace network
 // CBbPeer
 
 CBbPeer::CBbPeer(CPeerNet* pPeerNetIn, CIOClient* pClientIn, uint64 nNonceIn,
-                 bool fInBoundIn, uint32 nMsgMagicIn, uint32 nHsTimerIdIn)
-  : CPeer(pPeerNetIn, pClientIn, nNonceIn, fInBoundIn), nMsgMagic(nMsgMagicIn), nHsTimerId(nHsTimerIdIn), nPingTimerId(0), nPingMillisTime(0), nPingSeq(0)
+                 bool fInBoundIn, uint32 nMsgMagicIn, uint32 nHsTimerIdIn, uint32 nCompressMinSizeIn)
+  : CPeer(pPeerNetIn, pClientIn, nNonceIn, fInBoundIn), nMsgMagic(nMsgMagicIn), nHsTimerId(nHsTimerIdIn), nCompressMinSize(nCompressMinSizeIn), nPingTimerId(0), nPingMillisTime(0), nPingSeq(0)
 {
 }
 
@@ -57,11 +57,35 @@ bool CBbPeer::IsHandshaked()
 
 bool CBbPeer::SendMessage(int nChannel, int nCommand, CBufStream& ssPayload)
 {
+    if (ssPayload.GetSize() > MESSAGE_PAYLOAD_MAX_SIZE)
+    {
+        StdLog("CBbPeer", "Send Message: Payload size too large, size: %lu", ssPayload.GetSize());
+        return false;
+    }
+
+    // Handshake messages are never compressed, the peer's service flags are not known before HELLO
+    bytes btCompressed;
+    if (nChannel != PROTO_CHN_NETWORK && IsCompressEnabled() && ssPayload.GetSize() >= nCompressMinSize)
+    {
+        if (!BtCompress(ssPayload.GetData(), ssPayload.GetSize(), btCompressed) || btCompressed.size() >= ssPayload.GetSize())
+        {
+            btCompressed.clear();
+        }
+    }
+
     CPeerMessageHeader hdrSend;
     hdrSend.nMagic = nMsgMagic;
     hdrSend.nType = CPeerMessageHeader::GetMessageType(nChannel, nCommand);
-    hdrSend.nPayloadSize = ssPayload.GetSize();
-    hdrSend.nPayloadChecksum = metabasenet::crypto::CryptoHash(ssPayload.GetData(), ssPayload.GetSize()).Get32();
+    if (!btCompressed.empty())
+    {
+        hdrSend.nPayloadSize = btCompressed.size() | MESSAGE_PAYLOAD_COMPRESSED;
+        hdrSend.nPayloadChecksum = metabasenet::crypto::CryptoHash(btCompressed.data(), btCompressed.size()).Get32();
+    }
+    else
+    {
+        hdrSend.nPayloadSize = ssPayload.GetSize();
+        hdrSend.nPayloadChecksum = metabasenet::crypto::CryptoHash(ssPayload.GetData(), ssPayload.GetSize()).Get32();
+    }
     hdrSend.nHeaderChecksum = hdrSend.GetHeaderChecksum();
 
     if (!hdrSend.Verify())
@@ -71,7 +95,15 @@ bool CBbPeer::SendMessage(int nChannel, int nCommand, CBufStream& ssPayload)
     }
 
     CBufStream ss;
-    ss << hdrSend << ssPayload;
+    ss << hdrSend;
+    if (!btCompressed.empty())
+    {
+        ss.Write((char*)btCompressed.data(), btCompressed.size());
+    }
+    else
+    {
+        ss << ssPayload;
+    }
     if (!WriteStream(nChannel, ss))
     {
         StdLog("CBbPeer", "Send Message: WriteStream fail");
@@ -176,14 +208,14 @@ bool CBbPeer::ParseMessageHeader()
 
 bool CBbPeer::HandshakeReadHeader()
 {
-    if (!ParseMessageHeader())
+    if (!ParseMessageHeader() || hdrRecv.IsCompressed())
     {
         return false;
     }
 
-    if (hdrRecv.nPayloadSize != 0)
+    if (hdrRecv.GetPayloadSize() != 0)
     {
-        Read(hdrRecv.nPayloadSize, boost::bind(&CBbPeer::HandshakeReadCompleted, this));
+        Read(hdrRecv.GetPayloadSize(), boost::bind(&CBbPeer::HandshakeReadCompleted, this));
         return true;
     }
     return HandshakeReadCompleted();
@@ -196,9 +228,15 @@ bool CBbPeer::HandleReadHeader()
         return false;
     }
 
-    if (hdrRecv.nPayloadSize != 0)
+    if (hdrRecv.IsCompressed() && (!IsCompressEnabled() || hdrRecv.GetChannel() == PROTO_CHN_NETWORK))
+    {
+        StdLog("CBbPeer", "Handle Read Header: Unexpected compressed message, peer: %s", GetRemote().address().to_string().c_str());
+        return false;
+    }
+
+    if (hdrRecv.GetPayloadSize() != 0)
     {
-        Read(hdrRecv.nPayloadSize, boost::bind(&CBbPeer::HandleReadCompleted, this));
+        Read(hdrRecv.GetPayloadSize(), boost::bind(&CBbPeer::HandleReadCompleted, this));
         return true;
     }
     return HandleReadCompleted();
@@ -270,6 +308,23 @@ bool CBbPeer::HandleReadCompleted()
     {
         try
         {
+            if (hdrRecv.IsCompressed())
+            {
+                // Decompressed size is bounded by the plain payload limit
+                bytes btPayload;
+                if (!BtUncompress(ss.GetData(), ss.GetSize(), btPayload, MESSAGE_PAYLOAD_MAX_SIZE))
+                {
+                    StdLog("CBbPeer", "Handle Read Completed: Uncompress payload fail, peer: %s", GetRemote().address().to_string().c_str());
+                    return false;
+                }
+                CBufStream ssPayload(btPayload);
+                if ((dynamic_cast<CBbPeerNet*>(pPeerNet))->HandlePeerRecvMessage(this, hdrRecv.GetChannel(), hdrRecv.GetCommand(), ssPayload))
+                {
+                    Read(MESSAGE_HEADER_SIZE, boost::bind(&CBbPeer::HandleReadHeader, this));
+                    return true;
+                }
+                return false;
+            }
             if ((dynamic_cast<CBbPeerNet*>(pPeerNet))->HandlePeerRecvMessage(this, hdrRecv.GetChannel(), hdrRecv.GetCommand(), ss))
             {
                 Read(MESSAGE_HEADER_SIZE, boost::bind(&CBbPeer::HandleReadHeader, this));
@@ -20,10 +20,14 @@ class CBbPeer : public mtbase::CPeer
 {
 public:
     CBbPeer(mtbase::CPeerNet* pPeerNetIn, mtbase::CIOClient* pClientIn, uint64 nNonceIn,
-            bool fInBoundIn, uint32 nMsgMagicIn, uint32 nHsTimerIdIn);
+            bool fInBoundIn, uint32 nMsgMagicIn, uint32 nHsTimerIdIn, uint32 nCompressMinSizeIn = 0);
     ~CBbPeer();
     void Activate() override;
     bool IsHandshaked();
+    bool IsCompressEnabled() const
+    {
+        return (nCompressMinSize != 0 && (nService & NODE_COMPRESS) != 0);
+    }
     bool SendMessage(int nChannel, int nCommand, mtbase::CBufStream& ssPayload);
     bool SendMessage(int nChannel, int nCommand)
     {
@@ -65,6 +69,7 @@ public:
 protected:
     uint32 nMsgMagic;
     uint32 nHsTimerId;
+    uint32 nCompressMinSize; // 0: compression is not offered to the peer
     CPeerMessageHeader hdrRecv;
 
     std::map<CInv, uint32> mapRequest;
@@ -37,6 +37,7 @@ CBbPeerNet::CBbPeerNet()
     nVersion = 0;
     nService = 0;
     fEnclosed = false;
+    nCompressMinSize = 0;
     pNetChannel = nullptr;
     pBlockChannel = nullptr;
     pCertTxChannel = nullptr;
@@ -277,7 +278,7 @@ bool CBbPeerNet::HandleEvent(CEventPeerPublish& eventPublish)
 CPeer* CBbPeerNet::CreatePeer(CIOClient* pClient, uint64 nNonce, bool fInBound)
 {
     uint32_t nTimerId = SetTimer(nNonce, HANDSHAKE_TIMEOUT, "Handshake Timer");
-    CBbPeer* pPeer = new CBbPeer(this, pClient, nNonce, fInBound, nMagicNum, nTimerId);
+    CBbPeer* pPeer = new CBbPeer(this, pClient, nNonce, fInBound, nMagicNum, nTimerId, nCompressMinSize);
     if (pPeer == nullptr)
     {
         CancelTimer(nTimerId);
@@ -520,6 +521,8 @@ bool CBbPeerNet::HandlePeerHandshaked(CPeer* pPeer, uint32 nTimerId)
         pBbPeer->nPingTimerId = SetPingTimer(0, pBbPeer->GetNonce(), PING_TIMER_DURATION);
     }
 
+    ActivatePeer(pBbPeer);
+
     if (!fEnclosed)
     {
         pBbPeer->SendMessage(PROTO_CHN_NETWORK, PROTO_CMD_GETADDRESS);
@@ -623,6 +626,7 @@ bool CBbPeerNet::HandlePeerRecvMessage(CPeer* pPeer, int nChannel, int nCommand,
                 {
                     pBbPeer->nPingPongTimeDelta = (int)(GetTimeMillis() - pBbPeer->nPingMillisTime);
                     pBbPeer->nPingMillisTime = 0;
+                    SetPeerLatency(pBbPeer, pBbPeer->nPingPongTimeDelta);
                 }
                 pBbPeer->nPingSeq = 0;
             }
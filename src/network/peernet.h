@@ -122,7 +122,7 @@ protected:
     bool SetInvTimer(uint64 nNonce, std::vector<CInv>& vInv);
     virtual void ProcessAskFor(mtbase::CPeer* pPeer);
     void Configure(uint32 nMagicNumIn, uint32 nVersionIn, uint64 nServiceIn,
-                   const std::string& subVersionIn, bool fEnclosedIn, const uint256& hashGenesisIn)
+                   const std::string& subVersionIn, bool fEnclosedIn, const uint256& hashGenesisIn, uint32 nCompressMinSizeIn = 0)
     {
         nMagicNum = nMagicNumIn;
         nVersion = nVersionIn;
@@ -130,6 +130,11 @@ protected:
         subVersion = subVersionIn;
         fEnclosed = fEnclosedIn;
         hashGenesis = hashGenesisIn;
+        nCompressMinSize = nCompressMinSizeIn;
+        if (nCompressMinSize != 0)
+        {
+            nService |= NODE_COMPRESS;
+        }
     }
     virtual bool CheckPeerVersion(uint32 nVersionIn, uint64 nServiceIn, const std::string& subVersionIn) = 0;
     uint32 CreateSeq(uint64 nNonce);
@@ -146,6 +151,7 @@ protected:
     bool fEnclosed;
     std::string subVersion;
     uint256 hashGenesis;
+    uint32 nCompressMinSize;
     std::set<boost::asio::ip::tcp::endpoint> setDNSeed;
     uint64 nSeqCreate;
 };
@@ -19,6 +19,7 @@ enum
 {
     NODE_NETWORK = (1 << 0),
     NODE_DELEGATED = (1 << 1),
+    NODE_COMPRESS = (1 << 2),
 };
 
 enum
@@ -85,6 +86,7 @@ enum
 
 #define MESSAGE_HEADER_SIZE 16
 #define MESSAGE_PAYLOAD_MAX_SIZE 0x400000
+#define MESSAGE_PAYLOAD_COMPRESSED 0x80000000
 #define PING_TIMER_DURATION 120
 
 class CPeerMessageHeader
@@ -116,9 +118,17 @@ public:
         *(uint32*)&buf[9] = nPayloadChecksum;
         return metabasenet::crypto::crc24q(buf, 13);
     }
+    uint32 GetPayloadSize() const
+    {
+        return (nPayloadSize & ~MESSAGE_PAYLOAD_COMPRESSED);
+    }
+    bool IsCompressed() const
+    {
+        return ((nPayloadSize & MESSAGE_PAYLOAD_COMPRESSED) != 0);
+    }
     bool Verify() const
     {
-        return (nPayloadSize <= MESSAGE_PAYLOAD_MAX_SIZE && nHeaderChecksum == GetHeaderChecksum());
+        return (GetPayloadSize() <= MESSAGE_PAYLOAD_MAX_SIZE && nHeaderChecksum == GetHeaderChecksum());
     }
     static uint8 GetMessageType(int nChannel, int nCommand)
     {
@@ -108,6 +108,7 @@ bool CListFunctionAddressTrieDBWalker::Walk(const bytes& btKey, const bytes& btV
 CForkAddressDB::CForkAddressDB(const bool fCacheIn)
 {
     fCache = fCacheIn;
+    nTipAddressCount = 0;
 }
 
 CForkAddressDB::~CForkAddressDB()
@@ -129,15 +130,23 @@ bool CForkAddressDB::Initialize(const uint256& hashForkIn, const boost::filesyst
 void CForkAddressDB::Deinitialize()
 {
     dbTrie.Deinitialize();
+
+    boost::unique_lock<boost::mutex> lock(mtxTipCount);
+    hashTipBlock = 0;
+    nTipAddressCount = 0;
 }
 
 bool CForkAddressDB::RemoveAll()
 {
     dbTrie.RemoveAll();
+
+    boost::unique_lock<boost::mutex> lock(mtxTipCount);
+    hashTipBlock = 0;
+    nTipAddressCount = 0;
     return true;
 }
 
-bool CForkAddressDB::AddAddressContext(const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress, const uint64 nNewAddressCount,
+bool CForkAddressDB::AddAddressContext(const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress,
                                        const std::map<CDestination, CTimeVault>& mapTimeVault, const std::map<uint32, CFunctionAddressContext>& mapFunctionAddress, uint256& hashNewRoot)
 {
     uint256 hashPrevRoot;
@@ -193,7 +202,12 @@ bool CForkAddressDB::AddAddressContext(const uint256& hashPrevBlock, const uint2
     }
     AddPrevRoot(hashPrevRoot, hashBlock, mapKv);
 
-    if (!dbTrie.AddNewTrie(hashPrevRoot, mapKv, hashNewRoot))
+    // New addresses are counted while the trie is written, the write already finds the existing key
+    uint64 nNewAddressCount = 0;
+    if (!dbTrie.AddNewTrie(hashPrevRoot, mapKv, hashNewRoot,
+                           [&](const bytes& btKey, const bytes& btNewValue, const bytes* pbtOldValue) -> bool {
+                               return UpdateAddress(btKey, btNewValue, pbtOldValue, nNewAddressCount);
+                           }))
     {
         StdLog("CForkAddressDB", "Add Address Context: Add new trie fail, hashPrevBlock: %s, hashBlock: %s",
                hashPrevBlock.GetHex().c_str(), hashBlock.GetHex().c_str());
@@ -203,8 +217,7 @@ bool CForkAddressDB::AddAddressContext(const uint256& hashPrevBlock, const uint2
     uint64 nPrevAddressCount = 0;
     if (hashBlock != hashFork)
     {
-        uint64 nPrevNewAddressCount = 0;
-        if (!GetAddressCount(hashPrevBlock, nPrevAddressCount, nPrevNewAddressCount))
+        if (!GetPrevAddressCount(hashPrevBlock, nPrevAddressCount))
         {
             StdLog("CForkAddressDB", "Add Address Context: Get prev address count fail, hashPrevBlock: %s, hashBlock: %s",
                    hashPrevBlock.GetHex().c_str(), hashBlock.GetHex().c_str());
@@ -217,6 +230,11 @@ bool CForkAddressDB::AddAddressContext(const uint256& hashPrevBlock, const uint2
                hashPrevBlock.GetHex().c_str(), hashBlock.GetHex().c_str());
         return false;
     }
+    {
+        boost::unique_lock<boost::mutex> lock(mtxTipCount);
+        hashTipBlock = hashBlock;
+        nTipAddressCount = nPrevAddressCount + nNewAddressCount;
+    }
 
     if (!WriteTrieRoot(hashBlock, hashNewRoot))
     {
@@ -582,6 +600,48 @@ bool CForkAddressDB::AddAddressCount(const uint256& hashBlock, const uint64 nAdd
     return dbTrie.WriteExtKv(ssKey, ssValue);
 }
 
+bool CForkAddressDB::GetPrevAddressCount(const uint256& hashPrevBlock, uint64& nPrevAddressCount)
+{
+    {
+        boost::unique_lock<boost::mutex> lock(mtxTipCount);
+        if (hashTipBlock != 0 && hashTipBlock == hashPrevBlock)
+        {
+            nPrevAddressCount = nTipAddressCount;
+            return true;
+        }
+    }
+    uint64 nPrevNewAddressCount = 0;
+    return GetAddressCount(hashPrevBlock, nPrevAddressCount, nPrevNewAddressCount);
+}
+
+bool CForkAddressDB::UpdateAddress(const bytes& btKey, const bytes& btNewValue, const bytes* pbtOldValue, uint64& nNewAddressCount)
+{
+    if (btKey.empty() || btKey[0] != DB_ADDRESS_KEY_TYPE_ADDRESS)
+    {
+        return true;
+    }
+    if (pbtOldValue == nullptr)
+    {
+        nNewAddressCount++;
+        return true;
+    }
+    // If there is address data in the DB and the address type is the same, there is no need to store it again.
+    // If there is address data in the DB, but the address type is different, it needs to be re stored to change the address data.
+    try
+    {
+        CAddressContext ctxOld, ctxNew;
+        mtbase::CBufStream ssOld(*pbtOldValue), ssNew(btNewValue);
+        ssOld >> ctxOld;
+        ssNew >> ctxNew;
+        return (ctxOld.nType != ctxNew.nType);
+    }
+    catch (std::exception& e)
+    {
+        mtbase::StdError(__PRETTY_FUNCTION__, e.what());
+    }
+    return true;
+}
+
 //////////////////////////////
 // CAddressDB
 
@@ -672,7 +732,7 @@ void CAddressDB::Clear()
     }
 }
 
-bool CAddressDB::AddAddressContext(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress, const uint64 nNewAddressCount,
+bool CAddressDB::AddAddressContext(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress,
                                    const std::map<CDestination, CTimeVault>& mapTimeVault, const std::map<uint32, CFunctionAddressContext>& mapFunctionAddress, uint256& hashNewRoot)
 {
     CReadLock rlock(rwAccess);
@@ -680,7 +740,7 @@ bool CAddressDB::AddAddressContext(const uint256& hashFork, const uint256& hashP
     auto it = mapAddressDB.find(hashFork);
     if (it != mapAddressDB.end())
     {
-        return it->second->AddAddressContext(hashPrevBlock, hashBlock, mapAddress, nNewAddressCount, mapTimeVault, mapFunctionAddress, hashNewRoot);
+        return it->second->AddAddressContext(hashPrevBlock, hashBlock, mapAddress, mapTimeVault, mapFunctionAddress, hashNewRoot);
     }
     return false;
 }
@@ -52,7 +52,7 @@ public:
     void Deinitialize();
     bool RemoveAll();
 
-    bool AddAddressContext(const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress, const uint64 nNewAddressCount,
+    bool AddAddressContext(const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress,
                            const std::map<CDestination, CTimeVault>& mapTimeVault, const std::map<uint32, CFunctionAddressContext>& mapFunctionAddress, uint256& hashNewRoot);
     bool RetrieveAddressContext(const uint256& hashBlock, const CDestination& dest, CAddressContext& ctxAddress);
     bool ListContractAddress(const uint256& hashBlock, std::map<CDestination, CContractAddressContext>& mapContractAddress);
@@ -71,6 +71,8 @@ protected:
     void AddPrevRoot(const uint256& hashPrevRoot, const uint256& hashBlock, bytesmap& mapKv);
     bool GetPrevRoot(const uint256& hashRoot, uint256& hashPrevRoot, uint256& hashBlock);
     bool AddAddressCount(const uint256& hashBlock, const uint64 nAddressCount, const uint64 nNewAddressCount);
+    bool GetPrevAddressCount(const uint256& hashPrevBlock, uint64& nPrevAddressCount);
+    bool UpdateAddress(const bytes& btKey, const bytes& btNewValue, const bytes* pbtOldValue, uint64& nNewAddressCount);
 
 protected:
     enum
@@ -80,6 +82,10 @@ protected:
     bool fCache;
     uint256 hashFork;
     CTrieDB dbTrie;
+
+    boost::mutex mtxTipCount;
+    uint256 hashTipBlock;
+    uint64 nTipAddressCount;
 };
 
 class CAddressDB
@@ -96,7 +102,7 @@ public:
     bool AddNewFork(const uint256& hashFork);
     void Clear();
 
-    bool AddAddressContext(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress, const uint64 nNewAddressCount,
+    bool AddAddressContext(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress,
                            const std::map<CDestination, CTimeVault>& mapTimeVault, const std::map<uint32, CFunctionAddressContext>& mapFunctionAddress, uint256& hashNewRoot);
     bool RetrieveAddressContext(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, CAddressContext& ctxAddress);
     bool ListContractAddress(const uint256& hashFork, const uint256& hashBlock, std::map<CDestination, CContractAddressContext>& mapContractAddress);
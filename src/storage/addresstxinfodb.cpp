@@ -22,6 +22,7 @@ const uint8 DB_ADDRESS_TXINFO_KEY_TYPE_ADDRESS = 0x10;
 const uint8 DB_ADDRESS_TXINFO_KEY_TYPE_LASTDEST = 0x20;
 const uint8 DB_ADDRESS_TXINFO_KEY_TYPE_TRIEROOT = 0x30;
 const uint8 DB_ADDRESS_TXINFO_KEY_TYPE_PREVROOT = 0x40;
+const uint8 DB_ADDRESS_TXINFO_KEY_TYPE_INDEXLAST = 0x50;
 
 #define DB_ADDRESS_TXINFO_KEY_ID_PREVROOT string("prevroot")
 
@@ -296,6 +297,41 @@ bool CForkAddressTxInfoDB::VerifyAddressTxInfo(const uint256& hashPrevBlock, con
     return true;
 }
 
+bool CForkAddressTxInfoDB::ExistAddressTxInfo(const uint256& hashBlock)
+{
+    uint256 hashRoot;
+    return ReadTrieRoot(hashBlock, hashRoot);
+}
+
+bool CForkAddressTxInfoDB::WriteIndexLast(const uint256& hashBlock)
+{
+    mtbase::CBufStream ssKey, ssValue;
+    ssKey << DB_ADDRESS_TXINFO_KEY_TYPE_INDEXLAST;
+    ssValue << hashBlock;
+    return dbTrie.WriteExtKv(ssKey, ssValue);
+}
+
+bool CForkAddressTxInfoDB::ReadIndexLast(uint256& hashBlock)
+{
+    mtbase::CBufStream ssKey, ssValue;
+    ssKey << DB_ADDRESS_TXINFO_KEY_TYPE_INDEXLAST;
+    if (!dbTrie.ReadExtKv(ssKey, ssValue))
+    {
+        return false;
+    }
+
+    try
+    {
+        ssValue >> hashBlock;
+    }
+    catch (std::exception& e)
+    {
+        mtbase::StdError(__PRETTY_FUNCTION__, e.what());
+        return false;
+    }
+    return true;
+}
+
 ///////////////////////////////////
 bool CForkAddressTxInfoDB::WriteTrieRoot(const uint256& hashBlock, const uint256& hashTrieRoot)
 {
@@ -556,5 +592,41 @@ bool CAddressTxInfoDB::VerifyAddressTxInfo(const uint256& hashFork, const uint25
     return false;
 }
 
+bool CAddressTxInfoDB::ExistAddressTxInfo(const uint256& hashFork, const uint256& hashBlock)
+{
+    CReadLock rlock(rwAccess);
+
+    auto it = mapAddressTxInfoDB.find(hashFork);
+    if (it != mapAddressTxInfoDB.end())
+    {
+        return it->second->ExistAddressTxInfo(hashBlock);
+    }
+    return false;
+}
+
+bool CAddressTxInfoDB::UpdateIndexLast(const uint256& hashFork, const uint256& hashBlock)
+{
+    CReadLock rlock(rwAccess);
+
+    auto it = mapAddressTxInfoDB.find(hashFork);
+    if (it != mapAddressTxInfoDB.end())
+    {
+        return it->second->WriteIndexLast(hashBlock);
+    }
+    return false;
+}
+
+bool CAddressTxInfoDB::GetIndexLast(const uint256& hashFork, uint256& hashBlock)
+{
+    CReadLock rlock(rwAccess);
+
+    auto it = mapAddressTxInfoDB.find(hashFork);
+    if (it != mapAddressTxInfoDB.end())
+    {
+        return it->second->ReadIndexLast(hashBlock);
+    }
+    return false;
+}
+
 } // namespace storage
 } // namespace metabasenet
@@ -48,6 +48,10 @@ public:
 
     bool VerifyAddressTxInfo(const uint256& hashPrevBlock, const uint256& hashBlock, uint256& hashRoot, const bool fVerifyAllNode = true);
 
+    bool ExistAddressTxInfo(const uint256& hashBlock);
+    bool WriteIndexLast(const uint256& hashBlock);
+    bool ReadIndexLast(uint256& hashBlock);
+
 protected:
     bool WriteTrieRoot(const uint256& hashBlock, const uint256& hashTrieRoot);
     bool ReadTrieRoot(const uint256& hashBlock, uint256& hashTrieRoot);
@@ -87,6 +91,10 @@ public:
 
     bool VerifyAddressTxInfo(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock, uint256& hashRoot, const bool fVerifyAllNode = true);
 
+    bool ExistAddressTxInfo(const uint256& hashFork, const uint256& hashBlock);
+    bool UpdateIndexLast(const uint256& hashFork, const uint256& hashBlock);
+    bool GetIndexLast(const uint256& hashFork, uint256& hashBlock);
+
 protected:
     bool fCache;
     boost::filesystem::path pathAddress;
@@ -9,6 +9,7 @@
 
 #include "bloomfilter/bloomfilter.h"
 #include "delegatecomm.h"
+#include "leveldbeng.h"
 #include "mevm/evmexec.h"
 #include "mwvm/wasmrun.h"
 #include "template/delegate.h"
@@ -501,6 +502,34 @@ bool CBlockFilter::GetFilterTxids(const uint256& hashForkIn, const uint256& nFil
     return true;
 }
 
+//////////////////////////////
+// CSaveBlockStat
+
+const char* CSaveBlockStat::GetStageName(const int nStage)
+{
+    static const char* pStageName[STAGE_MAX] = {
+        "verify",
+        "write block",
+        "execute",
+        "state commit",
+        "tx index",
+        "address",
+        "code",
+        "address tx info",
+        "fork context",
+        "delegate",
+        "vote",
+        "vote reward",
+        "block index",
+        "db write"
+    };
+    if (nStage < 0 || nStage >= STAGE_MAX)
+    {
+        return "unknown";
+    }
+    return pStageName[nStage];
+}
+
 //////////////////////////////
 // CBlockState
 
@@ -508,6 +537,21 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
 {
     uint256 txid = tx.GetHash();
 
+    uint256 nTvGasFee;
+    uint256 nTvGas;
+    bool fTvGasCalculated = false;
+    CAddressContext ctxToAddress;
+    if (IsPlainTransferTx(tx, ctxToAddress))
+    {
+        CalcTxTvGas(tx, nTvGasFee, nTvGas);
+        if (tx.GetTxBaseGas() + nTvGas <= tx.GetGasLimit())
+        {
+            return AddTransferTxState(txid, tx, nTxIndex, ctxToAddress, nTvGasFee, nTvGas);
+        }
+        // Gas not enough, the general path cancels the transaction with the same tv gas
+        fTvGasCalculated = true;
+    }
+
     if (tx.GetTxType() == CTransaction::TX_VOTE_REWARD)
     {
         mapBlockRewardLocked[tx.GetToAddress()] += tx.GetAmount();
@@ -537,7 +581,7 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
             }
             CDestination dest(ptr->GetTemplateId());
 
-            if (mapBlockState.find(dest) == mapBlockState.end())
+            if (mapDestState.find(dest) == mapDestState.end())
             {
                 CDestState state;
                 if (!dbBlockBase.RetrieveDestState(hashFork, hashPrevStateRoot, dest, state))
@@ -546,7 +590,7 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
                     state.SetType(CDestination::PREFIX_TEMPLATE, ptr->GetTemplateType());
                     state.SetCodeHash(static_cast<uint256>(ptr->GetTemplateId()));
                 }
-                mapBlockState.insert(make_pair(dest, state));
+                mapDestState.insert(make_pair(dest, state));
             }
         }
         else if (nCodeType == CODE_TYPE_CONTRACT)
@@ -555,7 +599,7 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
             destTo = CreateContractAddressByNonce(tx.GetFromAddress(), tx.GetNonce());
             fToContract = true;
 
-            if (mapBlockState.find(destTo) == mapBlockState.end())
+            if (mapDestState.find(destTo) == mapDestState.end())
             {
                 CDestState state;
                 if (!dbBlockBase.RetrieveDestState(hashFork, hashPrevStateRoot, destTo, state))
@@ -563,7 +607,7 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
                     state.SetNull();
                     state.SetType(CDestination::PREFIX_CONTRACT);
                 }
-                mapBlockState.insert(make_pair(destTo, state));
+                mapDestState.insert(make_pair(destTo, state));
             }
         }
         else
@@ -588,8 +632,8 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
             fToContract = true;
         }
 
-        auto nt = mapBlockState.find(destTo);
-        if (nt == mapBlockState.end())
+        auto nt = mapDestState.find(destTo);
+        if (nt == mapDestState.end())
         {
             CDestState state;
             if (!dbBlockBase.RetrieveDestState(hashFork, hashPrevStateRoot, destTo, state))
@@ -603,9 +647,9 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
                 state.SetNull();
                 state.SetType(ctxAddress.GetDestType(), ctxAddress.GetTemplateType());
             }
-            nt = mapBlockState.insert(make_pair(destTo, state)).first;
+            nt = mapDestState.insert(make_pair(destTo, state)).first;
         }
-        if (nt != mapBlockState.end())
+        if (nt != mapDestState.end())
         {
             CDestState& state = nt->second;
             if (state.IsPubkey() && ctxAddress.IsTemplate())
@@ -617,8 +661,8 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
     }
     if (tx.GetAmount() != 0 && !destTo.IsNull())
     {
-        auto it = mapBlockState.find(destTo);
-        if (it == mapBlockState.end())
+        auto it = mapDestState.find(destTo);
+        if (it == mapDestState.end())
         {
             StdLog("CBlockState", "Add tx state: Get address state fail, txid: %s, destTo: %s",
                    txid.GetHex().c_str(), destTo.ToString().c_str());
@@ -627,13 +671,11 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
         it->second.IncBalance(tx.GetAmount());
     }
 
-    uint256 nTvGasFee;
-    uint256 nTvGas;
     uint256 nLeftGas;
     if (!tx.GetFromAddress().IsNull())
     {
-        auto mt = mapBlockState.find(tx.GetFromAddress());
-        if (mt == mapBlockState.end())
+        auto mt = mapDestState.find(tx.GetFromAddress());
+        if (mt == mapDestState.end())
         {
             CDestState state;
             if (!dbBlockBase.RetrieveDestState(hashFork, hashPrevStateRoot, tx.GetFromAddress(), state))
@@ -642,7 +684,7 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
                        txid.GetHex().c_str(), tx.GetFromAddress().ToString().c_str());
                 return false;
             }
-            mt = mapBlockState.insert(make_pair(tx.GetFromAddress(), state)).first;
+            mt = mapDestState.insert(make_pair(tx.GetFromAddress(), state)).first;
         }
         CDestState& stateFrom = mt->second;
         if (stateFrom.GetBalance() < (tx.GetAmount() + tx.GetTxFee()))
@@ -658,41 +700,9 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
         {
             stateFrom.IncTxNonce();
 
-            CAddressContext ctxFromAddress;
-            if (GetAddressContext(tx.GetFromAddress(), ctxFromAddress) && ctxFromAddress.IsPubkey())
+            if (!fTvGasCalculated)
             {
-                CTimeVault tv;
-                if (!dbBlockBase.RetrieveTimeVault(hashFork, hashPrevBlock, tx.GetFromAddress(), tv))
-                {
-                    //StdLog("CBlockState", "Add tx state: Retrieve time vault fail, from: %s, txid: %s", tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
-                    tv.SetNull();
-                }
-                nTvGasFee = tv.EstimateTransTvGasFee(nBlockTimestamp, tx.GetAmount());
-
-                uint256 nPayTvFee;
-                auto ht = mapBlockPayTvFee.find(tx.GetFromAddress());
-                if (ht != mapBlockPayTvFee.end())
-                {
-                    nPayTvFee = ht->second;
-                }
-                uint256 nSyTvFee;
-                if (tv.nTvAmount > nPayTvFee)
-                {
-                    nSyTvFee = tv.nTvAmount - nPayTvFee;
-                }
-                // StdDebug("TEST", "Add tx state: Calc prev, nTvGasFee: %s, nSyTvFee: %s, tv.nTvAmount: %s%s, nPayTvFee: %s, from: %s, txid: %s",
-                //          CoinToTokenBigFloat(nTvGasFee).c_str(), CoinToTokenBigFloat(nSyTvFee).c_str(),
-                //          (tv.fSurplus ? "" : "-"), CoinToTokenBigFloat(tv.nTvAmount).c_str(), CoinToTokenBigFloat(nPayTvFee).c_str(),
-                //          tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
-                if (nTvGasFee > nSyTvFee)
-                {
-                    nTvGasFee = nSyTvFee;
-                }
-                CTimeVault::CalcRealityTvGasFee(tx.GetGasPrice(), nTvGasFee, nTvGas);
-
-                // StdDebug("TEST", "Add tx state: Reality tv gas, nTvGasFee: %s, nTvGas: %lu, from: %s, txid: %s",
-                //          CoinToTokenBigFloat(nTvGasFee).c_str(), nTvGas.Get64(),
-                //          tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
+                CalcTxTvGas(tx, nTvGasFee, nTvGas);
             }
 
             uint256 nTxBaseGas = tx.GetTxBaseGas();
@@ -713,8 +723,8 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
 
                 if (tx.GetAmount() != 0 && !destTo.IsNull())
                 {
-                    auto it = mapBlockState.find(destTo);
-                    if (it == mapBlockState.end())
+                    auto it = mapDestState.find(destTo);
+                    if (it == mapDestState.end())
                     {
                         StdLog("CBlockState", "Add tx state: Get address state fail, txid: %s, destTo: %s",
                                txid.GetHex().c_str(), destTo.ToString().c_str());
@@ -750,9 +760,7 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
                 receipt.GetBloomDataSet(setBlockBloomData);
                 mapBlockTxReceipts.insert(std::make_pair(txid, receipt));
 
-                mtbase::CBufStream ss;
-                ss << receipt;
-                vReceiptHash.push_back(metabasenet::crypto::CryptoHash(ss.GetData(), ss.GetSize()));
+                AddReceiptData(receipt);
                 return true;
             }
         }
@@ -786,8 +794,8 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
                 // Reward transaction special transaction, when execution fails, also makes the transfer successful.
                 if (!destTo.IsNull())
                 {
-                    auto it = mapBlockState.find(destTo);
-                    if (it == mapBlockState.end())
+                    auto it = mapDestState.find(destTo);
+                    if (it == mapDestState.end())
                     {
                         StdLog("CBlockState", "Add tx state: Find to address fail, to: %s, txid: %s", destTo.ToString().c_str(), txid.GetHex().c_str());
                         return false;
@@ -796,8 +804,8 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
                 }
                 if (!tx.GetFromAddress().IsNull())
                 {
-                    auto mt = mapBlockState.find(tx.GetFromAddress());
-                    if (mt == mapBlockState.end())
+                    auto mt = mapDestState.find(tx.GetFromAddress());
+                    if (mt == mapDestState.end())
                     {
                         StdLog("CBlockState", "Add tx state: Find from address fail, from: %s, txid: %s", tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
                         return false;
@@ -818,8 +826,8 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
         uint256 nUsedFee = tx.GetGasPrice() * nUsedGas;
         if (nLeftFee > 0 && !tx.GetFromAddress().IsNull())
         {
-            auto mt = mapBlockState.find(tx.GetFromAddress());
-            if (mt == mapBlockState.end())
+            auto mt = mapDestState.find(tx.GetFromAddress());
+            if (mt == mapDestState.end())
             {
                 StdLog("CBlockState", "Add tx state: Get from state fail, from: %s, txid: %s", tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
                 return false;
@@ -845,77 +853,227 @@ bool CBlockState::AddTxState(const CTransaction& tx, const int nTxIndex)
 
     if (nTvGasFee > 0)
     {
-        nBlockFeeLeft += nTvGasFee;
+        AddTvGasFee(txid, tx.GetFromAddress(), nTvGasFee, receipt);
+    }
 
-        uint8 nDestType = CDestination::PREFIX_PUBKEY;
-        uint8 nTemplateType = 0;
-        CDestination destTimeVaultToAddress;
-        CFunctionAddressContext ctxPrevFuncAddress;
-        if (dbBlockBase.RetrieveFunctionAddress(hashPrevBlock, FUNCTION_ID_TIME_VAULT_TO_ADDRESS, ctxPrevFuncAddress))
+    receipt.CalcLogsBloom();
+    //nBlockBloom |= receipt.nLogsBloom;
+    receipt.GetBloomDataSet(setBlockBloomData);
+    mapBlockTxReceipts.insert(std::make_pair(txid, receipt));
+    AddReceiptData(receipt);
+    return true;
+}
+
+bool CBlockState::IsPlainTransferTx(const CTransaction& tx, CAddressContext& ctxToAddress)
+{
+    if (tx.GetTxType() != CTransaction::TX_TOKEN && tx.GetTxType() != CTransaction::TX_ETH_MESSAGE_CALL)
+    {
+        return false;
+    }
+    if (tx.GetFromAddress().IsNull() || tx.GetToAddress().IsNull())
+    {
+        return false;
+    }
+    if (!GetAddressContext(tx.GetToAddress(), ctxToAddress))
+    {
+        return false;
+    }
+    return ctxToAddress.IsPubkey();
+}
+
+void CBlockState::CalcTxTvGas(const CTransaction& tx, uint256& nTvGasFee, uint256& nTvGas)
+{
+    CAddressContext ctxFromAddress;
+    if (GetAddressContext(tx.GetFromAddress(), ctxFromAddress) && ctxFromAddress.IsPubkey())
+    {
+        CTimeVault tv;
+        if (!dbBlockBase.RetrieveTimeVault(hashFork, hashPrevBlock, tx.GetFromAddress(), tv))
         {
-            destTimeVaultToAddress = ctxPrevFuncAddress.GetFunctionAddress();
-            CAddressContext ctxTvAddress;
-            if (GetAddressContext(destTimeVaultToAddress, ctxTvAddress))
-            {
-                // if (ctxTvAddress.IsContract())
-                // {
-                //     CTransaction txTv;
-                //     txTv.SetTxType(CTransaction::TX_INTERNAL);
-                //     txTv.SetChainId(CBlock::GetBlockChainIdByHash(hashFork));
-                //     txTv.SetNonce((nBlockNumber << 32) | nTxIndex);
-                //     txTv.SetToAddress(destTimeVaultToAddress);
-                //     txTv.SetAmount(nTvGasFee);
-
-                //     bool fCallResult = true;
-                //     CTransactionReceipt receiptTv;
-                //     if (!AddContractState(txTv.GetHash(), txTv, 0, DEF_TX_GAS_LIMIT.Get64(), 0, fCallResult, receiptTv))
-                //     {
-                //         // Execution failure does not affect the process.
-                //         StdLog("CBlockState", "Add tx state: Add tv contract state fail, txid: %s", txid.GetHex().c_str());
-                //     }
-                //     else
-                //     {
-                //         StdDebug("CBlockState", "Add tx state: Add tv contract state success, call result: %s, txid: %s", (fCallResult ? "true" : "false"), txid.GetHex().c_str());
-                //     }
-                // }
-                nDestType = ctxTvAddress.GetDestType();
-                nTemplateType = ctxTvAddress.GetTemplateType();
-            }
+            //StdLog("CBlockState", "Add tx state: Retrieve time vault fail, from: %s, txid: %s", tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
+            tv.SetNull();
         }
-        else
+        nTvGasFee = tv.EstimateTransTvGasFee(nBlockTimestamp, tx.GetAmount());
+
+        uint256 nPayTvFee;
+        auto ht = mapBlockPayTvFee.find(tx.GetFromAddress());
+        if (ht != mapBlockPayTvFee.end())
+        {
+            nPayTvFee = ht->second;
+        }
+        uint256 nSyTvFee;
+        if (tv.nTvAmount > nPayTvFee)
+        {
+            nSyTvFee = tv.nTvAmount - nPayTvFee;
+        }
+        // StdDebug("TEST", "Add tx state: Calc prev, nTvGasFee: %s, nSyTvFee: %s, tv.nTvAmount: %s%s, nPayTvFee: %s, from: %s, txid: %s",
+        //          CoinToTokenBigFloat(nTvGasFee).c_str(), CoinToTokenBigFloat(nSyTvFee).c_str(),
+        //          (tv.fSurplus ? "" : "-"), CoinToTokenBigFloat(tv.nTvAmount).c_str(), CoinToTokenBigFloat(nPayTvFee).c_str(),
+        //          tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
+        if (nTvGasFee > nSyTvFee)
+        {
+            nTvGasFee = nSyTvFee;
+        }
+        CTimeVault::CalcRealityTvGasFee(tx.GetGasPrice(), nTvGasFee, nTvGas);
+
+        // StdDebug("TEST", "Add tx state: Reality tv gas, nTvGasFee: %s, nTvGas: %lu, from: %s, txid: %s",
+        //          CoinToTokenBigFloat(nTvGasFee).c_str(), nTvGas.Get64(),
+        //          tx.GetFromAddress().ToString().c_str(), txid.GetHex().c_str());
+    }
+}
+
+bool CBlockState::AddTransferTxState(const uint256& txid, const CTransaction& tx, const int nTxIndex, const CAddressContext& ctxToAddress, const uint256& nTvGasFee, const uint256& nTvGas)
+{
+    const CDestination& destFrom = tx.GetFromAddress();
+    const CDestination& destTo = tx.GetToAddress();
+
+    auto nt = mapDestState.find(destTo);
+    if (nt == mapDestState.end())
+    {
+        CDestState state;
+        if (!dbBlockBase.RetrieveDestState(hashFork, hashPrevStateRoot, destTo, state))
         {
-            destTimeVaultToAddress = TIME_VAULT_TO_ADDRESS;
+            state.SetNull();
+            state.SetType(ctxToAddress.GetDestType(), ctxToAddress.GetTemplateType());
         }
+        nt = mapDestState.insert(make_pair(destTo, state)).first;
+    }
+    if (tx.GetAmount() != 0)
+    {
+        nt->second.IncBalance(tx.GetAmount());
+    }
 
-        CDestState stateTvOwner;
-        if (!GetDestState(destTimeVaultToAddress, stateTvOwner))
+    auto mt = mapDestState.find(destFrom);
+    if (mt == mapDestState.end())
+    {
+        CDestState state;
+        if (!dbBlockBase.RetrieveDestState(hashFork, hashPrevStateRoot, destFrom, state))
         {
-            stateTvOwner.SetNull();
-            stateTvOwner.SetType(nDestType, nTemplateType);
+            StdLog("CBlockState", "Add transfer tx state: Retrieve dest state fail, txid: %s, from: %s",
+                   txid.GetHex().c_str(), destFrom.ToString().c_str());
+            return false;
         }
-        stateTvOwner.IncBalance(nTvGasFee);
-        SetDestState(destTimeVaultToAddress, stateTvOwner);
+        mt = mapDestState.insert(make_pair(destFrom, state)).first;
+    }
+    CDestState& stateFrom = mt->second;
+    if (stateFrom.GetBalance() < (tx.GetAmount() + tx.GetTxFee()))
+    {
+        StdLog("CBlockState", "Add transfer tx state: From dest balance error, nBalance: %s, nAmount+Fee: %s, txid: %s, from: %s",
+               CoinToTokenBigFloat(stateFrom.GetBalance()).c_str(), CoinToTokenBigFloat(tx.GetAmount() + tx.GetTxFee()).c_str(),
+               txid.GetHex().c_str(), destFrom.ToString().c_str());
+        return false;
+    }
+    stateFrom.DecBalance(tx.GetAmount() + tx.GetTxFee());
+    stateFrom.IncTxNonce();
 
-        mapBlockPayTvFee[tx.GetFromAddress()] += nTvGasFee;
+    uint256 nUsedGas = tx.GetTxBaseGas() + nTvGas;
+    uint256 nLeftFee = tx.GetGasPrice() * (tx.GetGasLimit() - nUsedGas);
+    uint256 nUsedFee = tx.GetGasPrice() * nUsedGas;
+    if (nLeftFee > 0)
+    {
+        stateFrom.IncBalance(nLeftFee);
+    }
+    mapBlockTxFeeUsed[txid] = nUsedFee;
+    nSurplusBlockGasLimit -= nUsedGas.Get64();
+    nBlockFeeLeft += nLeftFee;
 
-        CContractTransfer ctrTransfer(CContractTransfer::CT_TIMEVAULT, tx.GetFromAddress(), destTimeVaultToAddress, nTvGasFee);
-        mapBlockContractTransfer[txid].push_back(ctrTransfer);
-        receipt.vTransfer.push_back(ctrTransfer);
+    // A transfer receipt has no logs, so its bloom stays empty
+    CTransactionReceipt receipt;
+    receipt.nReceiptType = CTransactionReceipt::RECEIPT_TYPE_COMMON;
+    receipt.nTxIndex = nTxIndex;
+    receipt.txid = txid;
+    receipt.nBlockNumber = nBlockNumber;
+    receipt.from = destFrom;
+    receipt.to = destTo;
+    receipt.nTxGasUsed = nUsedGas;
+    receipt.nTvGasUsed = nTvGas;
+    receipt.nEffectiveGasPrice = tx.GetGasPrice();
+
+    if (nTvGasFee > 0)
+    {
+        AddTvGasFee(txid, destFrom, nTvGasFee, receipt);
     }
 
-    receipt.CalcLogsBloom();
-    //nBlockBloom |= receipt.nLogsBloom;
-    receipt.GetBloomDataSet(setBlockBloomData);
     mapBlockTxReceipts.insert(std::make_pair(txid, receipt));
+    AddReceiptData(receipt);
+    return true;
+}
+
+void CBlockState::AddTvGasFee(const uint256& txid, const CDestination& destFrom, const uint256& nTvGasFee, CTransactionReceipt& receipt)
+{
+    nBlockFeeLeft += nTvGasFee;
+
+    if (!fCacheTvToAddress)
+    {
+        // The function address is read at the previous block, so it is fixed for the whole block
+        CFunctionAddressContext ctxPrevFuncAddress;
+        fCacheTvToFunctionAddress = dbBlockBase.RetrieveFunctionAddress(hashPrevBlock, FUNCTION_ID_TIME_VAULT_TO_ADDRESS, ctxPrevFuncAddress);
+        destCacheTvToAddress = (fCacheTvToFunctionAddress ? ctxPrevFuncAddress.GetFunctionAddress() : TIME_VAULT_TO_ADDRESS);
+        fCacheTvToAddress = true;
+    }
+
+    uint8 nDestType = CDestination::PREFIX_PUBKEY;
+    uint8 nTemplateType = 0;
+    const CDestination& destTimeVaultToAddress = destCacheTvToAddress;
+    if (fCacheTvToFunctionAddress)
+    {
+        CAddressContext ctxTvAddress;
+        if (GetAddressContext(destTimeVaultToAddress, ctxTvAddress))
+        {
+            // if (ctxTvAddress.IsContract())
+            // {
+            //     CTransaction txTv;
+            //     txTv.SetTxType(CTransaction::TX_INTERNAL);
+            //     txTv.SetChainId(CBlock::GetBlockChainIdByHash(hashFork));
+            //     txTv.SetNonce((nBlockNumber << 32) | nTxIndex);
+            //     txTv.SetToAddress(destTimeVaultToAddress);
+            //     txTv.SetAmount(nTvGasFee);
+
+            //     bool fCallResult = true;
+            //     CTransactionReceipt receiptTv;
+            //     if (!AddContractState(txTv.GetHash(), txTv, 0, DEF_TX_GAS_LIMIT.Get64(), 0, fCallResult, receiptTv))
+            //     {
+            //         // Execution failure does not affect the process.
+            //         StdLog("CBlockState", "Add tx state: Add tv contract state fail, txid: %s", txid.GetHex().c_str());
+            //     }
+            //     else
+            //     {
+            //         StdDebug("CBlockState", "Add tx state: Add tv contract state success, call result: %s, txid: %s", (fCallResult ? "true" : "false"), txid.GetHex().c_str());
+            //     }
+            // }
+            nDestType = ctxTvAddress.GetDestType();
+            nTemplateType = ctxTvAddress.GetTemplateType();
+        }
+    }
+
+    CDestState stateTvOwner;
+    if (!GetDestState(destTimeVaultToAddress, stateTvOwner))
+    {
+        stateTvOwner.SetNull();
+        stateTvOwner.SetType(nDestType, nTemplateType);
+    }
+    stateTvOwner.IncBalance(nTvGasFee);
+    SetDestState(destTimeVaultToAddress, stateTvOwner);
+
+    mapBlockPayTvFee[destFrom] += nTvGasFee;
+
+    CContractTransfer ctrTransfer(CContractTransfer::CT_TIMEVAULT, destFrom, destTimeVaultToAddress, nTvGasFee);
+    mapBlockContractTransfer[txid].push_back(ctrTransfer);
+    receipt.vTransfer.push_back(ctrTransfer);
+}
+
+void CBlockState::AddReceiptData(const CTransactionReceipt& receipt)
+{
+    // Receipts are hashed together when the block state is done, so large blocks can hash them in parallel
     mtbase::CBufStream ss;
     ss << receipt;
-    vReceiptHash.push_back(metabasenet::crypto::CryptoHash(ss.GetData(), ss.GetSize()));
-    return true;
+    vReceiptData.push_back(bytes());
+    ss.GetData(vReceiptData.back());
 }
 
 bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed, bytes& btBlockBloomDataOut, uint256& nTotalMintRewardOut)
 {
     nBlockGasUsed = uint256(nOriBlockGasLimit - nSurplusBlockGasLimit);
+    CMerkleTree::CalcDataHashList(vReceiptData, vReceiptHash);
     hashReceiptRoot = CReceiptMerkleTree::BuildMerkleTree(vReceiptHash);
 
     if (nOriginalBlockMintReward < nBlockFeeLeft)
@@ -928,8 +1086,8 @@ bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed,
 
     if (nBlockType == CBlock::BLOCK_GENESIS || nBlockType == CBlock::BLOCK_ORIGIN)
     {
-        auto nt = mapBlockState.find(destMint);
-        if (nt == mapBlockState.end())
+        auto nt = mapDestState.find(destMint);
+        if (nt == mapDestState.end())
         {
             CDestState state;
             if (!dbBlockBase.RetrieveDestState(hashFork, hashPrevStateRoot, destMint, state))
@@ -944,7 +1102,7 @@ bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed,
                 state.SetNull();
                 state.SetType(ctxAddress.GetDestType(), ctxAddress.GetTemplateType());
             }
-            nt = mapBlockState.insert(make_pair(destMint, state)).first;
+            nt = mapDestState.insert(make_pair(destMint, state)).first;
         }
         nt->second.IncBalance(nOriginalBlockMintReward);
     }
@@ -1077,9 +1235,7 @@ bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed,
                 //nBlockBloom |= receipt.nLogsBloom;
                 receipt.GetBloomDataSet(setBlockBloomData);
                 mapBlockTxReceipts.insert(std::make_pair(txidMint, receipt));
-                mtbase::CBufStream ss;
-                ss << receipt;
-                vReceiptHash.push_back(metabasenet::crypto::CryptoHash(ss.GetData(), ss.GetSize()));
+                AddReceiptData(receipt);
             }
 
             // When redeeming pledge, give timevault
@@ -1090,7 +1246,7 @@ bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed,
         }
     }
 
-    for (const auto& kv : mapContractKvState)
+    for (auto& kv : mapContractKvState)
     {
         const CDestination& destContract = kv.first;
         CDestState stateDestContract;
@@ -1099,8 +1255,13 @@ bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed,
             stateDestContract.SetNull();
             stateDestContract.SetType(CDestination::PREFIX_PUBKEY); // WAIT_CHECK
         }
+        std::map<uint256, bytes> mapContractState;
+        for (auto& vd : kv.second)
+        {
+            mapContractState[vd.first].swap(vd.second);
+        }
         uint256 hashRoot;
-        if (!dbBlockBase.AddBlockContractKvValue(hashFork, stateDestContract.GetStorageRoot(), hashRoot, kv.second))
+        if (!dbBlockBase.AddBlockContractKvValue(hashFork, stateDestContract.GetStorageRoot(), hashRoot, mapContractState))
         {
             StdLog("CBlockState", "Do block state: Add block contract state fail, destContract: %s", destContract.ToString().c_str());
             return false;
@@ -1111,7 +1272,7 @@ bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed,
 
     for (auto& kv : mapBlockAddressContext)
     {
-        setBlockBloomData.insert(kv.first.GetBytes());
+        setBlockBloomData.Insert(kv.first);
     }
     for (auto& kv : mapBlockContractTransfer)
     {
@@ -1119,16 +1280,18 @@ bool CBlockState::DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed,
         {
             if (!vd.destFrom.IsNull())
             {
-                setBlockBloomData.insert(vd.destFrom.GetBytes());
+                setBlockBloomData.Insert(vd.destFrom);
             }
             if (!vd.destTo.IsNull())
             {
-                setBlockBloomData.insert(vd.destTo.GetBytes());
+                setBlockBloomData.Insert(vd.destTo);
             }
         }
     }
 
     GetBlockBloomData(btBlockBloomDataOut);
+
+    mapBlockState.insert(mapDestState.begin(), mapDestState.end());
     return true;
 }
 
@@ -1140,8 +1303,8 @@ bool CBlockState::GetDestState(const CDestination& dest, CDestState& stateDest)
         stateDest = mt->second.cacheDestState;
         return true;
     }
-    auto it = mapBlockState.find(dest);
-    if (it != mapBlockState.end())
+    auto it = mapDestState.find(dest);
+    if (it != mapDestState.end())
     {
         stateDest = it->second;
         return true;
@@ -1151,7 +1314,7 @@ bool CBlockState::GetDestState(const CDestination& dest, CDestState& stateDest)
 
 void CBlockState::SetDestState(const CDestination& dest, const CDestState& stateDest)
 {
-    mapBlockState[dest] = stateDest;
+    mapDestState[dest] = stateDest;
 }
 
 void CBlockState::SetCacheDestState(const CDestination& dest, const CDestState& stateDest)
@@ -1303,15 +1466,7 @@ bool CBlockState::GetBlockHashByNumber(const uint64 nBlockNumberIn, uint256& has
 
 void CBlockState::GetBlockBloomData(bytes& btBloomDataOut)
 {
-    if (!setBlockBloomData.empty())
-    {
-        CNhBloomFilter bf(setBlockBloomData.size() * 4);
-        for (auto& bt : setBlockBloomData)
-        {
-            bf.Add(bt);
-        }
-        bf.GetData(btBloomDataOut);
-    }
+    setBlockBloomData.GetBloomData(btBloomDataOut);
 }
 
 bool CBlockState::GetDestBalance(const CDestination& dest, uint256& nBalance)
@@ -1424,7 +1579,7 @@ void CBlockState::SaveGasUsed(const CDestination& destCodeOwner, const uint64 nG
     }
 }
 
-void CBlockState::SaveRunResult(const CDestination& destContractIn, const std::vector<CTransactionLogs>& vLogsIn, const std::map<uint256, bytes>& mapCacheKv)
+void CBlockState::SaveRunResult(const CDestination& destContractIn, std::vector<CTransactionLogs>& vLogsIn, std::map<uint256, bytes>& mapCacheKv)
 {
     auto& cacheContract = mapCacheContractData[destContractIn];
 
@@ -1434,14 +1589,32 @@ void CBlockState::SaveRunResult(const CDestination& destContractIn, const std::v
     //     cacheContract.cacheDestState = stateContractDest;
     // }
 
-    for (auto& kv : mapCacheKv)
+    // Take over the frame's kv and logs instead of copying them, the frame drops them after saving
+    if (cacheContract.cacheContractKv.empty())
     {
-        cacheContract.cacheContractKv[kv.first] = kv.second;
+        cacheContract.cacheContractKv.swap(mapCacheKv);
     }
-    for (auto& logs : vLogsIn)
+    else
     {
-        cacheContract.cacheContractLogs.push_back(logs);
+        for (auto& kv : mapCacheKv)
+        {
+            cacheContract.cacheContractKv[kv.first].swap(kv.second);
+        }
     }
+    if (cacheContract.cacheContractLogs.empty())
+    {
+        cacheContract.cacheContractLogs.swap(vLogsIn);
+    }
+    else
+    {
+        cacheContract.cacheContractLogs.reserve(cacheContract.cacheContractLogs.size() + vLogsIn.size());
+        for (auto& logs : vLogsIn)
+        {
+            cacheContract.cacheContractLogs.push_back(std::move(logs));
+        }
+    }
+    mapCacheKv.clear();
+    vLogsIn.clear();
 
     if (mapCacheAddressContext.find(destContractIn) == mapCacheAddressContext.end())
     {
@@ -1735,14 +1908,7 @@ bool CBlockState::GetDestContractCode(const CTransaction& tx, CDestination& dest
 
 bool CBlockState::AddContractState(const uint256& txid, const CTransaction& tx, const int nTxIndex, const uint64 nRunGasLimit, const uint256& nTvGasUsedIn, bool& fCallResult, CTransactionReceipt& receipt)
 {
-    mapCacheContractData.clear();
-    mapCacheAddressContext.clear();
-    mapCacheContractCreateCodeContext.clear();
-    mapCacheContractRunCodeContext.clear();
-    vCacheContractTransfer.clear();
-    mapCacheCodeDestGasUsed.clear();
-    mapCacheModifyPledgeFinalHeight.clear();
-    mapCacheFunctionAddress.clear();
+    ClearCacheContractData();
 
     fCallResult = true;
     if (isFunctionContractAddress(tx.GetToAddress()))
@@ -1800,14 +1966,7 @@ bool CBlockState::AddContractState(const uint256& txid, const CTransaction& tx,
                                                nBlockHeight, nSurplusBlockGasLimit, btContractCode, btRunParam, txcd)))
             {
                 StdLog("CBlockState", "Add contract state: Evm exec fail, txid: %s", txid.ToString().c_str());
-                mapCacheContractData.clear();
-                mapCacheAddressContext.clear();
-                mapCacheContractCreateCodeContext.clear();
-                mapCacheContractRunCodeContext.clear();
-                vCacheContractTransfer.clear();
-                mapCacheCodeDestGasUsed.clear();
-                mapCacheModifyPledgeFinalHeight.clear();
-                mapCacheFunctionAddress.clear();
+                ClearCacheContractData();
             }
             uint64 nSetGasLeft = vmExec.nGasLeft;
             uint256 nSetTvGasUsed = nTvGasUsedIn;
@@ -1860,9 +2019,7 @@ bool CBlockState::AddContractState(const uint256& txid, const CTransaction& tx,
     return true;
 }
 
-bool CBlockState::DoRunResult(const uint256& txid, const CTransaction& tx, const int nTxIndex, const CDestination& destContract,
-                              const uint256& hashContractCreateCode, const uint64 nGasLeftIn, const uint256& nTvGasUsedIn,
-                              const int nStatusCode, const bytes& vResult, CTransactionReceipt& receipt)
+void CBlockState::ApplyCacheContractData(CTransactionReceipt& receipt)
 {
     for (const auto& vd : mapCacheContractData)
     {
@@ -1884,6 +2041,26 @@ bool CBlockState::DoRunResult(const uint256& txid, const CTransaction& tx, const
             receipt.vLogs.push_back(logs);
         }
     }
+}
+
+void CBlockState::ClearCacheContractData()
+{
+    mapCacheContractData.clear();
+    mapCacheAddressContext.clear();
+    mapCacheContractCreateCodeContext.clear();
+    mapCacheContractRunCodeContext.clear();
+    vCacheContractTransfer.clear();
+    mapCacheCodeDestGasUsed.clear();
+    mapCacheModifyPledgeFinalHeight.clear();
+    mapCacheFunctionAddress.clear();
+    arenaTx.Reset();
+}
+
+bool CBlockState::DoRunResult(const uint256& txid, const CTransaction& tx, const int nTxIndex, const CDestination& destContract,
+                              const uint256& hashContractCreateCode, const uint64 nGasLeftIn, const uint256& nTvGasUsedIn,
+                              const int nStatusCode, const bytes& vResult, CTransactionReceipt& receipt)
+{
+    ApplyCacheContractData(receipt);
     for (const auto& kv : mapCacheAddressContext)
     {
         mapBlockAddressContext[kv.first] = kv.second;
@@ -1949,14 +2126,7 @@ bool CBlockState::DoRunResult(const uint256& txid, const CTransaction& tx, const
         mapBlockFunctionAddress[kv.first] = kv.second;
     }
 
-    mapCacheContractData.clear();
-    mapCacheAddressContext.clear();
-    mapCacheContractCreateCodeContext.clear();
-    mapCacheContractRunCodeContext.clear();
-    vCacheContractTransfer.clear();
-    mapCacheCodeDestGasUsed.clear();
-    mapCacheModifyPledgeFinalHeight.clear();
-    mapCacheFunctionAddress.clear();
+    ClearCacheContractData();
 
     uint256 nTxGasUsed;
     if (!tx.GetFromAddress().IsNull() && tx.GetGasLimit() > 0 && tx.GetGasLimit() > nGasLeftIn)
@@ -2163,14 +2333,7 @@ bool CBlockState::DoFunctionContractTx(const uint256& txid, const CTransaction&
         mapBlockFunctionAddress[kv.first] = kv.second;
     }
 
-    mapCacheContractData.clear();
-    mapCacheAddressContext.clear();
-    mapCacheContractCreateCodeContext.clear();
-    mapCacheContractRunCodeContext.clear();
-    vCacheContractTransfer.clear();
-    mapCacheCodeDestGasUsed.clear();
-    mapCacheModifyPledgeFinalHeight.clear();
-    mapCacheFunctionAddress.clear();
+    ClearCacheContractData();
 
     uint256 nTxGasUsed;
     if (tx.GetGasLimit() > nGasLeft)
@@ -3374,7 +3537,7 @@ void CContractHostDB::SaveGasUsed(const CDestination& destCodeOwnerIn, const uin
     blockState.SaveGasUsed(destCodeOwnerIn, nGasUsed);
 }
 
-void CContractHostDB::SaveRunResult(const CDestination& destContractIn, const std::vector<CTransactionLogs>& vLogsIn, const std::map<uint256, bytes>& mapCacheKv)
+void CContractHostDB::SaveRunResult(const CDestination& destContractIn, std::vector<CTransactionLogs>& vLogsIn, std::map<uint256, bytes>& mapCacheKv)
 {
     blockState.SaveRunResult(destContractIn, vLogsIn, mapCacheKv);
 }
@@ -3383,7 +3546,7 @@ void CContractHostDB::SaveRunResult(const CDestination& destContractIn, const st
 // CBlockBase
 
 CBlockBase::CBlockBase()
-  : fCfgFullDb(false), fCfgRewardCheck(false)
+  : fCfgFullDb(false), fCfgFullDbAsync(false), fCfgRewardCheck(false), nCfgCheckLevel(0), cacheBlockForkCreated(MAX_CACHE_BLOCK_FORK_CREATED)
 {
 }
 
@@ -3393,11 +3556,13 @@ CBlockBase::~CBlockBase()
     tsBlock.Deinitialize();
 }
 
-bool CBlockBase::Initialize(const path& pathDataLocation, const uint256& hashGenesisBlockIn, const bool fFullDbIn, const bool fRewardCheckIn, const bool fRenewDB)
+bool CBlockBase::Initialize(const path& pathDataLocation, const uint256& hashGenesisBlockIn, const bool fFullDbIn, const bool fFullDbAsyncIn, const bool fRewardCheckIn, const int nCheckLevelIn, const bool fRenewDB)
 {
     hashGenesisBlock = hashGenesisBlockIn;
     fCfgFullDb = fFullDbIn;
+    fCfgFullDbAsync = fFullDbAsyncIn;
     fCfgRewardCheck = fRewardCheckIn;
+    nCfgCheckLevel = nCheckLevelIn;
 
     StdLog("BlockBase", "Initializing... (Path : %s)", pathDataLocation.string().c_str());
 
@@ -3443,9 +3608,139 @@ void CBlockBase::Deinitialize()
 
         ClearCache();
     }
+    {
+        boost::unique_lock<boost::mutex> lock(mtxCacheBlockState);
+        mapCacheBlockState.clear();
+    }
+    cacheBlockForkCreated.Clear();
     StdLog("BlockBase", "Deinitialized");
 }
 
+void CBlockBase::WarmupCache()
+{
+    int64 nBeginTime = GetTimeMillis();
+
+    // Block import reads the state trie of each fork's last block first
+    std::vector<std::pair<uint256, uint256>> vForkStateRoot;
+    {
+        CReadLock rlock(rwAccess);
+
+        std::map<uint256, CForkContext> mapForkCtxt;
+        if (dbBlock.ListForkContext(mapForkCtxt))
+        {
+            for (const auto& kv : mapForkCtxt)
+            {
+                CBlockIndex* pIndex = GetForkLastIndex(kv.first);
+                if (pIndex != nullptr)
+                {
+                    vForkStateRoot.push_back(std::make_pair(kv.first, pIndex->hashStateRoot));
+                }
+            }
+        }
+    }
+    std::size_t nStateNodeCount = 0;
+    for (const auto& vd : vForkStateRoot)
+    {
+        nStateNodeCount += dbBlock.PrefetchState(vd.first, vd.second, WARMUP_STATE_NODE_COUNT);
+    }
+
+    // Then the blocks that were read most before the last shutdown, hottest first until the block cache is full
+    std::vector<CDiskPos> vHotPos;
+    tsBlock.GetHotSet(vHotPos);
+    std::size_t nBlockCount = 0;
+    for (const CDiskPos& pos : vHotPos)
+    {
+        boost::this_thread::interruption_point();
+
+        CBlockEx block;
+        bool fCacheFull = false;
+        if (tsBlock.ReadWarmup(block, pos, fCacheFull))
+        {
+            if (fCacheFull)
+            {
+                break;
+            }
+            nBlockCount++;
+        }
+    }
+
+    StdLog("BlockBase", "Warmup cache: fork: %lu, state node: %lu, block: %lu/%lu, time: %ld ms",
+           vForkStateRoot.size(), nStateNodeCount, nBlockCount, vHotPos.size(), GetTimeMillis() - nBeginTime);
+}
+
+bool CBlockBase::CatchUpAddressTxInfo(const std::size_t nMaxCount, std::size_t& nIndexCount)
+{
+    nIndexCount = 0;
+    if (!fCfgFullDb)
+    {
+        return true;
+    }
+
+    std::map<uint256, CForkContext> mapForkCtxt;
+    if (!dbBlock.ListForkContext(mapForkCtxt))
+    {
+        StdLog("BlockBase", "Catch up address tx info: List fork context fail");
+        return false;
+    }
+    for (const auto& kv : mapForkCtxt)
+    {
+        const uint256& hashFork = kv.first;
+        std::vector<const CBlockIndex*> vIndex;
+        {
+            CReadLock rlock(rwAccess);
+
+            CBlockIndex* pIndexLast = GetForkLastIndex(hashFork);
+            if (pIndexLast == nullptr)
+            {
+                continue;
+            }
+
+            // Resume after the saved progress, stepping back to the main chain if it was switched
+            CBlockIndex* pIndex = nullptr;
+            uint256 hashIndexLast;
+            if (dbBlock.GetAddressTxInfoIndexLast(hashFork, hashIndexLast))
+            {
+                pIndex = GetIndex(hashIndexLast);
+            }
+            while (pIndex != nullptr && pIndex != pIndexLast && pIndex->pNext == nullptr)
+            {
+                pIndex = (pIndex->IsOrigin() ? nullptr : pIndex->pPrev);
+            }
+
+            const CBlockIndex* pIndexNext = (pIndex == nullptr ? pIndexLast->pOrigin : pIndex->pNext);
+            while (pIndexNext != nullptr && vIndex.size() < nMaxCount)
+            {
+                vIndex.push_back(pIndexNext);
+                pIndexNext = pIndexNext->pNext;
+            }
+        }
+
+        for (const CBlockIndex* pIndex : vIndex)
+        {
+            boost::this_thread::interruption_point();
+
+            const uint256 hashBlock = pIndex->GetBlockHash();
+            if (!dbBlock.ExistAddressTxInfo(hashFork, hashBlock))
+            {
+                if (!IndexBlockAddressTxInfo(hashFork, pIndex))
+                {
+                    StdLog("BlockBase", "Catch up address tx info: Index block fail, block: %s, fork: %s",
+                           hashBlock.GetHex().c_str(), hashFork.GetHex().c_str());
+                    return false;
+                }
+                nIndexCount++;
+            }
+            if (!dbBlock.UpdateAddressTxInfoIndexLast(hashFork, hashBlock))
+            {
+                StdLog("BlockBase", "Catch up address tx info: Update index last fail, block: %s, fork: %s",
+                       hashBlock.GetHex().c_str(), hashFork.GetHex().c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 const uint256& CBlockBase::GetGenesisBlockHash() const
 {
     return hashGenesisBlock;
@@ -3545,6 +3840,11 @@ bool CBlockBase::StorageNewBlock(const uint256& hashFork, const uint256& hashBlo
             return false;
         }
 
+        if (hashFork == GetGenesisBlockHash())
+        {
+            GetBlockForkDelta(update);
+        }
+
         StdLog("CBlockChain", "Storage new block: Long chain, type: %s, time: %s, txs: %lu, block: [%lu-%u-%u] %s, chain trust: %s, fork: [%lu] %s",
                GetBlockTypeStr(block.nType, block.txMint.GetTxType()).c_str(), GetTimeString(block.GetBlockTime()).c_str(), block.vtx.size(), pIndexNew->GetBlockNumber(),
                pIndexNew->GetBlockHeight(), pIndexNew->GetBlockSlot(), hashBlock.GetHex().c_str(), pIndexNew->nChainTrust.GetValueHex().c_str(), pIndexNew->nChainId, pIndexNew->GetOriginHash().GetHex().c_str());
@@ -3554,6 +3854,7 @@ bool CBlockBase::StorageNewBlock(const uint256& hashFork, const uint256& hashBlo
 
 bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, const CBlockEx& block, CBlockIndex** ppIndexNew, CBlockRoot& blockRoot, const bool fRepair)
 {
+    const int64 nDbWriteTicks = CLevelDBEngine::GetThreadWriteTicks();
     uint32 nFile, nOffset, nCrc;
     CBlockVerify verifyBlock;
     if (dbBlock.RetrieveBlockVerify(hashBlock, verifyBlock))
@@ -3564,11 +3865,13 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
     }
     else
     {
+        CTicks tWrite;
         if (!tsBlock.Write(block, nFile, nOffset, nCrc))
         {
             StdError("BlockBase", "Save block: Write block failed, block: %s", hashBlock.ToString().c_str());
             return false;
         }
+        AddSaveBlockStage(CSaveBlockStat::STAGE_WRITE_BLOCK, tWrite.Elapse());
     }
 
     if (block.IsOrigin())
@@ -3617,13 +3920,16 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
             break;
         }
 
+        CTicks tStage;
         if (!UpdateBlockTxIndex(hashFork, block, nFile, nOffset, ptrBlockStateOut->mapBlockTxReceipts, blockRoot.hashTxIndexRoot))
         {
             StdError("BlockBase", "Save block: Update block tx index failed, block: %s", hashBlock.ToString().c_str());
             fRet = false;
             break;
         }
+        AddSaveBlockStage(CSaveBlockStat::STAGE_TX_INDEX, tStage.Elapse());
 
+        tStage = CTicks();
         if (!UpdateBlockAddress(hashFork, hashBlock, block, ptrBlockStateOut->mapBlockAddressContext, ptrBlockStateOut->mapBlockState,
                                 ptrBlockStateOut->mapBlockPayTvFee, ptrBlockStateOut->mapBlockFunctionAddress, blockRoot.hashAddressRoot))
         {
@@ -3631,7 +3937,9 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
             fRet = false;
             break;
         }
+        AddSaveBlockStage(CSaveBlockStat::STAGE_ADDRESS, tStage.Elapse());
 
+        tStage = CTicks();
         if (!UpdateBlockCode(hashFork, hashBlock, block, nFile, nOffset, ptrBlockStateOut->mapBlockContractCreateCodeContext,
                              ptrBlockStateOut->mapBlockContractRunCodeContext, ptrBlockStateOut->mapBlockAddressContext, blockRoot.hashCodeRoot))
         {
@@ -3639,10 +3947,18 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
             fRet = false;
             break;
         }
+        AddSaveBlockStage(CSaveBlockStat::STAGE_CODE, tStage.Elapse());
 
-        if (fCfgFullDb)
+        // The address tx info of a block extends its parent's, if the parent is not indexed yet
+        // (async mode, or fulldb just enabled) the background indexer adds this block later
+        if (fCfgFullDb && (fCfgFullDbAsync || (!block.IsOrigin() && !dbBlock.ExistAddressTxInfo(hashFork, block.hashPrev))))
+        {
+            AddCacheBlockState(hashFork, hashBlock, ptrBlockStateOut);
+        }
+        else if (fCfgFullDb)
         {
             uint256 hashAddressTxInfoRoot;
+            tStage = CTicks();
             if (!UpdateBlockAddressTxInfo(hashFork, hashBlock, block, ptrBlockStateOut->mapBlockContractTransfer,
                                           ptrBlockStateOut->mapBlockTxFeeUsed, ptrBlockStateOut->mapBlockCodeDestFeeUsed, hashAddressTxInfoRoot))
             {
@@ -3650,17 +3966,21 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
                 fRet = false;
                 break;
             }
+            AddSaveBlockStage(CSaveBlockStat::STAGE_ADDRESS_TX_INFO, tStage.Elapse());
         }
 
         if (pIndexNew->IsPrimary())
         {
+            tStage = CTicks();
             if (!AddBlockForkContext(hashBlock, block, ptrBlockStateOut->mapBlockAddressContext, blockRoot.hashForkContextRoot))
             {
                 StdError("BlockBase", "Save block: Add bock fork context failed, block: %s", hashBlock.ToString().c_str());
                 fRet = false;
                 break;
             }
+            AddSaveBlockStage(CSaveBlockStat::STAGE_FORK_CONTEXT, tStage.Elapse());
 
+            tStage = CTicks();
             if (!UpdateDelegate(hashFork, hashBlock, block, nFile, nOffset, DELEGATE_PROOF_OF_STAKE_ENROLL_MINIMUM_AMOUNT,
                                 ptrBlockStateOut->mapBlockAddressContext, ptrBlockStateOut->mapBlockState, blockRoot.hashDelegateRoot))
             {
@@ -3668,22 +3988,28 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
                 fRet = false;
                 break;
             }
+            AddSaveBlockStage(CSaveBlockStat::STAGE_DELEGATE, tStage.Elapse());
 
+            tStage = CTicks();
             if (!UpdateVote(hashFork, hashBlock, block, ptrBlockStateOut->mapBlockAddressContext, ptrBlockStateOut->mapBlockState, ptrBlockStateOut->mapBlockModifyPledgeFinalHeight, blockRoot.hashVoteRoot))
             {
                 StdError("BlockBase", "Save block: Update vote failed, block: %s", hashBlock.ToString().c_str());
                 fRet = false;
                 break;
             }
+            AddSaveBlockStage(CSaveBlockStat::STAGE_VOTE, tStage.Elapse());
         }
 
+        tStage = CTicks();
         if (!UpdateBlockVoteReward(hashFork, pIndexNew->nChainId, hashBlock, block, blockRoot.hashVoteRewardRoot))
         {
             StdError("BlockBase", "Save block: Update block vote reward failed, block: %s", hashBlock.ToString().c_str());
             fRet = false;
             break;
         }
+        AddSaveBlockStage(CSaveBlockStat::STAGE_VOTE_REWARD, tStage.Elapse());
 
+        tStage = CTicks();
         if (!dbBlock.AddNewBlockNumber(hashFork, pIndexNew->nChainId, block.hashPrev, block.nNumber, hashBlock, blockRoot.hashBlockNumberRoot))
         {
             StdError("BlockBase", "Save block: Add new block number failed, block: %s", hashBlock.ToString().c_str());
@@ -3706,6 +4032,7 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
             fRet = false;
             break;
         }
+        AddSaveBlockStage(CSaveBlockStat::STAGE_BLOCK_INDEX, tStage.Elapse());
 
         // add destroy token
         for (auto& kv : ptrBlockStateOut->mapBlockContractTransfer)
@@ -3733,6 +4060,12 @@ bool CBlockBase::SaveBlock(const uint256& hashFork, const uint256& hashBlock, co
         return false;
     }
     *ppIndexNew = pIndexNew;
+    {
+        boost::unique_lock<boost::mutex> lock(mtxSaveBlockStat);
+        statSaveBlock.nBlockCount++;
+        statSaveBlock.nTxCount += block.vtx.size();
+        statSaveBlock.AddStage(CSaveBlockStat::STAGE_DB_WRITE, CLevelDBEngine::GetThreadWriteTicks() - nDbWriteTicks);
+    }
 
     StdLog("BlockBase", "Save block: Save block success, block: [%d] %s", CBlock::GetBlockHeightByHash(hashBlock), hashBlock.ToString().c_str());
 
@@ -4324,6 +4657,13 @@ bool CBlockBase::AddBlockForkContext(const uint256& hashBlock, const CBlockEx& b
         StdLog("BlockBase", "Add block fork context: Add fork context to db fail, block: %s", hashBlock.ToString().c_str());
         return false;
     }
+
+    std::vector<uint256> vForkCreated;
+    for (const auto& kv : mapNewForkCtxt)
+    {
+        vForkCreated.push_back(kv.first);
+    }
+    cacheBlockForkCreated.AddNew(hashBlock, vForkCreated);
     return true;
 }
 
@@ -5104,6 +5444,7 @@ bool CBlockBase::UpdateBlockState(const uint256& hashFork, const uint256& hashBl
         nPrevBlockTime = pIndexPrev->GetBlockTime();
     }
 
+    CTicks tExecute;
     SHP_BLOCK_STATE ptrBlockState = CreateBlockStateRoot(hashFork, block, hashPrevStateRoot, nPrevBlockTime, hashStateRoot, hashReceiptRoot,
                                                          nBlockGasUsed, btBloomDataTemp, nTotalMintReward, mapAddressContext);
     if (!ptrBlockState)
@@ -5111,6 +5452,7 @@ bool CBlockBase::UpdateBlockState(const uint256& hashFork, const uint256& hashBl
         StdLog("BlockBase", "Update block state: Create block state root fail, block: %s", block.GetHash().GetHex().c_str());
         return false;
     }
+    AddSaveBlockStage(CSaveBlockStat::STAGE_EXECUTE, tExecute.Elapse());
     if (block.hashStateRoot != 0 && block.hashStateRoot != hashStateRoot)
     {
         StdLog("BlockBase", "Update block state: Create state root error, block state root: %s, calc state root: %s, prev state root: %s, block: [type: %d] %s",
@@ -5125,12 +5467,14 @@ bool CBlockBase::UpdateBlockState(const uint256& hashFork, const uint256& hashBl
         return false;
     }
 
+    CTicks tCommit;
     CBlockRootStatus statusBlockRoot(block.nType, block.GetBlockTime(), block.txMint.GetToAddress());
     if (!dbBlock.AddBlockState(hashFork, hashPrevStateRoot, statusBlockRoot, ptrBlockState->mapBlockState, hashStateRoot))
     {
         StdLog("BlockBase", "Update block state: Add block state fail, block: %s", block.GetHash().GetHex().c_str());
         return false;
     }
+    AddSaveBlockStage(CSaveBlockStat::STAGE_STATE_COMMIT, tCommit.Elapse());
     if (block.hashStateRoot != 0 && block.hashStateRoot != hashStateRoot)
     {
         StdLog("BlockBase", "Update block state: Add state root error, block state root: %s, calc state  root: %s, block: %s",
@@ -5334,25 +5678,10 @@ bool CBlockBase::UpdateBlockAddress(const uint256& hashFork, const uint256& hash
         destGenesisMintAddress = pIndex->destMint;
     }
 
-    uint64 nNewAddressCount = 0;
+    // Addresses already stored with the same type are skipped while the address trie is written
     std::map<CDestination, CAddressContext> mapAddAddress;
     for (auto& kv : mapAddressContextIn)
     {
-        // If there is address data in the DB and the address type is the same, there is no need to store it again.
-        // If there is address data in the DB, but the address type is different, it needs to be re stored to change the address data.
-        bool fExist = false;
-        if (block.hashPrev != 0)
-        {
-            CAddressContext ctxAddress;
-            if (RetrieveAddressContext(hashFork, block.hashPrev, kv.first, ctxAddress))
-            {
-                if (ctxAddress.nType == kv.second.nType)
-                {
-                    continue;
-                }
-                fExist = true;
-            }
-        }
         if (kv.second.IsContract())
         {
             CContractAddressContext ctxContract;
@@ -5368,10 +5697,6 @@ bool CBlockBase::UpdateBlockAddress(const uint256& hashFork, const uint256& hash
             }
         }
         mapAddAddress.insert(kv);
-        if (!fExist)
-        {
-            nNewAddressCount++;
-        }
     }
 
     // Settlement time vault
@@ -5482,7 +5807,7 @@ bool CBlockBase::UpdateBlockAddress(const uint256& hashFork, const uint256& hash
         }
     }
 
-    if (!dbBlock.AddAddressContext(hashFork, block.hashPrev, hashBlock, mapAddAddress, nNewAddressCount, mapTimeVault, mapBlockFunctionAddressIn, hashNewRoot))
+    if (!dbBlock.AddAddressContext(hashFork, block.hashPrev, hashBlock, mapAddAddress, mapTimeVault, mapBlockFunctionAddressIn, hashNewRoot))
     {
         StdLog("BlockBase", "Update Block Address: Add address context fail, block: %s", hashBlock.GetHex().c_str());
         return false;
@@ -5615,6 +5940,11 @@ bool CBlockBase::RetrieveContractKvValue(const uint256& hashFork, const uint256&
     return dbBlock.RetrieveContractKvValue(hashFork, hashContractRoot, key, value);
 }
 
+bool CBlockBase::ListContractKvValue(const uint256& hashFork, const uint256& hashContractRoot, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext)
+{
+    return dbBlock.ListContractKvValue(hashFork, hashContractRoot, keyBegin, nGetCount, vContractKv, keyNext);
+}
+
 bool CBlockBase::AddBlockContractKvValue(const uint256& hashFork, const uint256& hashPrevRoot, uint256& hashContractRoot, const std::map<uint256, bytes>& mapContractState)
 {
     return dbBlock.AddBlockContractKvValue(hashFork, hashPrevRoot, hashContractRoot, mapContractState);
@@ -7126,6 +7456,11 @@ bool CBlockBase::ListAddressTxInfo(const uint256& hashFork, const uint256& hashB
     return dbBlock.ListAddressTxInfo(hashFork, hashBlock, dest, nBeginTxIndex, nGetTxCount, fReverse, vAddressTxInfo);
 }
 
+bool CBlockBase::GetAddressTxInfoIndexLast(const uint256& hashFork, uint256& hashBlock)
+{
+    return dbBlock.GetAddressTxInfoIndexLast(hashFork, hashBlock);
+}
+
 bool CBlockBase::GetVoteRewardLockedAmount(const uint256& hashFork, const uint256& hashPrevBlock, const CDestination& dest, uint256& nLockedAmount)
 {
     CBlockOutline outline;
@@ -7658,6 +7993,22 @@ uint256 CBlockBase::GetForkMintMinGasPrice(const uint256& hashFork)
     return nMinGasPrice;
 }
 
+void CBlockBase::GetSaveBlockStat(CSaveBlockStat& stat, const bool fReset)
+{
+    boost::unique_lock<boost::mutex> lock(mtxSaveBlockStat);
+    stat = statSaveBlock;
+    if (fReset)
+    {
+        statSaveBlock.Reset();
+    }
+}
+
+void CBlockBase::AddSaveBlockStage(const int nStage, const int64 nTicks)
+{
+    boost::unique_lock<boost::mutex> lock(mtxSaveBlockStat);
+    statSaveBlock.AddStage(nStage, nTicks);
+}
+
 //----------------------------------------------------------------------------
 bool CBlockBase::GetTxIndex(const uint256& hashFork, const uint256& txid, uint256& hashAtFork, CTxIndex& txIndex)
 {
@@ -7889,6 +8240,49 @@ bool CBlockBase::VerifyDB()
             }
         }
     }
+
+    if (nCfgCheckLevel >= CHECK_LEVEL_ALL_NODE)
+    {
+        if (!VerifyForkLastAllNode(mapForkLast))
+        {
+            StdError("BlockBase", "Verify DB: Verify fork last all node fail");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CBlockBase::VerifyForkLastAllNode(const std::map<uint256, uint256>& mapForkLast)
+{
+    std::size_t nForkIndex = 0;
+    for (const auto& kv : mapForkLast)
+    {
+        const uint256& hashFork = kv.first;
+        const uint256& hashLastBlock = kv.second;
+        int64 nBeginTime = GetTimeMillis();
+        StdLog("BlockBase", "Verify fork last all node: Begin, fork: %ld/%ld, last block: [%d] %s, fork: %s",
+               nForkIndex + 1, mapForkLast.size(), CBlock::GetBlockHeightByHash(hashLastBlock), hashLastBlock.GetHex().c_str(), hashFork.GetHex().c_str());
+
+        CBlockOutline outline;
+        if (!dbBlock.RetrieveBlockIndex(hashLastBlock, outline))
+        {
+            StdError("BlockBase", "Verify fork last all node: Retrieve block index fail, block: [%d] %s",
+                     CBlock::GetBlockHeightByHash(hashLastBlock), hashLastBlock.GetHex().c_str());
+            return false;
+        }
+        CBlockRoot blockRoot;
+        if (!dbBlock.VerifyBlockRoot(outline.IsPrimary(), outline.hashOrigin, outline.hashPrev,
+                                     hashLastBlock, outline.hashStateRoot, blockRoot, true))
+        {
+            StdError("BlockBase", "Verify fork last all node: Verify block root fail, block: [%d] %s",
+                     CBlock::GetBlockHeightByHash(hashLastBlock), hashLastBlock.GetHex().c_str());
+            return false;
+        }
+
+        StdLog("BlockBase", "Verify fork last all node: End, fork: %ld/%ld, time: %ld ms, fork: %s",
+               nForkIndex + 1, mapForkLast.size(), GetTimeMillis() - nBeginTime, hashFork.GetHex().c_str());
+        nForkIndex++;
+    }
     return true;
 }
 
@@ -8027,5 +8421,165 @@ bool CBlockBase::LoadBlockIndex(CBlockOutline& outline, CBlockIndex** ppIndexNew
     return true;
 }
 
+bool CBlockBase::IndexBlockAddressTxInfo(const uint256& hashFork, const CBlockIndex* pIndex)
+{
+    const uint256 hashBlock = pIndex->GetBlockHash();
+
+    CBlockEx block;
+    if (!Retrieve(pIndex, block))
+    {
+        StdLog("BlockBase", "Index block address tx info: Retrieve block fail, block: %s", hashBlock.GetHex().c_str());
+        return false;
+    }
+
+    // Blocks imported in this run leave their executed state behind, older ones are executed again
+    SHP_BLOCK_STATE ptrBlockState = TakeCacheBlockState(hashBlock);
+    if (!ptrBlockState)
+    {
+        uint256 hashPrevStateRoot;
+        uint32 nPrevBlockTime = 0;
+        if (block.hashPrev != 0)
+        {
+            CBlockIndex* pIndexPrev = nullptr;
+            if (!RetrieveIndex(block.hashPrev, &pIndexPrev) || pIndexPrev == nullptr)
+            {
+                StdLog("BlockBase", "Index block address tx info: Retrieve prev index fail, prev: %s", block.hashPrev.GetHex().c_str());
+                return false;
+            }
+            if (!block.IsOrigin())
+            {
+                hashPrevStateRoot = pIndexPrev->GetStateRoot();
+            }
+            nPrevBlockTime = pIndexPrev->GetBlockTime();
+        }
+
+        std::map<CDestination, CAddressContext> mapAddressContext;
+        if (!GetBlockAddress(hashFork, hashBlock, block, mapAddressContext))
+        {
+            StdLog("BlockBase", "Index block address tx info: Get block address fail, block: %s", hashBlock.GetHex().c_str());
+            return false;
+        }
+
+        uint256 hashStateRoot;
+        uint256 hashReceiptRoot;
+        uint256 nBlockGasUsed;
+        uint256 nTotalMintReward;
+        bytes btBloomData;
+        ptrBlockState = CreateBlockStateRoot(hashFork, block, hashPrevStateRoot, nPrevBlockTime, hashStateRoot, hashReceiptRoot,
+                                             nBlockGasUsed, btBloomData, nTotalMintReward, mapAddressContext);
+        if (!ptrBlockState)
+        {
+            StdLog("BlockBase", "Index block address tx info: Create block state root fail, block: %s", hashBlock.GetHex().c_str());
+            return false;
+        }
+        if (block.hashStateRoot != 0 && block.hashStateRoot != hashStateRoot)
+        {
+            StdLog("BlockBase", "Index block address tx info: State root error, block state root: %s, calc state root: %s, block: %s",
+                   block.hashStateRoot.GetHex().c_str(), hashStateRoot.GetHex().c_str(), hashBlock.GetHex().c_str());
+            return false;
+        }
+    }
+
+    uint256 hashAddressTxInfoRoot;
+    if (!UpdateBlockAddressTxInfo(hashFork, hashBlock, block, ptrBlockState->mapBlockContractTransfer,
+                                  ptrBlockState->mapBlockTxFeeUsed, ptrBlockState->mapBlockCodeDestFeeUsed, hashAddressTxInfoRoot))
+    {
+        StdLog("BlockBase", "Index block address tx info: Update block address tx info fail, block: %s", hashBlock.GetHex().c_str());
+        return false;
+    }
+    return true;
+}
+
+void CBlockBase::AddCacheBlockState(const uint256& hashFork, const uint256& hashBlock, const SHP_BLOCK_STATE& ptrBlockState)
+{
+    // Only blocks the indexer reaches soon are kept, the indexer takes the lowest one next.
+    // A block further ahead of the indexed height than the cache size is executed again later.
+    uint256 hashIndexLast;
+    const bool fIndexLast = dbBlock.GetAddressTxInfoIndexLast(hashFork, hashIndexLast);
+    const uint32 nIndexHeight = CBlock::GetBlockHeightByHash(fIndexLast ? hashIndexLast : hashFork);
+    const uint32 nHeight = CBlock::GetBlockHeightByHash(hashBlock);
+    if (nHeight > nIndexHeight + MAX_CACHE_BLOCK_STATE)
+    {
+        return;
+    }
+
+    boost::unique_lock<boost::mutex> lock(mtxCacheBlockState);
+    if (fIndexLast)
+    {
+        // Blocks the indexer has passed are never taken, such as side chain blocks
+        for (auto it = mapCacheBlockState.begin(); it != mapCacheBlockState.end();)
+        {
+            if (it->second.first == hashFork && CBlock::GetBlockHeightByHash(it->first) <= nIndexHeight)
+            {
+                mapCacheBlockState.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    if (mapCacheBlockState.size() >= MAX_CACHE_BLOCK_STATE)
+    {
+        // Full, drop the newest block
+        auto itMax = mapCacheBlockState.begin();
+        for (auto it = mapCacheBlockState.begin(); it != mapCacheBlockState.end(); ++it)
+        {
+            if (CBlock::GetBlockHeightByHash(it->first) > CBlock::GetBlockHeightByHash(itMax->first))
+            {
+                itMax = it;
+            }
+        }
+        if (CBlock::GetBlockHeightByHash(itMax->first) <= nHeight)
+        {
+            return;
+        }
+        mapCacheBlockState.erase(itMax);
+    }
+    mapCacheBlockState[hashBlock] = std::make_pair(hashFork, ptrBlockState);
+}
+
+SHP_BLOCK_STATE CBlockBase::TakeCacheBlockState(const uint256& hashBlock)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCacheBlockState);
+    SHP_BLOCK_STATE ptrBlockState;
+    auto it = mapCacheBlockState.find(hashBlock);
+    if (it != mapCacheBlockState.end())
+    {
+        ptrBlockState = it->second.second;
+        mapCacheBlockState.erase(it);
+    }
+    return ptrBlockState;
+}
+
+void CBlockBase::GetBlockForkDelta(CBlockChainUpdate& update)
+{
+    update.fForkDelta = false;
+    update.vForkCreated.clear();
+    update.vForkRemoved.clear();
+
+    std::vector<uint256> vForkCreated;
+    for (const CBlockEx& block : update.vBlockRemove)
+    {
+        if (!cacheBlockForkCreated.Retrieve(block.GetHash(), vForkCreated))
+        {
+            update.vForkRemoved.clear();
+            return;
+        }
+        update.vForkRemoved.insert(update.vForkRemoved.end(), vForkCreated.begin(), vForkCreated.end());
+    }
+    for (const CBlockEx& block : update.vBlockAddNew)
+    {
+        if (!cacheBlockForkCreated.Retrieve(block.GetHash(), vForkCreated))
+        {
+            update.vForkRemoved.clear();
+            update.vForkCreated.clear();
+            return;
+        }
+        update.vForkCreated.insert(update.vForkCreated.end(), vForkCreated.begin(), vForkCreated.end());
+    }
+    update.fForkDelta = true;
+}
+
 } // namespace storage
 } // namespace metabasenet
@@ -11,6 +11,8 @@
 #include <list>
 #include <map>
 #include <numeric>
+#include <scoped_allocator>
+#include <unordered_map>
 
 #include "../mvm/vface/vmhostface.h"
 #include "block.h"
@@ -160,6 +162,65 @@ protected:
     std::map<uint256, CBlockPendingTxFilter> mapTxFilter;
 };
 
+//////////////////////////////
+// CSaveBlockStat
+
+class CSaveBlockStat
+{
+public:
+    enum
+    {
+        STAGE_VERIFY,
+        STAGE_WRITE_BLOCK,
+        STAGE_EXECUTE,
+        STAGE_STATE_COMMIT,
+        STAGE_TX_INDEX,
+        STAGE_ADDRESS,
+        STAGE_CODE,
+        STAGE_ADDRESS_TX_INFO,
+        STAGE_FORK_CONTEXT,
+        STAGE_DELEGATE,
+        STAGE_VOTE,
+        STAGE_VOTE_REWARD,
+        STAGE_BLOCK_INDEX,
+        STAGE_DB_WRITE, // LevelDB writes, already counted in the stages above
+        STAGE_MAX
+    };
+
+    CSaveBlockStat()
+    {
+        Reset();
+    }
+    void Reset()
+    {
+        nBlockCount = 0;
+        nTxCount = 0;
+        for (int i = 0; i < STAGE_MAX; i++)
+        {
+            nStageTicks[i] = 0;
+        }
+    }
+    void AddStage(const int nStage, const int64 nTicks)
+    {
+        nStageTicks[nStage] += nTicks;
+    }
+    int64 GetTotalTicks() const
+    {
+        int64 nTotal = 0;
+        for (int i = 0; i < STAGE_DB_WRITE; i++)
+        {
+            nTotal += nStageTicks[i];
+        }
+        return nTotal;
+    }
+    static const char* GetStageName(const int nStage);
+
+public:
+    uint64 nBlockCount;
+    uint64 nTxCount;
+    int64 nStageTicks[STAGE_MAX];
+};
+
 //////////////////////////////
 // CBlockState
 
@@ -171,6 +232,7 @@ public:
     CBlockState(CBlockBase& dbBlockBaseIn, const uint256& hashForkIn, const CBlock& block, const uint256& hashPrevStateRootIn, const uint32 nPrevBlockTimeIn, const std::map<CDestination, CAddressContext>& mapAddressContext)
       : dbBlockBase(dbBlockBaseIn), nBlockType(block.nType), hashFork(hashForkIn), hashPrevBlock(block.hashPrev),
         hashPrevStateRoot(hashPrevStateRootIn), nPrevBlockTime(nPrevBlockTimeIn), nOriBlockGasLimit(block.nGasLimit.Get64()), nSurplusBlockGasLimit(block.nGasLimit.Get64()),
+        fCacheTvToAddress(false), fCacheTvToFunctionAddress(false),
         nBlockTimestamp(block.GetBlockTime()), nBlockHeight(block.GetBlockHeight()), nBlockNumber(block.GetBlockNumber()), destMint(block.txMint.GetToAddress()),
         mintTx(block.txMint), txidMint(block.txMint.GetHash()), fPrimaryBlock(block.IsPrimary()), mapBlockAddressContext(mapAddressContext)
     {
@@ -207,7 +269,7 @@ public:
         }
         for (auto& tx : block.vtx)
         {
-            setBlockBloomData.insert(tx.GetHash().GetBytes());
+            setBlockBloomData.Insert(tx.GetHash());
         }
         uint256 nMintCoint;
         if (!block.GetMintCoinProof(nMintCoint))
@@ -224,7 +286,7 @@ public:
 
     CBlockState(CBlockBase& dbBlockBaseIn, const uint256& hashForkIn, const uint256& hashPrevBlockIn, const uint256& hashPrevStateRootIn, const uint32 nPrevBlockTimeIn)
       : dbBlockBase(dbBlockBaseIn), nBlockType(0), hashFork(hashForkIn), hashPrevBlock(hashPrevBlockIn), hashPrevStateRoot(hashPrevStateRootIn), nPrevBlockTime(nPrevBlockTimeIn),
-        nOriBlockGasLimit(0), nSurplusBlockGasLimit(0), nBlockTimestamp(0), nBlockHeight(0), nBlockNumber(0), fPrimaryBlock(false) {}
+        nOriBlockGasLimit(0), nSurplusBlockGasLimit(0), fCacheTvToAddress(false), fCacheTvToFunctionAddress(false), nBlockTimestamp(0), nBlockHeight(0), nBlockNumber(0), fPrimaryBlock(false) {}
 
     bool AddTxState(const CTransaction& tx, const int nTxIndex);
     bool DoBlockState(uint256& hashReceiptRoot, uint256& nBlockGasUsed, bytes& btBlockBloomDataOut, uint256& nTotalMintRewardOut);
@@ -245,7 +307,7 @@ public:
     bool ExecFunctionContract(const CDestination& destFromIn, const CDestination& destToIn, const bytes& btData, const uint64 nGasLimit, uint64& nGasLeft, bytes& btResult);
     bool Selfdestruct(const CDestination& destContractIn, const CDestination& destBeneficiaryIn);
     void SaveGasUsed(const CDestination& destCodeOwner, const uint64 nGasUsed);
-    void SaveRunResult(const CDestination& destContractIn, const std::vector<CTransactionLogs>& vLogsIn, const std::map<uint256, bytes>& mapCacheKv);
+    void SaveRunResult(const CDestination& destContractIn, std::vector<CTransactionLogs>& vLogsIn, std::map<uint256, bytes>& mapCacheKv);
     bool ContractTransfer(const CDestination& from, const CDestination& to, const uint256& amount, const uint64 nGasLimit, uint64& nGasLeft, const CAddressContext& ctxToAddress, const uint8 nTransferType);
     bool IsContractDestroy(const CDestination& destContractIn);
 
@@ -255,6 +317,13 @@ public:
 
 protected:
     void CreateFunctionContractData();
+    virtual bool IsPlainTransferTx(const CTransaction& tx, CAddressContext& ctxToAddress);
+    void CalcTxTvGas(const CTransaction& tx, uint256& nTvGasFee, uint256& nTvGas);
+    bool AddTransferTxState(const uint256& txid, const CTransaction& tx, const int nTxIndex, const CAddressContext& ctxToAddress, const uint256& nTvGasFee, const uint256& nTvGas);
+    void AddTvGasFee(const uint256& txid, const CDestination& destFrom, const uint256& nTvGasFee, CTransactionReceipt& receipt);
+    void AddReceiptData(const CTransactionReceipt& receipt);
+    void ApplyCacheContractData(CTransactionReceipt& receipt);
+    void ClearCacheContractData();
     bool GetDestContractCode(const CTransaction& tx, CDestination& destContract, bytes& btContractCode, bytes& btRunParam, uint256& hashContractCreateCode,
                              CDestination& destCodeOwner, CTxContractData& txcd, bool& fCall, bool& fDestroy);
 
@@ -309,6 +378,11 @@ protected:
     uint256 hashRefBlock;
     uint256 nAgreement;
 
+    // Backs the per-block working containers below, declared first so it is released last
+    mtbase::CArena arenaState;
+    // Backs the per-tx contract cache, rewound when the cache is cleared at each tx boundary
+    mtbase::CArena arenaTx;
+
     class CCacheContractData
     {
     public:
@@ -319,7 +393,11 @@ protected:
         std::vector<CTransactionLogs> cacheContractLogs;
         std::map<uint256, bytes> cacheContractKv;
     };
-    std::map<CDestination, CCacheContractData> mapCacheContractData;
+    // Ordered by address: the receipt logs are appended in this order and are part of the receipts root
+    typedef std::map<CDestination, CCacheContractData, std::less<CDestination>,
+                     mtbase::CArenaAllocator<std::pair<const CDestination, CCacheContractData>>>
+        MapCacheContractData;
+    MapCacheContractData mapCacheContractData{ arenaTx };
     std::map<CDestination, CAddressContext> mapCacheAddressContext;
     std::map<uint256, CContractCreateCodeContext> mapCacheContractCreateCodeContext;
     std::map<uint256, CContractRunCodeContext> mapCacheContractRunCodeContext;
@@ -329,12 +407,27 @@ protected:
     std::map<uint32, CFunctionAddressContext> mapCacheFunctionAddress;
 
     uint64 nSurplusBlockGasLimit;
+    bool fCacheTvToAddress;
+    bool fCacheTvToFunctionAddress;
+    CDestination destCacheTvToAddress;
 
     std::map<CDestination, uint256> mapBlockRewardLocked;
 
+    // Working sets read and written by every tx, sorted only once when the block state is done
+    typedef std::unordered_map<CDestination, CDestState, CUintHasher, std::equal_to<CDestination>,
+                               mtbase::CArenaAllocator<std::pair<const CDestination, CDestState>>>
+        MapDestState;
+    typedef std::unordered_map<uint256, bytes, CUintHasher, std::equal_to<uint256>,
+                               mtbase::CArenaAllocator<std::pair<const uint256, bytes>>>
+        MapContractKv;
+    typedef std::unordered_map<CDestination, MapContractKv, CUintHasher, std::equal_to<CDestination>,
+                               std::scoped_allocator_adaptor<mtbase::CArenaAllocator<std::pair<const CDestination, MapContractKv>>>>
+        MapContractKvState;
+    MapDestState mapDestState{ arenaState };
+    MapContractKvState mapContractKvState{ arenaState };
+
 public:
     std::map<CDestination, CDestState> mapBlockState;
-    std::map<CDestination, std::map<uint256, bytes>> mapContractKvState;
     std::map<CDestination, CAddressContext> mapBlockAddressContext;
     std::map<CDestination, uint256> mapBlockPayTvFee;
     std::map<uint256, CContractCreateCodeContext> mapBlockContractCreateCodeContext;
@@ -344,11 +437,12 @@ public:
     std::map<uint256, std::map<CDestination, uint256>> mapBlockCodeDestFeeUsed; // key is txid
     std::map<CDestination, std::pair<uint32, uint32>> mapBlockModifyPledgeFinalHeight;
     std::vector<uint256> vReceiptHash;
+    std::vector<bytes> vReceiptData;
     std::map<uint256, CTransactionReceipt> mapBlockTxReceipts; // key is txid
     std::map<uint32, CFunctionAddressContext> mapBlockFunctionAddress;
     //uint2048 nBlockBloom;
     uint256 nBlockFeeLeft;
-    std::set<bytes> setBlockBloomData;
+    CBloomDataSet setBlockBloomData;
 };
 
 typedef std::shared_ptr<CBlockState> SHP_BLOCK_STATE;
@@ -373,7 +467,7 @@ public:
     virtual bool GetContractCreateCode(const CDestination& destContractIn, CTxContractData& txcd);
     virtual CVmHostFaceDBPtr CloneHostDB(const CDestination& destContractIn);
     virtual void SaveGasUsed(const CDestination& destCodeOwnerIn, const uint64 nGasUsed);
-    virtual void SaveRunResult(const CDestination& destContractIn, const std::vector<CTransactionLogs>& vLogsIn, const std::map<uint256, bytes>& mapCacheKv);
+    virtual void SaveRunResult(const CDestination& destContractIn, std::vector<CTransactionLogs>& vLogsIn, std::map<uint256, bytes>& mapCacheKv);
     virtual bool SaveContractRunCode(const CDestination& destContractIn, const bytes& btContractRunCode, const CTxContractData& txcd);
     virtual bool ExecFunctionContract(const CDestination& destFromIn, const CDestination& destToIn, const bytes& btData, const uint64 nGasLimit, uint64& nGasLeft, bytes& btResult);
     virtual bool Selfdestruct(const CDestination& destBeneficiaryIn);
@@ -391,8 +485,10 @@ class CBlockBase
 public:
     CBlockBase();
     ~CBlockBase();
-    bool Initialize(const boost::filesystem::path& pathDataLocation, const uint256& hashGenesisBlockIn, const bool fFullDbIn, const bool fRewardCheckIn, const bool fRenewDB = false);
+    bool Initialize(const boost::filesystem::path& pathDataLocation, const uint256& hashGenesisBlockIn, const bool fFullDbIn, const bool fFullDbAsyncIn, const bool fRewardCheckIn, const int nCheckLevelIn = 0, const bool fRenewDB = false);
     void Deinitialize();
+    void WarmupCache();
+    bool CatchUpAddressTxInfo(const std::size_t nMaxCount, std::size_t& nIndexCount);
     void Clear();
     bool IsEmpty() const;
     const uint256& GetGenesisBlockHash() const;
@@ -472,6 +568,7 @@ public:
                          const std::map<uint256, CContractRunCodeContext>& mapContractRunCodeContextIn, const std::map<CDestination, CAddressContext>& mapAddressContext, uint256& hashCodeRoot);
     bool UpdateBlockVoteReward(const uint256& hashFork, const uint32 nChainId, const uint256& hashBlock, const CBlockEx& block, uint256& hashNewRoot);
     bool RetrieveContractKvValue(const uint256& hashFork, const uint256& hashContractRoot, const uint256& key, bytes& value);
+    bool ListContractKvValue(const uint256& hashFork, const uint256& hashContractRoot, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext);
     bool AddBlockContractKvValue(const uint256& hashFork, const uint256& hashPrevRoot, uint256& hashContractRoot, const std::map<uint256, bytes>& mapContractState);
     bool RetrieveAddressContext(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, CAddressContext& ctxAddress);
     bool ListContractAddress(const uint256& hashFork, const uint256& hashBlock, std::map<CDestination, CContractAddressContext>& mapContractAddress);
@@ -497,6 +594,7 @@ public:
     bool GetAddressTxCount(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, uint64& nTxCount);
     bool RetrieveAddressTxInfo(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint64 nTxIndex, CDestTxInfo& ctxtAddressTxInfo);
     bool ListAddressTxInfo(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, const uint64 nBeginTxIndex, const uint64 nGetTxCount, const bool fReverse, std::vector<CDestTxInfo>& vAddressTxInfo);
+    bool GetAddressTxInfoIndexLast(const uint256& hashFork, uint256& hashBlock);
     bool GetVoteRewardLockedAmount(const uint256& hashFork, const uint256& hashPrevBlock, const CDestination& dest, uint256& nLockedAmount);
     bool GetBlockAddress(const uint256& hashFork, const uint256& hashBlock, const CBlock& block, std::map<CDestination, CAddressContext>& mapBlockAddress);
     bool GetTransactionReceipt(const uint256& hashFork, const uint256& txid, CTransactionReceiptEx& txReceiptex);
@@ -521,6 +619,9 @@ public:
     bool UpdateForkMintMinGasPrice(const uint256& hashFork, const uint256& nMinGasPrice);
     uint256 GetForkMintMinGasPrice(const uint256& hashFork);
 
+    void GetSaveBlockStat(CSaveBlockStat& stat, const bool fReset = false);
+    void AddSaveBlockStage(const int nStage, const int64 nTicks);
+
 protected:
     CBlockIndex* GetIndex(const uint256& hash) const;
     CBlockIndex* GetForkLastIndex(const uint256& hashFork);
@@ -547,25 +648,43 @@ protected:
     void ClearCache();
     bool LoadDB();
     bool VerifyDB();
+    bool VerifyForkLastAllNode(const std::map<uint256, uint256>& mapForkLast);
     bool VerifyBlockDB(const CBlockVerify& verifyBlock, CBlockOutline& outline, CBlockRoot& blockRoot, const bool fVerify);
     bool RepairBlockDB(const CBlockVerify& verifyBlock, CBlockRoot& blockRoot, CBlockEx& block, CBlockIndex** ppIndexNew);
     bool LoadBlockIndex(CBlockOutline& outline, CBlockIndex** ppIndexNew);
+    bool IndexBlockAddressTxInfo(const uint256& hashFork, const CBlockIndex* pIndex);
+    void AddCacheBlockState(const uint256& hashFork, const uint256& hashBlock, const SHP_BLOCK_STATE& ptrBlockState);
+    SHP_BLOCK_STATE TakeCacheBlockState(const uint256& hashBlock);
+    void GetBlockForkDelta(CBlockChainUpdate& update);
 
 protected:
     enum
     {
-        MAX_CACHE_BLOCK_STATE = 64
+        MAX_CACHE_BLOCK_STATE = 64,
+        MAX_CACHE_BLOCK_FORK_CREATED = 4096,
+        WARMUP_STATE_NODE_COUNT = 0x1000
+    };
+    enum
+    {
+        CHECK_LEVEL_ALL_NODE = 3
     };
 
     mutable mtbase::CRWAccess rwAccess;
     bool fCfgFullDb;
+    bool fCfgFullDbAsync;
     bool fCfgRewardCheck;
+    int nCfgCheckLevel;
     uint256 hashGenesisBlock;
     CBlockDB dbBlock;
     CTimeSeriesCached tsBlock;
     std::map<uint256, CBlockIndex*> mapIndex;
     std::map<uint256, CForkHeightIndex> mapForkHeightIndex;
     CBlockFilter blockFilter;
+    boost::mutex mtxSaveBlockStat;
+    CSaveBlockStat statSaveBlock;
+    boost::mutex mtxCacheBlockState;
+    std::map<uint256, std::pair<uint256, SHP_BLOCK_STATE>> mapCacheBlockState; // block -> (fork, state)
+    mtbase::CCache<uint256, std::vector<uint256>> cacheBlockForkCreated; // primary block -> forks created by it
 };
 
 } // namespace storage
@@ -386,6 +386,11 @@ bool CBlockDB::ListDestState(const uint256& hashFork, const uint256& hashBlockRo
     return dbState.ListDestState(hashFork, hashBlockRoot, mapBlockState);
 }
 
+std::size_t CBlockDB::PrefetchState(const uint256& hashFork, const uint256& hashBlockRoot, const std::size_t nMaxNode)
+{
+    return dbState.PrefetchState(hashFork, hashBlockRoot, nMaxNode);
+}
+
 bool CBlockDB::AddBlockTxIndexReceipt(const uint256& hashFork, const uint256& hashBlock, const std::map<uint256, CTxIndex>& mapBlockTxIndex, const std::map<uint256, CTransactionReceipt>& mapBlockTxReceipts)
 {
     return dbTxIndex.AddBlockTxIndexReceipt(hashFork, hashBlock, mapBlockTxIndex, mapBlockTxReceipts);
@@ -406,10 +411,15 @@ bool CBlockDB::RetrieveContractKvValue(const uint256& hashFork, const uint256& h
     return dbContract.RetrieveContractKvValue(hashFork, hashContractRoot, key, value);
 }
 
-bool CBlockDB::AddAddressContext(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress, const uint64 nNewAddressCount,
+bool CBlockDB::ListContractKvValue(const uint256& hashFork, const uint256& hashContractRoot, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext)
+{
+    return dbContract.ListContractKvValue(hashFork, hashContractRoot, keyBegin, nGetCount, vContractKv, keyNext);
+}
+
+bool CBlockDB::AddAddressContext(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock, const std::map<CDestination, CAddressContext>& mapAddress,
                                  const std::map<CDestination, CTimeVault>& mapTimeVault, const std::map<uint32, CFunctionAddressContext>& mapFunctionAddress, uint256& hashNewRoot)
 {
-    return dbAddress.AddAddressContext(hashFork, hashPrevBlock, hashBlock, mapAddress, nNewAddressCount, mapTimeVault, mapFunctionAddress, hashNewRoot);
+    return dbAddress.AddAddressContext(hashFork, hashPrevBlock, hashBlock, mapAddress, mapTimeVault, mapFunctionAddress, hashNewRoot);
 }
 
 bool CBlockDB::RetrieveAddressContext(const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, CAddressContext& ctxAddress)
@@ -521,6 +531,33 @@ bool CBlockDB::ListAddressTxInfo(const uint256& hashFork, const uint256& hashBlo
     return false;
 }
 
+bool CBlockDB::ExistAddressTxInfo(const uint256& hashFork, const uint256& hashBlock)
+{
+    if (fCfgFullDb)
+    {
+        return dbAddressTxInfo.ExistAddressTxInfo(hashFork, hashBlock);
+    }
+    return false;
+}
+
+bool CBlockDB::UpdateAddressTxInfoIndexLast(const uint256& hashFork, const uint256& hashBlock)
+{
+    if (fCfgFullDb)
+    {
+        return dbAddressTxInfo.UpdateIndexLast(hashFork, hashBlock);
+    }
+    return false;
+}
+
+bool CBlockDB::GetAddressTxInfoIndexLast(const uint256& hashFork, uint256& hashBlock)
+{
+    if (fCfgFullDb)
+    {
+        return dbAddressTxInfo.GetIndexLast(hashFork, hashBlock);
+    }
+    return false;
+}
+
 bool CBlockDB::AddVoteReward(const uint256& hashFork, const uint32 nChainId, const uint256& hashPrevBlock, const uint256& hashBlock, const uint32 nBlockHeight, const std::map<CDestination, uint256>& mapVoteReward, uint256& hashNewRoot)
 {
     return dbVote.AddVoteReward(hashFork, nChainId, hashPrevBlock, hashBlock, nBlockHeight, mapVoteReward, hashNewRoot);
@@ -613,7 +650,8 @@ bool CBlockDB::VerifyBlockRoot(const bool fPrimary, const uint256& hashFork, con
         StdError("CBlockDB", "Verify block root: Verify reward lock fail, block: %s", hashBlock.GetHex().c_str());
         return false;
     }
-    if (fCfgFullDb)
+    // Blocks not yet reached by the address tx info indexer have nothing to verify
+    if (fCfgFullDb && dbAddressTxInfo.ExistAddressTxInfo(hashFork, hashBlock))
     {
         uint256 hashAddressTxInfoRoot;
         if (!dbAddressTxInfo.VerifyAddressTxInfo(hashFork, hashPrevBlock, hashBlock, hashAddressTxInfoRoot, fVerifyAllNode))
@@ -18,6 +18,8 @@ namespace metabasenet
 namespace storage
 {
 
+#define MAX_FETCH_CONTRACT_KV_COUNT 1000
+
 const string DB_CONTRACT_KEY_ID_TRIEROOT("trieroot");
 const string DB_CONTRACT_KEY_ID_PREVROOT("prevroot");
 
@@ -65,6 +67,49 @@ bool CListCreateCodeTrieDBWalker::Walk(const bytes& btKey, const bytes& btValue,
     return true;
 }
 
+//////////////////////////////
+// CListContractKvTrieDBWalker
+
+bool CListContractKvTrieDBWalker::Walk(const bytes& btKey, const bytes& btValue, const uint32 nDepth, bool& fWalkOver)
+{
+    if (btKey.size() == 0 || btValue.size() == 0)
+    {
+        StdError("CListContractKvTrieDBWalker", "btKey.size() = %ld, btValue.size() = %ld", btKey.size(), btValue.size());
+        return false;
+    }
+
+    try
+    {
+        mtbase::CBufStream ssKey(btKey);
+        uint8 nKeyType;
+        ssKey >> nKeyType;
+        if (nKeyType == DB_CONTRACT_KEY_TYPE_CONTRACTKV)
+        {
+            uint256 key;
+            ssKey >> key;
+
+            if (vContractKv.size() >= nGetCount)
+            {
+                // The first key beyond the page is the continuation key of the next query
+                keyNext = key;
+                fWalkOver = true;
+                return true;
+            }
+
+            bytes value;
+            mtbase::CBufStream ssValue(btValue);
+            ssValue >> value;
+            vContractKv.push_back(std::make_pair(key, value));
+        }
+    }
+    catch (std::exception& e)
+    {
+        mtbase::StdError(__PRETTY_FUNCTION__, e.what());
+        return false;
+    }
+    return true;
+}
+
 //////////////////////////////
 // CForkContractDB
 
@@ -146,6 +191,40 @@ bool CForkContractDB::RetrieveContractKvValue(const uint256& hashContractRoot, c
     return true;
 }
 
+bool CForkContractDB::ListContractKvValue(const uint256& hashContractRoot, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext)
+{
+    mtbase::CBufStream ssKeyPrefix;
+    ssKeyPrefix << DB_CONTRACT_KEY_TYPE_CONTRACTKV;
+    bytes btKeyPrefix;
+    ssKeyPrefix.GetData(btKeyPrefix);
+
+    bytes btBeginKeyTail;
+    if (keyBegin != 0)
+    {
+        mtbase::CBufStream ss;
+        ss << keyBegin;
+        ss.GetData(btBeginKeyTail);
+    }
+    uint64 nGetCountInner = 0;
+    if (nGetCount == 0 || nGetCount > MAX_FETCH_CONTRACT_KV_COUNT)
+    {
+        nGetCountInner = MAX_FETCH_CONTRACT_KV_COUNT;
+    }
+    else
+    {
+        nGetCountInner = nGetCount;
+    }
+
+    keyNext = 0;
+    CListContractKvTrieDBWalker walker(nGetCountInner, vContractKv, keyNext);
+    if (!dbTrie.WalkThroughTrie(hashContractRoot, walker, btKeyPrefix, btBeginKeyTail))
+    {
+        StdLog("CForkContractDB", "List contract kv value: Walk through trie fail, root: %s", hashContractRoot.GetHex().c_str());
+        return false;
+    }
+    return true;
+}
+
 //////////////////////////////
 // contract code
 
@@ -570,6 +649,18 @@ bool CContractDB::RetrieveContractKvValue(const uint256& hashFork, const uint256
     return false;
 }
 
+bool CContractDB::ListContractKvValue(const uint256& hashFork, const uint256& hashContractRoot, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext)
+{
+    CReadLock rlock(rwAccess);
+
+    auto it = mapContractDB.find(hashFork);
+    if (it != mapContractDB.end())
+    {
+        return it->second->ListContractKvValue(hashContractRoot, keyBegin, nGetCount, vContractKv, keyNext);
+    }
+    return false;
+}
+
 bool CContractDB::CreateStaticContractStateRoot(const std::map<uint256, bytes>& mapContractState, uint256& hashStateRoot)
 {
     bytesmap mapKv;
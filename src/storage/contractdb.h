@@ -32,6 +32,20 @@ public:
     std::map<uint256, CContractCreateCodeContext>& mapContractCreateCode;
 };
 
+class CListContractKvTrieDBWalker : public CTrieDBWalker
+{
+public:
+    CListContractKvTrieDBWalker(const uint64 nGetCountIn, std::vector<std::pair<uint256, bytes>>& vContractKvIn, uint256& keyNextIn)
+      : nGetCount(nGetCountIn), vContractKv(vContractKvIn), keyNext(keyNextIn) {}
+
+    bool Walk(const bytes& btKey, const bytes& btValue, const uint32 nDepth, bool& fWalkOver) override;
+
+protected:
+    const uint64 nGetCount;
+    std::vector<std::pair<uint256, bytes>>& vContractKv;
+    uint256& keyNext;
+};
+
 class CForkContractDB
 {
 public:
@@ -44,6 +58,7 @@ public:
 
     bool AddBlockContractKvValue(const uint256& hashPrevRoot, uint256& hashContractRoot, const std::map<uint256, bytes>& mapContractState);
     bool RetrieveContractKvValue(const uint256& hashContractRoot, const uint256& key, bytes& value);
+    bool ListContractKvValue(const uint256& hashContractRoot, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext);
 
     bool AddCodeContext(const uint256& hashPrevBlock, const uint256& hashBlock,
                         const std::map<uint256, CContractSourceCodeContext>& mapSourceCode,
@@ -83,6 +98,7 @@ public:
 
     bool AddBlockContractKvValue(const uint256& hashFork, const uint256& hashPrevRoot, uint256& hashContractRoot, const std::map<uint256, bytes>& mapContractState);
     bool RetrieveContractKvValue(const uint256& hashFork, const uint256& hashContractRoot, const uint256& key, bytes& value);
+    bool ListContractKvValue(const uint256& hashFork, const uint256& hashContractRoot, const uint256& keyBegin, const uint64 nGetCount, std::vector<std::pair<uint256, bytes>>& vContractKv, uint256& keyNext);
     static bool CreateStaticContractStateRoot(const std::map<uint256, bytes>& mapContractState, uint256& hashStateRoot);
 
     bool AddCodeContext(const uint256& hashFork, const uint256& hashPrevBlock, const uint256& hashBlock,
@@ -16,6 +16,8 @@ namespace metabasenet
 namespace storage
 {
 
+thread_local int64 CLevelDBEngine::nThreadWriteTicks = 0;
+
 CLevelDBArguments::CLevelDBArguments()
 {
     cache = 32 << 20;
@@ -95,7 +97,9 @@ bool CLevelDBEngine::TxnCommit()
 {
     if (pbatch != nullptr)
     {
+        CTicks tWrite;
         leveldb::Status status = pdb->Write(batchoptions, pbatch);
+        nThreadWriteTicks += tWrite.Elapse();
         delete pbatch;
         pbatch = nullptr;
         return status.ok();
@@ -109,6 +113,11 @@ void CLevelDBEngine::TxnAbort()
     pbatch = nullptr;
 }
 
+int64 CLevelDBEngine::GetThreadWriteTicks()
+{
+    return nThreadWriteTicks;
+}
+
 bool CLevelDBEngine::Get(CBufStream& ssKey, CBufStream& ssValue)
 {
     leveldb::Slice slKey(ssKey.GetData(), ssKey.GetSize());
@@ -142,7 +151,9 @@ bool CLevelDBEngine::Put(CBufStream& ssKey, CBufStream& ssValue, bool fOverwrite
         return true;
     }
 
+    CTicks tWrite;
     leveldb::Status status = pdb->Put(writeoptions, slKey, slValue);
+    nThreadWriteTicks += tWrite.Elapse();
 
     return status.ok();
 }
@@ -157,7 +168,9 @@ bool CLevelDBEngine::Remove(CBufStream& ssKey)
         return true;
     }
 
+    CTicks tWrite;
     leveldb::Status status = pdb->Delete(writeoptions, slKey);
+    nThreadWriteTicks += tWrite.Elapse();
 
     return status.ok();
 }
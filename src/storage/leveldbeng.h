@@ -47,7 +47,12 @@ public:
     bool MoveTo(mtbase::CBufStream& ssKey) override;
     bool MoveNext(mtbase::CBufStream& ssKey, mtbase::CBufStream& ssValue) override;
 
+    // Time the calling thread has spent in LevelDB writes, in microseconds
+    static int64 GetThreadWriteTicks();
+
 protected:
+    static thread_local int64 nThreadWriteTicks;
+
     std::string path;
     leveldb::DB* pdb;
     leveldb::Iterator* piter;
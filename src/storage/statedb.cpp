@@ -223,6 +223,11 @@ bool CForkStateDB::VerifyState(const uint256& hashRoot, const bool fVerifyAllNod
     return true;
 }
 
+std::size_t CForkStateDB::PrefetchState(const uint256& hashRoot, const std::size_t nMaxNode)
+{
+    return dbTrie.PrefetchTrieNode(hashRoot, nMaxNode);
+}
+
 void CForkStateDB::AddPrevRoot(const uint256& hashPrevRoot, const CBlockRootStatus& statusBlockRoot, bytesmap& mapKv)
 {
     mtbase::CBufStream ssKey, ssValue;
@@ -410,6 +415,18 @@ bool CStateDB::VerifyState(const uint256& hashFork, const uint256& hashRoot, con
     return false;
 }
 
+std::size_t CStateDB::PrefetchState(const uint256& hashFork, const uint256& hashRoot, const std::size_t nMaxNode)
+{
+    CReadLock rlock(rwAccess);
+
+    auto it = mapStateDB.find(hashFork);
+    if (it != mapStateDB.end())
+    {
+        return it->second->PrefetchState(hashRoot, nMaxNode);
+    }
+    return 0;
+}
+
 bool CStateDB::CreateStaticStateRoot(const CBlockRootStatus& statusBlockRoot, const std::map<CDestination, CDestState>& mapBlockState, uint256& hashStateRoot)
 {
     bytesmap mapKv;
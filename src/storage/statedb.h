@@ -45,6 +45,7 @@ public:
     bool RetrieveDestState(const uint256& hashBlockRoot, const CDestination& dest, CDestState& state);
     bool ListDestState(const uint256& hashBlockRoot, std::map<CDestination, CDestState>& mapBlockState);
     bool VerifyState(const uint256& hashRoot, const bool fVerifyAllNode = true);
+    std::size_t PrefetchState(const uint256& hashRoot, const std::size_t nMaxNode);
 
 protected:
     void AddPrevRoot(const uint256& hashPrevRoot, const CBlockRootStatus& statusBlockRoot, bytesmap& mapKv);
@@ -82,6 +83,7 @@ public:
     bool RetrieveDestState(const uint256& hashFork, const uint256& hashBlockRoot, const CDestination& dest, CDestState& state);
     bool ListDestState(const uint256& hashFork, const uint256& hashBlockRoot, std::map<CDestination, CDestState>& mapBlockState);
     bool VerifyState(const uint256& hashFork, const uint256& hashRoot, const bool fVerifyAllNode = true);
+    std::size_t PrefetchState(const uint256& hashFork, const uint256& hashRoot, const std::size_t nMaxNode);
 
     static bool CreateStaticStateRoot(const CBlockRootStatus& statusBlockRoot, const std::map<CDestination, CDestState>& mapBlockState, uint256& hashStateRoot);
 
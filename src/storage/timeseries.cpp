@@ -217,6 +217,7 @@ bool CTimeSeriesCached::Initialize(const path& pathLocationIn, const string& str
         boost::unique_lock<boost::mutex> lock(mtxCache);
 
         ResetCache();
+        LoadHotSet();
     }
     return true;
 }
@@ -225,9 +226,17 @@ void CTimeSeriesCached::Deinitialize()
 {
     boost::unique_lock<boost::mutex> lock(mtxCache);
 
+    SaveHotSet();
     ResetCache();
 }
 
+void CTimeSeriesCached::GetHotSet(std::vector<CDiskPos>& vHotPos)
+{
+    boost::unique_lock<boost::mutex> lock(mtxCache);
+
+    vHotPos = vLoadHotPos;
+}
+
 void CTimeSeriesCached::ResetCache()
 {
     cacheStream.Clear();
@@ -236,7 +245,7 @@ void CTimeSeriesCached::ResetCache()
 
 bool CTimeSeriesCached::VacateCache(uint32 nNeeded)
 {
-    const size_t nHdrSize = 12;
+    const size_t nHdrSize = CACHE_RECORD_HEADER_SIZE;
 
     while (cacheStream.GetBufFreeSpace() < nNeeded + nHdrSize)
     {
@@ -260,6 +269,107 @@ bool CTimeSeriesCached::VacateCache(uint32 nNeeded)
     return true;
 }
 
+void CTimeSeriesCached::RecordHotPos(const CDiskPos& pos)
+{
+    auto it = mapHotPos.find(pos);
+    if (it != mapHotPos.end())
+    {
+        it->second++;
+        return;
+    }
+    if (mapHotPos.size() >= HOTSET_TRACK_COUNT)
+    {
+        // Age the counters, so positions that are no longer read give way to new ones
+        for (auto mt = mapHotPos.begin(); mt != mapHotPos.end();)
+        {
+            mt->second /= 2;
+            if (mt->second == 0)
+            {
+                mapHotPos.erase(mt++);
+            }
+            else
+            {
+                ++mt;
+            }
+        }
+    }
+    mapHotPos.insert(make_pair(pos, 1));
+}
+
+void CTimeSeriesCached::LoadHotSet()
+{
+    mapHotPos.clear();
+    vLoadHotPos.clear();
+
+    path pathHotSet = pathLocation / (strPrefix + ".hotset");
+    if (!is_regular_file(pathHotSet))
+    {
+        return;
+    }
+    try
+    {
+        CFileStream fs(pathHotSet.string().c_str());
+        fs >> vLoadHotPos;
+    }
+    catch (exception& e)
+    {
+        vLoadHotPos.clear();
+        StdWarn("TimeSeriesCached", "Load hot set: %s", e.what());
+    }
+    if (vLoadHotPos.size() > HOTSET_SAVE_COUNT)
+    {
+        vLoadHotPos.resize(HOTSET_SAVE_COUNT);
+    }
+
+    // The hot set is only valid for the shutdown that wrote it
+    boost::system::error_code ec;
+    remove(pathHotSet, ec);
+}
+
+void CTimeSeriesCached::SaveHotSet()
+{
+    if (pathLocation.empty() || mapHotPos.empty())
+    {
+        return;
+    }
+
+    vector<pair<uint32, CDiskPos>> vCount;
+    vCount.reserve(mapHotPos.size());
+    for (const auto& kv : mapHotPos)
+    {
+        vCount.push_back(make_pair(kv.second, kv.first));
+    }
+    size_t nSaveCount = min(vCount.size(), (size_t)HOTSET_SAVE_COUNT);
+    partial_sort(vCount.begin(), vCount.begin() + nSaveCount, vCount.end(),
+                 [](const pair<uint32, CDiskPos>& a, const pair<uint32, CDiskPos>& b) { return a.first > b.first; });
+
+    vector<CDiskPos> vHotPos;
+    vHotPos.reserve(nSaveCount);
+    for (size_t i = 0; i < nSaveCount; i++)
+    {
+        vHotPos.push_back(vCount[i].second);
+    }
+
+    path pathHotSet = pathLocation / (strPrefix + ".hotset");
+    FILE* fp = fopen(pathHotSet.string().c_str(), "w");
+    if (fp == nullptr)
+    {
+        StdWarn("TimeSeriesCached", "Save hot set: open file fail, file: %s", pathHotSet.string().c_str());
+        return;
+    }
+    fclose(fp);
+    try
+    {
+        CFileStream fs(pathHotSet.string().c_str());
+        fs << vHotPos;
+    }
+    catch (exception& e)
+    {
+        StdWarn("TimeSeriesCached", "Save hot set: %s", e.what());
+    }
+    mapHotPos.clear();
+}
+
 //////////////////////////////
 // CTimeSeriesChunk
 
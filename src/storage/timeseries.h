@@ -96,6 +96,7 @@ public:
     ~CTimeSeriesCached();
     bool Initialize(const boost::filesystem::path& pathLocationIn, const std::string& strPrefixIn);
     void Deinitialize();
+    void GetHotSet(std::vector<CDiskPos>& vHotPos);
     template <typename T>
     bool Write(const T& t, uint32& nFile, uint32& nOffset, uint32& nCrc, bool fWriteCache = true)
     {
@@ -143,6 +144,10 @@ public:
     {
         boost::unique_lock<boost::mutex> lock(mtxCache);
 
+        if (fBlock)
+        {
+            RecordHotPos(CDiskPos(nFile, nOffset));
+        }
         if (ReadFromCache(t, CDiskPos(nFile, nOffset)))
         {
             return true;
@@ -167,6 +172,10 @@ public:
     {
         boost::unique_lock<boost::mutex> lock(mtxCache);
 
+        if (fBlock)
+        {
+            RecordHotPos(pos);
+        }
         if (ReadFromCache(t, pos))
         {
             return true;
@@ -187,6 +196,35 @@ public:
         return true;
     }
     template <typename T>
+    bool ReadWarmup(T& t, const CDiskPos& pos, bool& fCacheFull)
+    {
+        boost::unique_lock<boost::mutex> lock(mtxCache);
+
+        // Not counted as a read, and only free cache space is used, so nothing already cached is evicted
+        fCacheFull = false;
+        if (mapCachePos.count(pos))
+        {
+            return true;
+        }
+        if (!ReadDirect(t, pos.nFile, pos.nOffset, true))
+        {
+            return false;
+        }
+
+        mtbase::CBufStream ss;
+        ss << t;
+        if (cacheStream.GetBufFreeSpace() < ss.GetSize() + CACHE_RECORD_HEADER_SIZE)
+        {
+            fCacheFull = true;
+            return true;
+        }
+        if (!WriteToCache(ss.GetData(), ss.GetSize(), pos))
+        {
+            ResetCache();
+        }
+        return true;
+    }
+    template <typename T>
     bool ReadDirect(T& t, const uint32 nFile, const uint32 nOffset, const bool fBlock)
     {
         std::string pathFile;
@@ -458,6 +496,9 @@ public:
 protected:
     void ResetCache();
     bool VacateCache(uint32 nNeeded);
+    void RecordHotPos(const CDiskPos& pos);
+    void LoadHotSet();
+    void SaveHotSet();
     template <typename T>
     bool WriteToCache(const T& t, const CDiskPos& diskpos)
     {
@@ -516,11 +557,16 @@ protected:
 protected:
     enum
     {
-        FILE_CACHE_SIZE = 0x2000000
+        FILE_CACHE_SIZE = 0x2000000,
+        CACHE_RECORD_HEADER_SIZE = 12,
+        HOTSET_TRACK_COUNT = 0x10000,
+        HOTSET_SAVE_COUNT = 0x1000
     };
     boost::mutex mtxCache;
     mtbase::CCircularStream cacheStream;
     std::map<CDiskPos, std::size_t> mapCachePos;
+    std::map<CDiskPos, uint32> mapHotPos; // block position -> read count since startup
+    std::vector<CDiskPos> vLoadHotPos;    // hot set saved at last shutdown, hottest first
     static const uint32 nMagicNum;
 };
 
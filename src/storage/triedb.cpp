@@ -4,11 +4,14 @@
 
 #include "triedb.h"
 
+#include <atomic>
 #include <boost/range/adaptor/reversed.hpp>
+#include <deque>
 
 #include "leveldbeng.h"
 
 #include "block.h"
+#include "parallel.h"
 
 using namespace std;
 using namespace mtbase;
@@ -404,12 +407,12 @@ void CTrieDB::Clear()
     RemoveAll();
 }
 
-bool CTrieDB::AddNewTrie(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot)
+bool CTrieDB::AddNewTrie(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot, TrieUpdateFunc funcUpdate)
 {
     mtbase::CWriteLock wlock(rwAccess);
 
     std::map<uint256, CTrieValue> mapCacheNode;
-    if (!CreateTrieNodeList(hashPrevRoot, mapKvList, hashNewRoot, mapCacheNode))
+    if (!CreateTrieNodeList(hashPrevRoot, mapKvList, hashNewRoot, mapCacheNode, funcUpdate))
     {
         StdLog("CTrieDB", "Add new trie: Create trie node list fail, prev root: %s", hashPrevRoot.GetHex().c_str());
         return false;
@@ -515,10 +518,7 @@ bool CTrieDB::CheckTrie(const std::vector<uint256>& vCheckRoot)
     std::map<uint256, CTrieValue> mapCacheNode;
     for (const uint256& hashRoot : vCheckRoot)
     {
-        CTrieListDBWalker walker;
-        bytes nbBeginKey;
-        bool fWalkOver = false;
-        if (!WalkThroughNode(hashRoot, bytes(), nbBeginKey, false, bytes(), walker, mapCacheNode, 0, fWalkOver))
+        if (!CheckRootNode(hashRoot, mapCacheNode))
         {
             return false;
         }
@@ -529,18 +529,7 @@ bool CTrieDB::CheckTrie(const std::vector<uint256>& vCheckRoot)
 bool CTrieDB::CheckTrieNode(const uint256& hashRoot, std::map<uint256, CTrieValue>& mapCacheNode)
 {
     mtbase::CReadLock rlock(rwAccess);
-
-    if (hashRoot != 0)
-    {
-        CTrieListDBWalker walker;
-        bytes nbBeginKey;
-        bool fWalkOver = false;
-        if (!WalkThroughNode(hashRoot, bytes(), nbBeginKey, false, bytes(), walker, mapCacheNode, 0, fWalkOver))
-        {
-            return false;
-        }
-    }
-    return true;
+    return CheckRootNode(hashRoot, mapCacheNode);
 }
 
 bool CTrieDB::VerifyTrieRootNode(const uint256& hashRoot)
@@ -596,7 +585,136 @@ bool CTrieDB::WalkThroughExtKv(CBufStream& ssKeyBegin, CBufStream& ssKeyPrefix,
 }
 
 //////////////////////////////////////////
-bool CTrieDB::CreateTrieNodeList(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot, std::map<uint256, CTrieValue>& mapCacheNode)
+bool CTrieDB::CheckRootNode(const uint256& hashRoot, std::map<uint256, CTrieValue>& mapCacheNode)
+{
+    if (hashRoot == 0)
+    {
+        return true;
+    }
+
+    // mapCacheNode is shared by the callers across all the roots they check, a node found
+    // in it has been checked with its whole subtree and is neither read nor walked again.
+    // Check the top levels breadth-first until there are enough independent subtrees,
+    // then check the subtrees in parallel against the same map.
+    boost::mutex mtxCacheNode;
+    std::deque<uint256> queSubRoot;
+    queSubRoot.push_back(hashRoot);
+    while (!queSubRoot.empty() && queSubRoot.size() < CHECK_PARALLEL_SUBTREE_COUNT)
+    {
+        const uint256 hashNode = queSubRoot.front();
+        queSubRoot.pop_front();
+
+        std::vector<uint256> vSubNode;
+        if (!CheckNodeValue(hashNode, mapCacheNode, mtxCacheNode, vSubNode))
+        {
+            return false;
+        }
+        queSubRoot.insert(queSubRoot.end(), vSubNode.begin(), vSubNode.end());
+    }
+    if (queSubRoot.empty())
+    {
+        return true;
+    }
+
+    const std::vector<uint256> vSubRoot(queSubRoot.begin(), queSubRoot.end());
+    std::atomic<bool> fCheckOk(true);
+    ParallelComputer computer;
+    if (!computer.Execute(
+            vSubRoot.size(), [](const size_t i) { return i; },
+            [&](const size_t i) {
+                std::vector<uint256> vStack;
+                vStack.push_back(vSubRoot[i]);
+                while (!vStack.empty() && fCheckOk)
+                {
+                    const uint256 hashNode = vStack.back();
+                    vStack.pop_back();
+                    if (!CheckNodeValue(hashNode, mapCacheNode, mtxCacheNode, vStack))
+                    {
+                        fCheckOk = false;
+                    }
+                }
+            }))
+    {
+        return false;
+    }
+    return fCheckOk;
+}
+
+bool CTrieDB::CheckNodeValue(const uint256& hashNode, std::map<uint256, CTrieValue>& mapCacheNode, boost::mutex& mtxCacheNode, std::vector<uint256>& vSubNode)
+{
+    {
+        boost::unique_lock<boost::mutex> lock(mtxCacheNode);
+        if (mapCacheNode.count(hashNode) > 0)
+        {
+            return true;
+        }
+    }
+
+    CTrieValue value;
+    if (!GetDbNodeValue(hashNode, value))
+    {
+        StdLog("CTrieDB", "Check node value: Get Db Node Value fail, hash: %s", hashNode.GetHex().c_str());
+        return false;
+    }
+    if (hashNode != value.CalcHash())
+    {
+        StdLog("CTrieDB", "Check node value: Value hash error, hash: %s", hashNode.GetHex().c_str());
+        return false;
+    }
+
+    std::vector<uint256> vNext;
+    switch (value.type)
+    {
+    case CTrieValue::TYPE_BRANCH:
+        for (int i = 0; i < 16; i++)
+        {
+            uint256 hashValue = value.vaBranch.GetValueHash(i);
+            if (hashValue != 0)
+            {
+                vNext.push_back(hashValue);
+            }
+            uint256 hashSub = value.vaBranch.GetNextHash(i);
+            if (hashSub != 0)
+            {
+                vNext.push_back(hashSub);
+            }
+        }
+        break;
+    case CTrieValue::TYPE_EXTENSION:
+    {
+        uint256 hashValue = value.vaExtension.GetValueHash();
+        if (hashValue != 0)
+        {
+            vNext.push_back(hashValue);
+        }
+        uint256 hashSub = value.vaExtension.GetNextHash();
+        if (hashSub != 0)
+        {
+            vNext.push_back(hashSub);
+        }
+        break;
+    }
+    case CTrieValue::TYPE_VALUE:
+        break;
+    default:
+        StdLog("CTrieDB", "Check node value: type error, type: %d, hash: %s", value.type, hashNode.GetHex().c_str());
+        return false;
+    }
+
+    {
+        boost::unique_lock<boost::mutex> lock(mtxCacheNode);
+        if (!mapCacheNode.insert(make_pair(hashNode, value)).second)
+        {
+            // Another subtree task checked it meanwhile
+            return true;
+        }
+    }
+    vSubNode.insert(vSubNode.end(), vNext.begin(), vNext.end());
+    return true;
+}
+
+//////////////////////////////////////////
+bool CTrieDB::CreateTrieNodeList(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot, std::map<uint256, CTrieValue>& mapCacheNode, TrieUpdateFunc funcUpdate)
 {
     if (mapKvList.empty())
     {
@@ -608,7 +726,7 @@ bool CTrieDB::CreateTrieNodeList(const uint256& hashPrevRoot, const bytesmap& ma
     {
         bytes nbKeyNibble;
         CKeyNibble::Byte2Nibble(kv.first, 0, nbKeyNibble);
-        if (!AddNode(hashRoot, nbKeyNibble, kv.second, mapCacheNode))
+        if (!AddNode(hashRoot, kv.first, nbKeyNibble, kv.second, mapCacheNode, funcUpdate))
         {
             StdLog("CTrieDB", "Create trie node list: Add node fail, prev root: %s", hashPrevRoot.GetHex().c_str());
             return false;
@@ -618,7 +736,7 @@ bool CTrieDB::CreateTrieNodeList(const uint256& hashPrevRoot, const bytesmap& ma
     return true;
 }
 
-bool CTrieDB::AddNode(uint256& hashRoot, const bytes& nbKeyNibble, const bytes& btValue, std::map<uint256, CTrieValue>& mapCacheNode)
+bool CTrieDB::AddNode(uint256& hashRoot, const bytes& btKey, const bytes& nbKeyNibble, const bytes& btValue, std::map<uint256, CTrieValue>& mapCacheNode, TrieUpdateFunc& funcUpdate)
 {
     TRIE_NODE_PATH path;
     std::vector<uint256> vRemove;
@@ -685,6 +803,15 @@ bool CTrieDB::AddNode(uint256& hashRoot, const bytes& nbKeyNibble, const bytes&
                 {
                     if (fIsValue)
                     {
+                        bool fUpdate = true;
+                        if (!CheckNodeUpdate(kv.value.vaBranch.GetValueHash(kv.keyNew[0]), btKey, btValue, mapCacheNode, funcUpdate, fUpdate))
+                        {
+                            return false;
+                        }
+                        if (!fUpdate)
+                        {
+                            return true;
+                        }
                         if (hashPrev != 0 && kv.value.vaBranch.GetValueHash(kv.keyNew[0]) == hashPrev)
                         {
 #ifdef TEST_FLAG
@@ -710,6 +837,15 @@ bool CTrieDB::AddNode(uint256& hashRoot, const bytes& nbKeyNibble, const bytes&
             {
                 if (fIsValue)
                 {
+                    bool fUpdate = true;
+                    if (!CheckNodeUpdate(kv.value.vaExtension.GetValueHash(), btKey, btValue, mapCacheNode, funcUpdate, fUpdate))
+                    {
+                        return false;
+                    }
+                    if (!fUpdate)
+                    {
+                        return true;
+                    }
                     if (hashPrev != 0 && kv.value.vaExtension.GetValueHash() == hashPrev)
                     {
 #ifdef TEST_FLAG
@@ -753,6 +889,29 @@ bool CTrieDB::AddNode(uint256& hashRoot, const bytes& nbKeyNibble, const bytes&
     return true;
 }
 
+bool CTrieDB::CheckNodeUpdate(const uint256& hashOldValue, const bytes& btKey, const bytes& btValue, std::map<uint256, CTrieValue>& mapCacheNode, TrieUpdateFunc& funcUpdate, bool& fUpdate)
+{
+    fUpdate = true;
+    if (!funcUpdate)
+    {
+        return true;
+    }
+    if (hashOldValue == 0)
+    {
+        fUpdate = funcUpdate(btKey, btValue, nullptr);
+        return true;
+    }
+    CTrieValue valueOld;
+    bool fCache = false;
+    if (!GetNodeValue(hashOldValue, valueOld, fCache, mapCacheNode) || valueOld.type != CTrieValue::TYPE_VALUE)
+    {
+        StdLog("CTrieDB", "Check node update: Get old value fail, value hash: %s", hashOldValue.GetHex().c_str());
+        return false;
+    }
+    fUpdate = funcUpdate(btKey, btValue, &valueOld.vaValue);
+    return true;
+}
+
 bool CTrieDB::GetNodeValue(const uint256& hash, CTrieValue& value, bool& fCache, std::map<uint256, CTrieValue>& mapCacheNode)
 {
     if (hash == 0)
@@ -1183,6 +1342,52 @@ bool CTrieDB::GetKeyValue(const uint256& hashRoot, const bytes& nbKey, bytes& bt
     return true;
 }
 
+std::size_t CTrieDB::PrefetchTrieNode(const uint256& hashRoot, const std::size_t nMaxCount)
+{
+    mtbase::CReadLock rlock(rwAccess);
+
+    // The nodes nearest the root are read by every lookup, load them breadth-first
+    std::size_t nReadCount = 0;
+    std::deque<uint256> queNode;
+    if (hashRoot != 0)
+    {
+        queNode.push_back(hashRoot);
+    }
+    while (!queNode.empty() && nReadCount < nMaxCount)
+    {
+        boost::this_thread::interruption_point();
+
+        CTrieValue value;
+        if (!GetDbNodeValue(queNode.front(), value))
+        {
+            break;
+        }
+        queNode.pop_front();
+        nReadCount++;
+
+        if (value.type == CTrieValue::TYPE_BRANCH)
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                uint256 hashSub = value.vaBranch.GetNextHash(i);
+                if (hashSub != 0)
+                {
+                    queNode.push_back(hashSub);
+                }
+            }
+        }
+        else if (value.type == CTrieValue::TYPE_EXTENSION)
+        {
+            uint256 hashSub = value.vaExtension.GetNextHash();
+            if (hashSub != 0)
+            {
+                queNode.push_back(hashSub);
+            }
+        }
+    }
+    return nReadCount;
+}
+
 bool CTrieDB::WalkerAll(CBufStream& ssKey, CBufStream& ssValue, CTrieDBWalker& walker)
 {
     bytes key(ssKey.GetData(), ssKey.GetData() + ssKey.GetSize());
@@ -145,6 +145,10 @@ public:
 
 typedef std::vector<CTrieKeyValue> TRIE_NODE_PATH;
 
+// Called before a key is written, pbtOldValue is null when the key is not in the previous trie.
+// Returning false keeps the previous value of the key.
+typedef boost::function<bool(const bytes& btKey, const bytes& btNewValue, const bytes* pbtOldValue)> TrieUpdateFunc;
+
 //////////////////////////////////////////////////////////////
 // CTrieDBWalker
 
@@ -174,7 +178,7 @@ public:
     void Deinitialize();
     void Clear();
 
-    bool AddNewTrie(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot);
+    bool AddNewTrie(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot, TrieUpdateFunc funcUpdate = TrieUpdateFunc());
     bool CreateCacheTrie(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot, std::map<uint256, CTrieValue>& mapCacheNode);
     bool SaveCacheTrie(std::map<uint256, CTrieValue>& mapCacheNode);
     bool Retrieve(const uint256& hashRoot, const bytes& btKey, bytes& btValue);
@@ -183,6 +187,7 @@ public:
     bool CheckTrie(const std::vector<uint256>& vCheckRoot);
     bool CheckTrieNode(const uint256& hashRoot, std::map<uint256, CTrieValue>& mapCacheNode);
     bool VerifyTrieRootNode(const uint256& hashRoot);
+    std::size_t PrefetchTrieNode(const uint256& hashRoot, const std::size_t nMaxCount);
 
     bool WriteExtKv(mtbase::CBufStream& ssKey, mtbase::CBufStream& ssValue);
     bool ReadExtKv(mtbase::CBufStream& ssKey, mtbase::CBufStream& ssValue);
@@ -190,8 +195,9 @@ public:
     bool WalkThroughExtKv(mtbase::CBufStream& ssKeyBegin, mtbase::CBufStream& ssKeyPrefix, WalkerFunc walkerFunc);
 
 protected:
-    bool CreateTrieNodeList(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot, std::map<uint256, CTrieValue>& mapCacheNode);
-    bool AddNode(uint256& hashRoot, const bytes& nbKeyNibble, const bytes& btValue, std::map<uint256, CTrieValue>& mapCacheNode);
+    bool CreateTrieNodeList(const uint256& hashPrevRoot, const bytesmap& mapKvList, uint256& hashNewRoot, std::map<uint256, CTrieValue>& mapCacheNode, TrieUpdateFunc funcUpdate = TrieUpdateFunc());
+    bool AddNode(uint256& hashRoot, const bytes& btKey, const bytes& nbKeyNibble, const bytes& btValue, std::map<uint256, CTrieValue>& mapCacheNode, TrieUpdateFunc& funcUpdate);
+    bool CheckNodeUpdate(const uint256& hashOldValue, const bytes& btKey, const bytes& btValue, std::map<uint256, CTrieValue>& mapCacheNode, TrieUpdateFunc& funcUpdate, bool& fUpdate);
     bool GetNodeValue(const uint256& hash, CTrieValue& value, bool& fCache, std::map<uint256, CTrieValue>& mapCacheNode);
     bool SetDbNodeValue(const uint256& hash, const CTrieValue& value);
     bool GetDbNodeValue(const uint256& hash, CTrieValue& value);
@@ -203,8 +209,15 @@ protected:
     bool WalkerAll(mtbase::CBufStream& ssKey, mtbase::CBufStream& ssValue, CTrieDBWalker& walker);
     bool WalkThroughNode(const uint256& hashNode, const bytes& nbKeyPrefix, bytes& nbBeginKey, const bool fReverse, const bytes& nbPrevKey,
                          CTrieDBWalker& walker, std::map<uint256, CTrieValue>& mapCacheNode, const uint32 nDepth, bool& fWalkOver);
+    bool CheckRootNode(const uint256& hashRoot, std::map<uint256, CTrieValue>& mapCacheNode);
+    // Read and verify a node not yet in mapCacheNode, add it and append its children to vSubNode
+    bool CheckNodeValue(const uint256& hashNode, std::map<uint256, CTrieValue>& mapCacheNode, boost::mutex& mtxCacheNode, std::vector<uint256>& vSubNode);
 
 protected:
+    enum
+    {
+        CHECK_PARALLEL_SUBTREE_COUNT = 64
+    };
     mtbase::CRWAccess rwAccess;
 };
 
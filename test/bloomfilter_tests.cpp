@@ -8,14 +8,17 @@
 
 #include "crypto.h"
 #include "test_big.h"
+#include "transaction.h"
 
 using namespace std;
 using namespace mtbase;
+using namespace metabasenet;
 using namespace metabasenet::crypto;
 
 //./build-release/test/test_big --log_level=all --run_test=bloomfilter_tests/basetest
 //./build-release/test/test_big --log_level=all --run_test=bloomfilter_tests/stresstest
 //./build-release/test/test_big --log_level=all --run_test=bloomfilter_tests/stresstestbytes
+//./build-release/test/test_big --log_level=all --run_test=bloomfilter_tests/logsbloom
 
 BOOST_FIXTURE_TEST_SUITE(bloomfilter_tests, BasicUtfSetup)
 
@@ -115,4 +118,60 @@ BOOST_AUTO_TEST_CASE(stresstestbytes)
     }
 }
 
+BOOST_AUTO_TEST_CASE(logsbloom)
+{
+    // Fixed logs: repeated addresses and topics, and a log without topics
+    CTransactionReceipt receipt;
+    for (uint64 i = 0; i < 6; i++)
+    {
+        CTransactionLogs logs;
+        uint64 nAddress = i % 4;
+        logs.address = CDestination(CryptoHash(&nAddress, sizeof(nAddress)));
+        for (uint64 j = 0; j < i % 4; j++)
+        {
+            uint64 nTopic = 0x100 + (i + j) % 5;
+            logs.topics.push_back(CryptoHash(&nTopic, sizeof(nTopic)));
+        }
+        receipt.vLogs.push_back(logs);
+    }
+
+    // Receipt bloom: one 2048-bit filter of all logs, formerly the union of the per-log filters
+    uint2048 nOldLogsBloom;
+    for (const CTransactionLogs& logs : receipt.vLogs)
+    {
+        nOldLogsBloom |= logs.GetLogsBloom();
+    }
+    receipt.CalcLogsBloom();
+    BOOST_CHECK(nOldLogsBloom != uint2048());
+    BOOST_CHECK(receipt.nLogsBloom == nOldLogsBloom);
+
+    CTransactionReceipt receiptEmpty;
+    receiptEmpty.CalcLogsBloom();
+    BOOST_CHECK(receiptEmpty.nLogsBloom == uint2048());
+
+    // Block bloom: the flat set gives the bytes of the former std::set<bytes>
+    set<bytes> setOldBloomData;
+    CBloomDataSet setBloomData;
+    for (const CTransactionLogs& logs : receipt.vLogs)
+    {
+        setOldBloomData.insert(logs.address.GetBytes());
+        for (const uint256& t : logs.topics)
+        {
+            setOldBloomData.insert(t.GetBytes());
+        }
+    }
+    receipt.GetBloomDataSet(setBloomData);
+
+    CNhBloomFilter bf(setOldBloomData.size() * 4);
+    for (const bytes& bt : setOldBloomData)
+    {
+        bf.Add(bt);
+    }
+    bytes btOldBloomData;
+    bf.GetData(btOldBloomData);
+    bytes btBloomData;
+    setBloomData.GetBloomData(btBloomData);
+    BOOST_CHECK(!btBloomData.empty() && btBloomData == btOldBloomData);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
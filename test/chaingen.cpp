@@ -0,0 +1,217 @@
+// Copyright (c) 2021-2023 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "chaingen.h"
+
+#include "core.h"
+#include "crypto.h"
+#include "mevm/evmexec.h"
+#include "template/delegate.h"
+#include "template/vote.h"
+
+using namespace std;
+using namespace mtbase;
+using namespace metabasenet;
+using namespace metabasenet::crypto;
+using namespace metabasenet::storage;
+
+static const uint256 ACCOUNT_FUND_AMOUNT = 10000 * COIN;
+static const uint256 TRANSFER_AMOUNT(10, TOKEN_DECIMAL_DIGIT - 3);
+static const uint256 VOTE_AMOUNT = COIN;
+static const uint256 ERC20_TRANSFER_AMOUNT = COIN;
+static const uint64 TRANSFER_GAS_LIMIT = 100000;
+static const uint64 ERC20_CREATE_GAS_LIMIT = 5000000;
+static const uint64 ERC20_CALL_GAS_LIMIT = 200000;
+
+CChainGenerator::CChainGenerator(CBlockBase& dbBlockBaseIn, const size_t nAccountCount, const uint32 nSeed)
+  : dbBlockBase(dbBlockBaseIn), rand(nSeed), pIndexLast(nullptr)
+{
+    uint64 n = nSeed;
+    destOwner = CDestination(CryptoHash(&n, sizeof(n)));
+    for (size_t i = 0; i < nAccountCount; i++)
+    {
+        n = ((uint64)nSeed << 32) + i + 1;
+        vAccount.push_back(CDestination(CryptoHash(&n, sizeof(n))));
+    }
+}
+
+void CChainGenerator::CreateGenesisBlock(CBlock& blockGenesis) const
+{
+    CCoreProtocol::CreateGenesisBlock(false, DEF_GENESIS_CHAINID, destOwner.ToString(), blockGenesis);
+}
+
+bool CChainGenerator::Initiate(const CBlock& blockGenesis, const bytes& btErc20Code, CBlock& block)
+{
+    hashFork = blockGenesis.GetHash();
+    if (!dbBlockBase.Initiate(hashFork, blockGenesis, uint256(1)) || !dbBlockBase.RetrieveIndex(hashFork, &pIndexLast))
+    {
+        return false;
+    }
+
+    vector<CTransaction> vtx;
+    for (const CDestination& dest : vAccount)
+    {
+        vtx.push_back(CreateTransfer(destOwner, dest, ACCOUNT_FUND_AMOUNT));
+    }
+
+    CTemplatePtr ptrDelegate = CTemplate::CreateTemplatePtr(new CTemplateDelegate(destOwner, destOwner, 500));
+    if (!ptrDelegate)
+    {
+        return false;
+    }
+    destDelegate = CDestination(ptrDelegate->GetTemplateId());
+    vtx.push_back(CreateTransfer(destOwner, destDelegate, DELEGATE_PROOF_OF_STAKE_ENROLL_MINIMUM_AMOUNT,
+                                 CAddressContext(CTemplateAddressContext(string(), string(), ptrDelegate->GetTemplateType(), ptrDelegate->Export()))));
+
+    if (!btErc20Code.empty())
+    {
+        CTransaction tx;
+        tx.SetTxType(CTransaction::TX_TOKEN);
+        tx.SetChainId(DEF_GENESIS_CHAINID);
+        tx.SetNonce(GetNextNonce(destOwner));
+        tx.SetFromAddress(destOwner);
+        tx.SetGasPrice(MIN_GAS_PRICE);
+        tx.SetGasLimit(uint256(ERC20_CREATE_GAS_LIMIT));
+
+        CBufStream ss;
+        ss << CODE_TYPE_CONTRACT << CTxContractData(btErc20Code, false);
+        bytes btCodeData;
+        ss.GetData(btCodeData);
+        tx.AddTxData(CTransaction::DF_CREATE_CODE, btCodeData);
+
+        destErc20 = CreateContractAddressByNonce(destOwner, tx.GetNonce());
+        vtx.push_back(tx);
+    }
+
+    return MakeBlock(vtx, block);
+}
+
+bool CChainGenerator::MakeBlock(const CBlockTxMix& mix, CBlock& block)
+{
+    vector<CTransaction> vtx;
+    const size_t nCount = vAccount.size();
+    for (size_t i = 0; i < mix.nTransfer && nCount > 1; i++)
+    {
+        const size_t nFrom = rand() % nCount;
+        const size_t nTo = (nFrom + 1 + rand() % (nCount - 1)) % nCount;
+        vtx.push_back(CreateTransfer(vAccount[nFrom], vAccount[nTo], TRANSFER_AMOUNT));
+    }
+    for (size_t i = 0; i < mix.nErc20 && nCount > 0 && !destErc20.IsNull(); i++)
+    {
+        vtx.push_back(CreateErc20Transfer(vAccount[rand() % nCount], ERC20_TRANSFER_AMOUNT));
+    }
+    for (size_t i = 0; i < mix.nVote && nCount > 0 && !destDelegate.IsNull(); i++)
+    {
+        vtx.push_back(CreateVote(vAccount[rand() % nCount], VOTE_AMOUNT));
+    }
+    return MakeBlock(vtx, block);
+}
+
+bool CChainGenerator::MakeBlock(const vector<CTransaction>& vtx, CBlock& block)
+{
+    if (!CreateBlock(vtx, block))
+    {
+        return false;
+    }
+
+    std::map<CDestination, CAddressContext> mapAddressContext;
+    if (!dbBlockBase.GetBlockAddress(hashFork, block.GetHash(), block, mapAddressContext))
+    {
+        return false;
+    }
+    uint256 nTotalMintReward;
+    if (!dbBlockBase.CreateBlockStateRoot(hashFork, block, pIndexLast->GetStateRoot(), pIndexLast->GetBlockTime(), block.hashStateRoot, block.hashReceiptsRoot,
+                                          block.nGasUsed, block.btBloomData, nTotalMintReward, mapAddressContext))
+    {
+        return false;
+    }
+    block.AddMintRewardProof(nTotalMintReward);
+    block.hashMerkleRoot = block.CalcMerkleTreeRoot();
+    return StoreBlock(block);
+}
+
+bool CChainGenerator::CreateBlock(const vector<CTransaction>& vtx, CBlock& block) const
+{
+    if (pIndexLast == nullptr)
+    {
+        return false;
+    }
+
+    block.SetNull();
+    block.nType = CBlock::BLOCK_PRIMARY;
+    block.hashPrev = pIndexLast->GetBlockHash();
+    block.nNumber = pIndexLast->GetBlockNumber() + 1;
+    block.nSlot = 0;
+    block.SetBlockTime(pIndexLast->GetBlockTime() + BLOCK_TARGET_SPACING);
+    block.nGasLimit = MAX_BLOCK_GAS_LIMIT;
+
+    CTransaction& txMint = block.txMint;
+    txMint.SetTxType(CTransaction::TX_STAKE);
+    txMint.SetNonce(block.nNumber);
+    txMint.SetChainId(DEF_GENESIS_CHAINID);
+    txMint.SetToAddress(destOwner);
+    block.AddMintCoinProof(BBCP_REWARD_INIT);
+    block.vtx = vtx;
+    return true;
+}
+
+CTransaction CChainGenerator::CreateTransfer(const CDestination& destFrom, const CDestination& destTo, const uint256& nAmount, const CAddressContext& ctxTo)
+{
+    CTransaction tx;
+    tx.SetTxType(CTransaction::TX_TOKEN);
+    tx.SetChainId(DEF_GENESIS_CHAINID);
+    tx.SetNonce(GetNextNonce(destFrom));
+    tx.SetFromAddress(destFrom);
+    tx.SetToAddress(destTo);
+    tx.SetAmount(nAmount);
+    tx.SetGasPrice(MIN_GAS_PRICE);
+    tx.SetGasLimit(uint256(TRANSFER_GAS_LIMIT));
+    tx.SetToAddressData(ctxTo);
+    return tx;
+}
+
+CTransaction CChainGenerator::CreateErc20Transfer(const CDestination& destTo, const uint256& nAmount)
+{
+    // transfer(address,uint256)
+    bytes btParam = ParseHexString("a9059cbb");
+    btParam.resize(btParam.size() + 12, 0);
+    const bytes btTo = destTo.GetBytes();
+    btParam.insert(btParam.end(), btTo.begin(), btTo.end());
+    const bytes btAmount = nAmount.ToBigEndian();
+    btParam.insert(btParam.end(), btAmount.begin(), btAmount.end());
+
+    CTransaction tx;
+    tx.SetTxType(CTransaction::TX_TOKEN);
+    tx.SetChainId(DEF_GENESIS_CHAINID);
+    tx.SetNonce(GetNextNonce(destOwner));
+    tx.SetFromAddress(destOwner);
+    tx.SetToAddress(destErc20);
+    tx.SetGasPrice(MIN_GAS_PRICE);
+    tx.SetGasLimit(uint256(ERC20_CALL_GAS_LIMIT));
+    tx.AddTxData(CTransaction::DF_CONTRACTPARAM, btParam);
+    return tx;
+}
+
+CTransaction CChainGenerator::CreateVote(const CDestination& destFrom, const uint256& nAmount)
+{
+    CTemplatePtr ptrVote = CTemplate::CreateTemplatePtr(new CTemplateVote(destDelegate, destFrom, 0));
+    return CreateTransfer(destFrom, CDestination(ptrVote->GetTemplateId()), nAmount,
+                          CAddressContext(CTemplateAddressContext(string(), string(), ptrVote->GetTemplateType(), ptrVote->Export())));
+}
+
+uint64 CChainGenerator::GetNextNonce(const CDestination& dest)
+{
+    return ++mapNonce[dest];
+}
+
+bool CChainGenerator::StoreBlock(CBlock& block)
+{
+    const uint256 hashBlock = block.GetHash();
+    CBlockChainUpdate update;
+    if (!dbBlockBase.StorageNewBlock(hashFork, hashBlock, CBlockEx(block, uint256(1)), update))
+    {
+        return false;
+    }
+    return dbBlockBase.RetrieveIndex(hashBlock, &pIndexLast);
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2021-2023 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TEST_CHAINGEN_H
+#define TEST_CHAINGEN_H
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "blockbase.h"
+
+// Builds a deterministic chain of primary blocks on top of a CBlockBase, without consensus.
+// Blocks carry the state and receipt roots calculated by CBlockBase, so they can be imported
+// into another CBlockBase with StorageNewBlock, but they have no delegate proof or signature.
+class CChainGenerator
+{
+public:
+    class CBlockTxMix
+    {
+    public:
+        CBlockTxMix(const std::size_t nTransferIn = 0, const std::size_t nErc20In = 0, const std::size_t nVoteIn = 0)
+          : nTransfer(nTransferIn), nErc20(nErc20In), nVote(nVoteIn) {}
+
+    public:
+        std::size_t nTransfer; // transfers between pubkey accounts
+        std::size_t nErc20;    // ERC20 transfer calls
+        std::size_t nVote;     // transfers to vote templates
+    };
+
+    CChainGenerator(metabasenet::storage::CBlockBase& dbBlockBaseIn, const std::size_t nAccountCount = 64, const uint32 nSeed = 1);
+
+    // The genesis block funds the owner, the CBlockBase is initialized with its hash
+    void CreateGenesisBlock(metabasenet::CBlock& blockGenesis) const;
+    // Store the genesis block, then make a block funding the accounts and the delegate,
+    // and deploying the ERC20 contract when code is given (EVM bytecode)
+    bool Initiate(const metabasenet::CBlock& blockGenesis, const bytes& btErc20Code, metabasenet::CBlock& block);
+    // Create and store the next block
+    bool MakeBlock(const CBlockTxMix& mix, metabasenet::CBlock& block);
+    // Create and store the next block with the given transactions
+    bool MakeBlock(const std::vector<metabasenet::CTransaction>& vtx, metabasenet::CBlock& block);
+    // Create the header and mint tx of the next block with the given transactions, no roots
+    bool CreateBlock(const std::vector<metabasenet::CTransaction>& vtx, metabasenet::CBlock& block) const;
+
+    metabasenet::CTransaction CreateTransfer(const metabasenet::CDestination& destFrom, const metabasenet::CDestination& destTo, const uint256& nAmount,
+                                             const metabasenet::CAddressContext& ctxTo = metabasenet::CAddressContext(metabasenet::CPubkeyAddressContext()));
+    metabasenet::CTransaction CreateErc20Transfer(const metabasenet::CDestination& destTo, const uint256& nAmount);
+    metabasenet::CTransaction CreateVote(const metabasenet::CDestination& destFrom, const uint256& nAmount);
+
+    const uint256& GetForkHash() const
+    {
+        return hashFork;
+    }
+    const metabasenet::CDestination& GetOwner() const
+    {
+        return destOwner;
+    }
+    const std::vector<metabasenet::CDestination>& GetAccounts() const
+    {
+        return vAccount;
+    }
+    const metabasenet::CBlockIndex* GetLastIndex() const
+    {
+        return pIndexLast;
+    }
+
+protected:
+    uint64 GetNextNonce(const metabasenet::CDestination& dest);
+    bool StoreBlock(metabasenet::CBlock& block);
+
+protected:
+    metabasenet::storage::CBlockBase& dbBlockBase;
+    std::mt19937 rand;
+    uint256 hashFork;
+    metabasenet::CBlockIndex* pIndexLast;
+    metabasenet::CDestination destOwner;
+    metabasenet::CDestination destDelegate;
+    metabasenet::CDestination destErc20;
+    std::vector<metabasenet::CDestination> vAccount;
+    std::map<metabasenet::CDestination, uint64> mapNonce;
+};
+
+#endif // TEST_CHAINGEN_H
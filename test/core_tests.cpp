@@ -0,0 +1,97 @@
+// Copyright (c) 2021-2023 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "core.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_big.h"
+
+using namespace std;
+using namespace mtbase;
+using namespace metabasenet;
+
+//./build-release/test/test_big --log_level=all --run_test=core_tests/prevalidatedbody
+//./build-release/test/test_big --log_level=all --run_test=core_tests/merkletree
+
+BOOST_FIXTURE_TEST_SUITE(core_tests, BasicUtfSetup)
+
+static void CreateTestBlock(CBlock& block, const size_t nTxCount)
+{
+    block.nType = CBlock::BLOCK_PRIMARY;
+    block.nTimeStamp = GetTime();
+    block.txMint.SetTxType(CTransaction::TX_STAKE);
+    for (size_t i = 0; i < nTxCount; i++)
+    {
+        CTransaction tx;
+        tx.SetTxType(CTransaction::TX_TOKEN);
+        tx.SetNonce(i + 1);
+        block.vtx.push_back(tx);
+    }
+    block.hashMerkleRoot = block.CalcMerkleTreeRoot();
+}
+
+BOOST_AUTO_TEST_CASE(prevalidatedbody)
+{
+    CCoreProtocol core;
+    const uint256 hashFork;
+
+    // The prevalidated result is found by the block hash, which does not cover the body,
+    // so ValidateBlock checks the body given to it in full
+    CBlock blockReplaced;
+    CreateTestBlock(blockReplaced, 4);
+    const uint256 hashBlock = blockReplaced.GetHash();
+    blockReplaced.vtx[1].SetNonce(100);
+    BOOST_CHECK(blockReplaced.GetHash() == hashBlock);
+    BOOST_CHECK(core.ValidateBlock(hashFork, uint256(), blockReplaced) == ERR_BLOCK_TXHASH_MISMATCH);
+
+    CBlock blockDuplicated;
+    CreateTestBlock(blockDuplicated, 4);
+    blockDuplicated.vtx[3] = blockDuplicated.vtx[2];
+    blockDuplicated.hashMerkleRoot = blockDuplicated.CalcMerkleTreeRoot();
+    BOOST_CHECK(core.ValidateBlock(hashFork, uint256(), blockDuplicated) == ERR_BLOCK_DUPLICATED_TRANSACTION);
+
+    // Nor the signature
+    CBlock blockOversize;
+    CreateTestBlock(blockOversize, 4);
+    const uint256 hashOversize = blockOversize.GetHash();
+    blockOversize.vchSig.assign(MAX_BLOCK_SIZE, 0);
+    BOOST_CHECK(blockOversize.GetHash() == hashOversize);
+    BOOST_CHECK(core.ValidateBlock(hashFork, uint256(), blockOversize) == ERR_BLOCK_OVERSIZE);
+}
+
+BOOST_AUTO_TEST_CASE(merkletree)
+{
+    // Leaf counts below and above the parallel threshold, odd counts repeat the last node
+    for (const size_t nLeafCount : { (size_t)1, (size_t)5, (size_t)CMerkleTree::PARALLEL_HASH_MIN_COUNT * 2 + 1 })
+    {
+        vector<bytes> vData;
+        for (size_t i = 0; i < nLeafCount; i++)
+        {
+            vData.push_back(bytes(1 + i % 7, (uint8)i));
+        }
+        vector<uint256> vHash;
+        CMerkleTree::CalcDataHashList(vData, vHash);
+        BOOST_REQUIRE(vHash.size() == nLeafCount);
+
+        vector<uint256> vLevel;
+        for (const bytes& data : vData)
+        {
+            vLevel.push_back(crypto::CryptoHash(data.data(), data.size()));
+        }
+        BOOST_CHECK(vHash == vLevel);
+        while (vLevel.size() > 1)
+        {
+            vector<uint256> vNext;
+            for (size_t i = 0; i < vLevel.size(); i += 2)
+            {
+                vNext.push_back(crypto::CryptoHash(vLevel[i], vLevel[min(i + 1, vLevel.size() - 1)]));
+            }
+            vLevel.swap(vNext);
+        }
+        BOOST_CHECK(CReceiptMerkleTree::BuildMerkleTree(vHash) == vLevel[0]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
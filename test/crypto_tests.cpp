@@ -143,4 +143,19 @@ BOOST_AUTO_TEST_CASE(makekey)
 //     std::cout << "multisign verify2 count : " << count << "; time per count : " << verifyTime2 / count << "us.; time per key: " << verifyTime2 / signCount << "us." << std::endl;
 // }
 
+BOOST_AUTO_TEST_CASE(pairhash)
+{
+    for (int i = 0; i < 64; i++)
+    {
+        uint256 h1, h2;
+        randombytes_buf(h1.begin(), h1.size());
+        randombytes_buf(h2.begin(), h2.size());
+
+        unsigned char buf[64];
+        memcpy(buf, h1.begin(), 32);
+        memcpy(buf + 32, h2.begin(), 32);
+        BOOST_CHECK(CryptoHash(h1, h2) == CryptoHash(buf, sizeof(buf)));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
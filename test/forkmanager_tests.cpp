@@ -0,0 +1,126 @@
+// Copyright (c) 2022-2024 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "forkmanager.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_big.h"
+
+using namespace std;
+using namespace mtbase;
+using namespace metabasenet;
+
+//./build-release/test/test_big --log_level=all --run_test=forkmanager_tests/forkgraphdelta
+//./build-release/test/test_big --log_level=all --run_test=forkmanager_tests/forkgraphload
+
+BOOST_FIXTURE_TEST_SUITE(forkmanager_tests, BasicUtfSetup)
+
+static CForkContext CreateForkContext(const uint256& hashFork, const uint256& hashParent, const uint256& hashJoint)
+{
+    CForkContext ctxt;
+    ctxt.hashFork = hashFork;
+    ctxt.hashParent = hashParent;
+    ctxt.hashJoint = hashJoint;
+    return ctxt;
+}
+
+static map<uint256, CForkContext> CreateForkContextMap(const vector<CForkContext>& vCtxt)
+{
+    map<uint256, CForkContext> mapForkCtxt;
+    for (const CForkContext& ctxt : vCtxt)
+    {
+        mapForkCtxt.insert(make_pair(ctxt.hashFork, ctxt));
+    }
+    return mapForkCtxt;
+}
+
+static void CheckSameGraph(const CForkGraph& graph, const CForkGraph& graphExpected, const vector<uint256>& vHash)
+{
+    BOOST_CHECK(graph.GetForks().size() == graphExpected.GetForks().size());
+    for (const uint256& hash : vHash)
+    {
+        BOOST_CHECK(graph.ExistFork(hash) == graphExpected.ExistFork(hash));
+        BOOST_CHECK(graph.ExistChildFork(hash) == graphExpected.ExistChildFork(hash));
+        vector<uint256> vJoint, vJointExpected;
+        graph.ListJointFork(hash, vJoint);
+        graphExpected.ListJointFork(hash, vJointExpected);
+        sort(vJoint.begin(), vJoint.end());
+        sort(vJointExpected.begin(), vJointExpected.end());
+        BOOST_CHECK(vJoint == vJointExpected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(forkgraphdelta)
+{
+    const uint256 hashGenesis(1), hashForkA(2), hashForkB(3), hashForkC(4);
+    const uint256 hashJoint1(0x11), hashJoint2(0x12);
+    const vector<uint256> vHash = { hashGenesis, hashForkA, hashForkB, hashForkC, hashJoint1, hashJoint2 };
+
+    const CForkContext ctxtGenesis = CreateForkContext(hashGenesis, uint256(), uint256());
+    const CForkContext ctxtA = CreateForkContext(hashForkA, hashGenesis, hashJoint1);
+    const CForkContext ctxtB = CreateForkContext(hashForkB, hashGenesis, hashJoint1);
+    const CForkContext ctxtC = CreateForkContext(hashForkC, hashForkA, hashJoint2);
+
+    CForkGraph graph;
+    vector<uint256> vNewFork;
+    graph.Load(CreateForkContextMap({ ctxtGenesis, ctxtA, ctxtB }), vNewFork);
+
+    // delta: C created on A, B removed, then a duplicated create is ignored
+    BOOST_CHECK(graph.AddFork(ctxtC));
+    graph.RemoveFork(hashForkB);
+    BOOST_CHECK(!graph.AddFork(ctxtC));
+    graph.RemoveFork(hashForkB);
+
+    CForkGraph graphExpected;
+    vNewFork.clear();
+    graphExpected.Load(CreateForkContextMap({ ctxtGenesis, ctxtA, ctxtC }), vNewFork);
+    CheckSameGraph(graph, graphExpected, vHash);
+
+    vector<uint256> vJoint;
+    graph.ListJointFork(hashJoint1, vJoint);
+    BOOST_CHECK(vJoint.size() == 1 && vJoint[0] == hashForkA);
+    BOOST_CHECK(graph.ExistChildFork(hashForkA) && !graph.ExistChildFork(hashForkC));
+
+    // the last child removed
+    graph.RemoveFork(hashForkA);
+    graph.RemoveFork(hashForkC);
+    BOOST_CHECK(!graph.ExistChildFork(hashGenesis) && !graph.ExistChildFork(hashForkA));
+    vJoint.clear();
+    graph.ListJointFork(hashJoint1, vJoint);
+    BOOST_CHECK(vJoint.empty());
+}
+
+BOOST_AUTO_TEST_CASE(forkgraphload)
+{
+    const uint256 hashGenesis(1), hashForkA(2), hashForkB(3), hashForkC(4);
+    const CForkContext ctxtGenesis = CreateForkContext(hashGenesis, uint256(), uint256());
+    const CForkContext ctxtA = CreateForkContext(hashForkA, hashGenesis, uint256(0x11));
+    const CForkContext ctxtB = CreateForkContext(hashForkB, hashGenesis, uint256(0x12));
+    const CForkContext ctxtC = CreateForkContext(hashForkC, hashForkA, uint256(0x13));
+
+    // not loaded: diffed against an empty graph, every fork is new
+    CForkGraph graph;
+    BOOST_CHECK(!graph.IsLoaded());
+    vector<uint256> vNewFork;
+    graph.Load(CreateForkContextMap({ ctxtGenesis, ctxtA, ctxtB }), vNewFork);
+    BOOST_CHECK(graph.IsLoaded());
+    BOOST_CHECK(vNewFork == vector<uint256>({ hashGenesis, hashForkA, hashForkB }));
+
+    // reload: only the forks not in the previous graph
+    vNewFork.clear();
+    graph.Load(CreateForkContextMap({ ctxtGenesis, ctxtA, ctxtC }), vNewFork);
+    BOOST_CHECK(vNewFork == vector<uint256>({ hashForkC }));
+    BOOST_CHECK(!graph.ExistFork(hashForkB) && graph.ExistFork(hashForkC));
+    BOOST_CHECK(graph.ExistChildFork(hashForkA));
+
+    // cleared on halt, the next load reports everything again
+    graph.Clear();
+    BOOST_CHECK(!graph.IsLoaded() && graph.GetForks().empty());
+    vNewFork.clear();
+    graph.Load(CreateForkContextMap({ ctxtGenesis, ctxtA, ctxtC }), vNewFork);
+    BOOST_CHECK(vNewFork.size() == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
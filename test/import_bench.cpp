@@ -0,0 +1,188 @@
+// Copyright (c) 2021-2023 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <boost/filesystem.hpp>
+#include <cinttypes>
+#include <fstream>
+#include <iostream>
+
+#include "chaingen.h"
+
+using namespace std;
+using namespace mtbase;
+using namespace metabasenet;
+using namespace metabasenet::storage;
+using namespace boost::filesystem;
+
+// Generates a synthetic chain, then times importing it into a fresh database through
+// CBlockBase::StorageNewBlock. The import runs the stages of block storage, execution,
+// trie commits and LevelDB writes, consensus checks are not run (the blocks carry no proof).
+//
+//./build-release/test/import_bench -blocks=1000 -transfer=200 -erc20=50 -vote=20 -fulldb
+//   -erc20code=<file> : EVM ERC20 bytecode in hex, default test/testscript/web3test/solcode/erc20/CodeWithJoe.bin
+//   -datadir=<dir>    : work directory, removed at the end, default a temp directory
+
+static bool ParseArg(const string& strArg, const string& strName, string& strValue)
+{
+    const string strPrefix = "-" + strName + "=";
+    if (strArg.compare(0, strPrefix.size(), strPrefix) == 0)
+    {
+        strValue = strArg.substr(strPrefix.size());
+        return true;
+    }
+    return false;
+}
+
+static bool ReadHexFile(const string& strFile, bytes& btData)
+{
+    std::ifstream ifs(strFile);
+    if (!ifs)
+    {
+        return false;
+    }
+    string strHex;
+    ifs >> strHex;
+    if (strHex.compare(0, 2, "0x") == 0)
+    {
+        strHex = strHex.substr(2);
+    }
+    btData = ParseHexString(strHex);
+    return !btData.empty();
+}
+
+int main(int argc, char** argv)
+{
+    size_t nBlockCount = 1000;
+    CChainGenerator::CBlockTxMix mix(200, 50, 20);
+    bool fFullDb = false;
+    string strErc20Code = "test/testscript/web3test/solcode/erc20/CodeWithJoe.bin";
+    path pathData = temp_directory_path() / unique_path();
+
+    for (int i = 1; i < argc; i++)
+    {
+        const string strArg(argv[i]);
+        string strValue;
+        if (ParseArg(strArg, "blocks", strValue))
+        {
+            nBlockCount = stoul(strValue);
+        }
+        else if (ParseArg(strArg, "transfer", strValue))
+        {
+            mix.nTransfer = stoul(strValue);
+        }
+        else if (ParseArg(strArg, "erc20", strValue))
+        {
+            mix.nErc20 = stoul(strValue);
+        }
+        else if (ParseArg(strArg, "vote", strValue))
+        {
+            mix.nVote = stoul(strValue);
+        }
+        else if (ParseArg(strArg, "erc20code", strValue))
+        {
+            strErc20Code = strValue;
+        }
+        else if (ParseArg(strArg, "datadir", strValue))
+        {
+            pathData = path(strValue);
+        }
+        else if (strArg == "-fulldb")
+        {
+            fFullDb = true;
+        }
+        else
+        {
+            cerr << "Unknown argument: " << strArg << endl;
+            return 1;
+        }
+    }
+
+    bytes btErc20Code;
+    if (mix.nErc20 > 0 && !ReadHexFile(strErc20Code, btErc20Code))
+    {
+        cerr << "Read ERC20 code fail: " << strErc20Code << endl;
+        return 1;
+    }
+
+    // Generate
+    CBlock blockGenesis;
+    vector<CBlock> vBlock;
+    {
+        CBlockBase dbGen;
+        CChainGenerator gen(dbGen);
+        gen.CreateGenesisBlock(blockGenesis);
+        if (!dbGen.Initialize(pathData / "gen", blockGenesis.GetHash(), false, false, false))
+        {
+            cerr << "Initialize generate db fail" << endl;
+            return 1;
+        }
+        CBlock block;
+        bool fRet = gen.Initiate(blockGenesis, btErc20Code, block);
+        if (fRet)
+        {
+            vBlock.push_back(block);
+        }
+        while (fRet && vBlock.size() < nBlockCount)
+        {
+            fRet = gen.MakeBlock(mix, block);
+            if (fRet)
+            {
+                vBlock.push_back(block);
+            }
+        }
+        dbGen.Deinitialize();
+        if (!fRet)
+        {
+            cerr << "Generate block fail, height: " << vBlock.size() + 1 << endl;
+            remove_all(pathData);
+            return 1;
+        }
+    }
+    printf("Generated blocks: %zu, tx per block: transfer %zu, erc20 %zu, vote %zu\n",
+           vBlock.size(), mix.nTransfer, mix.nErc20, mix.nVote);
+
+    // Import
+    const uint256 hashFork = blockGenesis.GetHash();
+    CBlockBase dbImport;
+    if (!dbImport.Initialize(pathData / "import", hashFork, fFullDb, false, false)
+        || !dbImport.Initiate(hashFork, blockGenesis, uint256(1)))
+    {
+        cerr << "Initialize import db fail" << endl;
+        remove_all(pathData);
+        return 1;
+    }
+
+    CSaveBlockStat stat;
+    dbImport.GetSaveBlockStat(stat, true);
+
+    CTicks tImport;
+    for (const CBlock& block : vBlock)
+    {
+        CBlockChainUpdate update;
+        if (!dbImport.StorageNewBlock(hashFork, block.GetHash(), CBlockEx(block, uint256(1)), update))
+        {
+            cerr << "Import block fail, block: " << block.GetHash().ToString() << endl;
+            dbImport.Deinitialize();
+            remove_all(pathData);
+            return 1;
+        }
+    }
+    const int64 nImportTicks = tImport.Elapse();
+
+    dbImport.GetSaveBlockStat(stat);
+    dbImport.Deinitialize();
+    remove_all(pathData);
+
+    // CTicks are microseconds
+    const double dSeconds = (double)nImportTicks / 1000000;
+    printf("Import: blocks: %" PRIu64 ", txs: %" PRIu64 ", fulldb: %s, time: %.3fs, blocks/s: %.2f, tx/s: %.2f\n",
+           stat.nBlockCount, stat.nTxCount, (fFullDb ? "true" : "false"), dSeconds,
+           (dSeconds > 0 ? stat.nBlockCount / dSeconds : 0.0), (dSeconds > 0 ? stat.nTxCount / dSeconds : 0.0));
+    for (int i = 0; i < CSaveBlockStat::STAGE_MAX; i++)
+    {
+        printf("  stage [%s]: %.3fms, %.1f%%\n", CSaveBlockStat::GetStageName(i), (double)stat.nStageTicks[i] / 1000,
+               (nImportTicks > 0 ? stat.nStageTicks[i] * 100.0 / nImportTicks : 0.0));
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2021-2023 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "netchn.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_big.h"
+
+using namespace std;
+using namespace mtbase;
+using namespace metabasenet;
+
+//./build-release/test/test_big --log_level=all --run_test=netchn_tests/ratelimit
+
+BOOST_FIXTURE_TEST_SUITE(netchn_tests, BasicUtfSetup)
+
+BOOST_AUTO_TEST_CASE(ratelimit)
+{
+    const int64 nTime = 1000000;
+
+    // burst: starts full, granted up to the burst, then nothing at the same time
+    {
+        CNetChannelRateLimit rate(100, 400);
+        BOOST_CHECK(rate.Consume(300, nTime) == 300);
+        BOOST_CHECK(rate.Consume(300, nTime) == 100);
+        BOOST_CHECK(rate.Consume(1, nTime) == 0);
+        BOOST_CHECK(rate.Consume(0, nTime) == 0);
+    }
+
+    // refill: rate tokens per second, fractions carried over, time going back is ignored
+    {
+        CNetChannelRateLimit rate(100, 400);
+        BOOST_CHECK(rate.Consume(400, nTime) == 400);
+        BOOST_CHECK(rate.Consume(100, nTime + 500) == 50);
+        BOOST_CHECK(rate.Consume(100, nTime + 505) == 0);
+        BOOST_CHECK(rate.Consume(100, nTime + 515) == 1);
+        BOOST_CHECK(rate.Consume(100, nTime) == 0);
+        BOOST_CHECK(rate.Consume(100, nTime + 1515) == 100);
+    }
+
+    // refill stops at the burst
+    {
+        CNetChannelRateLimit rate(100, 400);
+        BOOST_CHECK(rate.Consume(400, nTime) == 400);
+        BOOST_CHECK(rate.Consume(1000, nTime + 60000) == 400);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,12 +2,15 @@
 // Distributed under the MIT/X11 software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
-//#include "rpcmod.h"
+#include "rpcmod.h"
+
 #include <boost/test/unit_test.hpp>
 
 #include "test_big.h"
 using namespace boost;
 
+//./build-release/test/test_big --log_level=all --run_test=rpc_tests/rpc_sendrawtxrun
+
 struct RPCSetup
 {
     //    metabasenet::CRPCMod rpcmdl;
@@ -45,4 +48,24 @@ BOOST_AUTO_TEST_CASE(rpc_getblock)
     //    BOOST_CHECK_THROW(CallRPCAPI("getblock"), std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE(rpc_sendrawtxrun)
+{
+    // Only consecutive eth_sendRawTransaction requests are sent as a batch, any other method ends the run
+    const std::vector<std::string> vMethod = { "eth_sendRawTransaction", "eth_sendRawTransaction", "eth_getTransactionCount",
+                                               "eth_sendRawTransaction", "eth_sendRawTransaction", "eth_sendRawTransaction",
+                                               "eth_getBalance", "eth_sendRawTransaction" };
+    metabasenet::rpc::CRPCReqVec vecReq;
+    for (size_t i = 0; i < vMethod.size(); i++)
+    {
+        vecReq.push_back(metabasenet::rpc::CRPCReqPtr(new metabasenet::rpc::CRPCReq(json_spirit::Value((int)i), vMethod[i])));
+    }
+    BOOST_CHECK(metabasenet::CRPCMod::GetEthRawTxRunEnd(vecReq, 0) == 2);
+    BOOST_CHECK(metabasenet::CRPCMod::GetEthRawTxRunEnd(vecReq, 1) == 2);
+    BOOST_CHECK(metabasenet::CRPCMod::GetEthRawTxRunEnd(vecReq, 2) == 2);
+    BOOST_CHECK(metabasenet::CRPCMod::GetEthRawTxRunEnd(vecReq, 3) == 6);
+    BOOST_CHECK(metabasenet::CRPCMod::GetEthRawTxRunEnd(vecReq, 6) == 6);
+    BOOST_CHECK(metabasenet::CRPCMod::GetEthRawTxRunEnd(vecReq, 7) == 8);
+    BOOST_CHECK(metabasenet::CRPCMod::GetEthRawTxRunEnd(vecReq, 8) == 8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,9 +5,12 @@
 #include <boost/test/unit_test.hpp>
 
 #include "block.h"
+#include "blockbase.h"
+#include "chaingen.h"
 #include "destination.h"
 #include "test_big.h"
 #include "timeseries.h"
+#include "triedb.h"
 
 using namespace std;
 using namespace mtbase;
@@ -20,6 +23,33 @@ BOOST_FIXTURE_TEST_SUITE(storage_tests, BasicUtfSetup)
 // basic config
 const uint32 nMagicNum = 0x8A5CA1E8;
 
+class CReceiptTestBlockState : public CBlockState
+{
+public:
+    CReceiptTestBlockState(CBlockBase& dbBlockBaseIn, const CBlock& block)
+      : CBlockState(dbBlockBaseIn, uint256(), block, uint256(), 0, std::map<CDestination, CAddressContext>()) {}
+
+    void AddContractLogs(const CTransactionLogs& logs)
+    {
+        mapCacheContractData[logs.address].cacheContractLogs.push_back(logs);
+    }
+    void CollectReceiptLogs(CTransactionReceipt& receipt)
+    {
+        ApplyCacheContractData(receipt);
+    }
+};
+
+static uint256 CalcReceiptRoot(const CTransactionReceipt& receipt)
+{
+    mtbase::CBufStream ss;
+    ss << receipt;
+    std::vector<bytes> vReceiptData(1);
+    ss.GetData(vReceiptData[0]);
+    std::vector<uint256> vReceiptHash;
+    CMerkleTree::CalcDataHashList(vReceiptData, vReceiptHash);
+    return CReceiptMerkleTree::BuildMerkleTree(vReceiptHash);
+}
+
 BOOST_AUTO_TEST_CASE(filetest)
 {
     cout << GetLocalTime() << "  file test.........." << endl;
@@ -167,4 +197,396 @@ BOOST_AUTO_TEST_CASE(fileread)
     free(pBuf);
 }
 
+BOOST_AUTO_TEST_CASE(hotset)
+{
+    path pathHotSet = temp_directory_path() / unique_path();
+    vector<CDiskPos> vPos(4);
+    {
+        CTimeSeriesCached ts;
+        BOOST_CHECK(ts.Initialize(pathHotSet, "block"));
+        for (size_t i = 0; i < vPos.size(); i++)
+        {
+            uint32 nCrc;
+            BOOST_CHECK(ts.Write(uint256(uint64(i + 1)), vPos[i], nCrc, false));
+        }
+
+        // Read counts: pos 2 -> 3, pos 0 -> 2, pos 3 -> 1, pos 1 -> 0
+        const size_t vRead[] = { 2, 0, 2, 3, 0, 2 };
+        for (const size_t n : vRead)
+        {
+            uint256 value;
+            BOOST_CHECK(ts.Read(value, vPos[n], true, false));
+            BOOST_CHECK(value == uint256(uint64(n + 1)));
+        }
+        ts.Deinitialize();
+    }
+    {
+        // The saved set is loaded hottest first, warmup reads are not counted
+        CTimeSeriesCached ts;
+        BOOST_CHECK(ts.Initialize(pathHotSet, "block"));
+        vector<CDiskPos> vHotPos;
+        ts.GetHotSet(vHotPos);
+        BOOST_CHECK(vHotPos.size() == 3);
+        BOOST_CHECK(vHotPos.size() == 3 && vHotPos[0] == vPos[2] && vHotPos[1] == vPos[0] && vHotPos[2] == vPos[3]);
+        for (const CDiskPos& pos : vHotPos)
+        {
+            uint256 value;
+            bool fCacheFull = true;
+            BOOST_CHECK(ts.ReadWarmup(value, pos, fCacheFull));
+            BOOST_CHECK(!fCacheFull);
+        }
+        ts.Deinitialize();
+    }
+    {
+        // The hot set file is used once, and warmup reads alone write no new one
+        CTimeSeriesCached ts;
+        BOOST_CHECK(ts.Initialize(pathHotSet, "block"));
+        vector<CDiskPos> vHotPos;
+        ts.GetHotSet(vHotPos);
+        BOOST_CHECK(vHotPos.empty());
+        ts.Deinitialize();
+    }
+    remove_all(pathHotSet);
+}
+
+BOOST_AUTO_TEST_CASE(receiptlogorder)
+{
+    CBlockBase dbBlockBase;
+    CBlock block;
+    CReceiptTestBlockState state(dbBlockBase, block);
+
+    std::vector<CTransactionLogs> vLogs;
+    for (int i = 0; i < 16; i++)
+    {
+        CTransactionLogs logs;
+        logs.address = CDestination(uint160(uint64(0x9e3779b97f4a7c15ULL * (i + 1))));
+        logs.data = bytes(1, (uint8)i);
+        logs.topics.push_back(uint256(uint64(i)));
+        vLogs.push_back(logs);
+    }
+    for (const auto& logs : vLogs)
+    {
+        state.AddContractLogs(logs);
+    }
+
+    CTransactionReceipt receipt;
+    receipt.nReceiptType = CTransactionReceipt::RECEIPT_TYPE_CONTRACT;
+    state.CollectReceiptLogs(receipt);
+
+    // logs are grouped by contract address in ascending address order
+    std::map<CDestination, std::vector<CTransactionLogs>> mapOrdered;
+    for (const auto& logs : vLogs)
+    {
+        mapOrdered[logs.address].push_back(logs);
+    }
+    CTransactionReceipt receiptExpected;
+    receiptExpected.nReceiptType = CTransactionReceipt::RECEIPT_TYPE_CONTRACT;
+    for (const auto& kv : mapOrdered)
+    {
+        receiptExpected.vLogs.insert(receiptExpected.vLogs.end(), kv.second.begin(), kv.second.end());
+    }
+
+    BOOST_CHECK(receipt.vLogs.size() == vLogs.size());
+    for (size_t i = 0; i < receipt.vLogs.size(); i++)
+    {
+        BOOST_CHECK(receipt.vLogs[i].address == receiptExpected.vLogs[i].address);
+        BOOST_CHECK(receipt.vLogs[i].data == receiptExpected.vLogs[i].data);
+    }
+    BOOST_CHECK(CalcReceiptRoot(receipt) == CalcReceiptRoot(receiptExpected));
+}
+
+// Sends every tx through the general path
+class CGeneralPathBlockState : public CBlockState
+{
+public:
+    CGeneralPathBlockState(CBlockBase& dbBlockBaseIn, const uint256& hashForkIn, const CBlock& block, const uint256& hashPrevStateRootIn,
+                           const uint32 nPrevBlockTimeIn, const std::map<CDestination, CAddressContext>& mapAddressContext)
+      : CBlockState(dbBlockBaseIn, hashForkIn, block, hashPrevStateRootIn, nPrevBlockTimeIn, mapAddressContext) {}
+
+protected:
+    bool IsPlainTransferTx(const CTransaction& tx, CAddressContext& ctxToAddress) override
+    {
+        return false;
+    }
+};
+
+// Executes the block with and without the plain transfer fast path, the results must be the same
+static void CheckTransferPath(CBlockBase& dbBlockBase, const CChainGenerator& gen, const CBlock& block, size_t& nTvTransferCount, size_t& nFailTxCount)
+{
+    std::map<CDestination, CAddressContext> mapAddressContext;
+    BOOST_REQUIRE(dbBlockBase.GetBlockAddress(gen.GetForkHash(), block.GetHash(), block, mapAddressContext));
+
+    uint256 hashReceiptRoot[2];
+    uint256 nBlockGasUsed[2];
+    bytes btBloomData[2];
+    uint256 nTotalMintReward[2];
+    bytes btState[2];
+    const CBlockIndex* pIndexPrev = gen.GetLastIndex();
+    CBlockState stateFastPath(dbBlockBase, gen.GetForkHash(), block, pIndexPrev->GetStateRoot(), pIndexPrev->GetBlockTime(), mapAddressContext);
+    CGeneralPathBlockState stateGeneralPath(dbBlockBase, gen.GetForkHash(), block, pIndexPrev->GetStateRoot(), pIndexPrev->GetBlockTime(), mapAddressContext);
+    CBlockState* pState[2] = { &stateFastPath, &stateGeneralPath };
+    for (int i = 0; i < 2; i++)
+    {
+        CBlockState& state = *pState[i];
+        for (size_t n = 0; n < block.vtx.size(); n++)
+        {
+            BOOST_REQUIRE(state.AddTxState(block.vtx[n], n + 1));
+        }
+        BOOST_REQUIRE(state.DoBlockState(hashReceiptRoot[i], nBlockGasUsed[i], btBloomData[i], nTotalMintReward[i]));
+
+        // The state root is the trie of mapBlockState
+        CBufStream ss;
+        ss << state.mapBlockState << state.mapBlockPayTvFee << state.mapBlockTxFeeUsed << state.mapBlockContractTransfer << state.nBlockFeeLeft;
+        ss.GetData(btState[i]);
+
+        if (i == 0)
+        {
+            nTvTransferCount = 0;
+            for (const auto& kv : state.mapBlockContractTransfer)
+            {
+                for (const CContractTransfer& ctrTransfer : kv.second)
+                {
+                    if (ctrTransfer.nType == CContractTransfer::CT_TIMEVAULT)
+                    {
+                        nTvTransferCount++;
+                    }
+                }
+            }
+            nFailTxCount = 0;
+            for (const auto& kv : state.mapBlockTxReceipts)
+            {
+                if (kv.second.nContractStatus != 0)
+                {
+                    nFailTxCount++;
+                }
+            }
+        }
+    }
+    BOOST_CHECK(hashReceiptRoot[0] == hashReceiptRoot[1]);
+    BOOST_CHECK(nBlockGasUsed[0] == nBlockGasUsed[1]);
+    BOOST_CHECK(btBloomData[0] == btBloomData[1]);
+    BOOST_CHECK(nTotalMintReward[0] == nTotalMintReward[1]);
+    BOOST_CHECK(btState[0] == btState[1]);
+}
+
+BOOST_AUTO_TEST_CASE(transferfastpath)
+{
+    const path pathData = temp_directory_path() / unique_path();
+
+    CBlockBase dbBlockBase;
+    CChainGenerator gen(dbBlockBase, 8);
+    CBlock blockGenesis;
+    gen.CreateGenesisBlock(blockGenesis);
+    BOOST_REQUIRE(dbBlockBase.Initialize(pathData, blockGenesis.GetHash(), false, false, false));
+    CBlock block;
+    BOOST_REQUIRE(gen.Initiate(blockGenesis, bytes(), block));
+
+    const vector<CDestination>& vAccount = gen.GetAccounts();
+    size_t nTvTransferCount = 0;
+    size_t nFailTxCount = 0;
+
+    // Plain transfers pay the time vault fee of the funded accounts, with a repeated sender,
+    // a zero amount, a new recipient and a transfer to a template
+    {
+        vector<CTransaction> vtx;
+        for (size_t i = 0; i + 1 < vAccount.size(); i++)
+        {
+            vtx.push_back(gen.CreateTransfer(vAccount[i], vAccount[i + 1], COIN));
+        }
+        vtx.push_back(gen.CreateTransfer(vAccount[0], vAccount[2], COIN));
+        vtx.push_back(gen.CreateTransfer(vAccount[1], vAccount[3], 0));
+        vtx.push_back(gen.CreateTransfer(vAccount[2], CDestination(uint256(0x5001)), COIN));
+        vtx.push_back(gen.CreateVote(vAccount[3], COIN));
+        BOOST_REQUIRE(gen.CreateBlock(vtx, block));
+        CheckTransferPath(dbBlockBase, gen, block, nTvTransferCount, nFailTxCount);
+        BOOST_CHECK(nTvTransferCount > 0);
+        BOOST_CHECK(nFailTxCount == 0);
+    }
+
+    // A year later the time vault gas exceeds the gas limit, plain transfers fall back and are cancelled
+    {
+        vector<CTransaction> vtx;
+        vtx.push_back(gen.CreateTransfer(vAccount[4], vAccount[5], 5000 * COIN));
+        vtx.push_back(gen.CreateTransfer(vAccount[5], vAccount[6], COIN));
+        vtx.push_back(gen.CreateVote(vAccount[6], COIN));
+        BOOST_REQUIRE(gen.CreateBlock(vtx, block));
+        block.SetBlockTime(block.GetBlockTime() + 365 * 24 * 3600);
+        CheckTransferPath(dbBlockBase, gen, block, nTvTransferCount, nFailTxCount);
+        BOOST_CHECK(nFailTxCount > 0);
+    }
+
+    dbBlockBase.Deinitialize();
+    remove_all(pathData);
+}
+
+static bool ListAllAddressTxInfo(CBlockBase& dbBlockBase, const uint256& hashFork, const uint256& hashBlock, const CDestination& dest, vector<uint256>& vTxid)
+{
+    vector<CDestTxInfo> vAddressTxInfo;
+    if (!dbBlockBase.ListAddressTxInfo(hashFork, hashBlock, dest, 0, 10000, false, vAddressTxInfo))
+    {
+        return false;
+    }
+    for (const CDestTxInfo& txInfo : vAddressTxInfo)
+    {
+        vTxid.push_back(txInfo.txid);
+    }
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(addresstxindex)
+{
+    const path pathData = temp_directory_path() / unique_path();
+    const size_t nIndexBatch = 32;
+
+    // -fulldb -fulldbasync: import leaves the address tx index to the catch-up indexer.
+    // More blocks than the block state cache, so the indexer also executes blocks again.
+    CBlockBase dbAsync;
+    CChainGenerator gen(dbAsync, 8);
+    CBlock blockGenesis;
+    gen.CreateGenesisBlock(blockGenesis);
+    const uint256 hashFork = blockGenesis.GetHash();
+    BOOST_REQUIRE(dbAsync.Initialize(pathData / "async", hashFork, true, true, false));
+
+    vector<CBlock> vBlock;
+    CBlock block;
+    BOOST_REQUIRE(gen.Initiate(blockGenesis, bytes(), block));
+    vBlock.push_back(block);
+    while (vBlock.size() < 100)
+    {
+        BOOST_REQUIRE(gen.MakeBlock(CChainGenerator::CBlockTxMix(4), block));
+        vBlock.push_back(block);
+    }
+    const uint256 hashLastBlock = gen.GetLastIndex()->GetBlockHash();
+
+    uint256 hashIndexLast;
+    BOOST_CHECK(!dbAsync.GetAddressTxInfoIndexLast(hashFork, hashIndexLast));
+
+    // getaddresstxindexheight reports the height of the last indexed block
+    size_t nIndexCount = 0;
+    BOOST_CHECK(dbAsync.CatchUpAddressTxInfo(nIndexBatch, nIndexCount) && nIndexCount == nIndexBatch);
+    BOOST_CHECK(dbAsync.GetAddressTxInfoIndexLast(hashFork, hashIndexLast));
+    BOOST_CHECK(CBlock::GetBlockHeightByHash(hashIndexLast) == CBlock::GetBlockHeightByHash(hashFork) + nIndexBatch - 1);
+    do
+    {
+        BOOST_REQUIRE(dbAsync.CatchUpAddressTxInfo(nIndexBatch, nIndexCount));
+    } while (nIndexCount > 0);
+    BOOST_CHECK(dbAsync.GetAddressTxInfoIndexLast(hashFork, hashIndexLast) && hashIndexLast == hashLastBlock);
+
+    // -fulldb: the same blocks indexed during import give the same history
+    CBlockBase dbSync;
+    BOOST_REQUIRE(dbSync.Initialize(pathData / "sync", hashFork, true, false, false));
+    BOOST_REQUIRE(dbSync.Initiate(hashFork, blockGenesis, uint256(1)));
+    for (const CBlock& blockImport : vBlock)
+    {
+        CBlockChainUpdate update;
+        BOOST_REQUIRE(dbSync.StorageNewBlock(hashFork, blockImport.GetHash(), CBlockEx(blockImport, uint256(1)), update));
+    }
+
+    vector<CDestination> vDest = gen.GetAccounts();
+    vDest.push_back(gen.GetOwner());
+    for (const CDestination& dest : vDest)
+    {
+        vector<uint256> vTxidAsync;
+        vector<uint256> vTxidSync;
+        BOOST_CHECK(ListAllAddressTxInfo(dbAsync, hashFork, hashLastBlock, dest, vTxidAsync));
+        BOOST_CHECK(ListAllAddressTxInfo(dbSync, hashFork, hashLastBlock, dest, vTxidSync));
+        BOOST_CHECK(!vTxidAsync.empty() && vTxidAsync == vTxidSync);
+    }
+
+    dbAsync.Deinitialize();
+    dbSync.Deinitialize();
+    remove_all(pathData);
+}
+
+// Rewrites a leaf node of a trie under its old hash, only a walk of all nodes finds it
+class CCorruptTrieDB : public CTrieDB
+{
+public:
+    bool CorruptLeafNode(const uint256& hashRoot)
+    {
+        uint256 hashNode = hashRoot;
+        CTrieValue value;
+        while (GetDbNodeValue(hashNode, value))
+        {
+            uint256 hashNext;
+            if (value.type == CTrieValue::TYPE_BRANCH)
+            {
+                for (int i = 0; i < 16 && hashNext == 0; i++)
+                {
+                    hashNext = value.vaBranch.GetValueHash(i);
+                    if (hashNext == 0)
+                    {
+                        hashNext = value.vaBranch.GetNextHash(i);
+                    }
+                }
+            }
+            else if (value.type == CTrieValue::TYPE_EXTENSION)
+            {
+                hashNext = value.vaExtension.GetValueHash();
+                if (hashNext == 0)
+                {
+                    hashNext = value.vaExtension.GetNextHash();
+                }
+            }
+            else if (value.type == CTrieValue::TYPE_VALUE && hashNode != hashRoot && !value.vaValue.empty())
+            {
+                value.vaValue.back() ^= 0x01;
+                return SetDbNodeValue(hashNode, value);
+            }
+            if (hashNext == 0)
+            {
+                break;
+            }
+            hashNode = hashNext;
+        }
+        return false;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(checklevelallnode)
+{
+    const path pathData = temp_directory_path() / unique_path();
+    const int nCheckLevelAllNode = 3;
+
+    CBlock blockGenesis;
+    uint256 hashStateRoot;
+    {
+        CBlockBase dbBlockBase;
+        CChainGenerator gen(dbBlockBase, 8);
+        gen.CreateGenesisBlock(blockGenesis);
+        BOOST_REQUIRE(dbBlockBase.Initialize(pathData, blockGenesis.GetHash(), false, false, false));
+        CBlock block;
+        BOOST_REQUIRE(gen.Initiate(blockGenesis, bytes(), block));
+        for (int i = 0; i < 4; i++)
+        {
+            BOOST_REQUIRE(gen.MakeBlock(CChainGenerator::CBlockTxMix(8), block));
+        }
+        hashStateRoot = gen.GetLastIndex()->GetStateRoot();
+        dbBlockBase.Deinitialize();
+    }
+    const uint256 hashFork = blockGenesis.GetHash();
+
+    // -chklvl=3 walks every trie node of the last block
+    {
+        CBlockBase dbBlockBase;
+        BOOST_CHECK(dbBlockBase.Initialize(pathData, hashFork, false, false, false, nCheckLevelAllNode));
+        dbBlockBase.Deinitialize();
+    }
+
+    {
+        CCorruptTrieDB dbTrie;
+        BOOST_REQUIRE(dbTrie.Initialize(pathData / "state" / hashFork.GetHex()));
+        BOOST_REQUIRE(dbTrie.CorruptLeafNode(hashStateRoot));
+        dbTrie.Deinitialize();
+    }
+
+    {
+        CBlockBase dbBlockBase;
+        BOOST_CHECK(!dbBlockBase.Initialize(pathData, hashFork, false, false, false, nCheckLevelAllNode));
+        dbBlockBase.Deinitialize();
+    }
+
+    remove_all(pathData);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
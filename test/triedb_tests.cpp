@@ -7,6 +7,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "block.h"
+#include "contractdb.h"
 #include "destination.h"
 #include "test_big.h"
 
@@ -19,6 +20,7 @@ using namespace boost::filesystem;
 //./build/test/test_big --log_level=all --run_test=triedb_tests/basetest
 //./build/test/test_big --log_level=all --run_test=triedb_tests/shorttest
 //./build/test/test_big --log_level=all --run_test=triedb_tests/stresstest
+//./build/test/test_big --log_level=all --run_test=triedb_tests/checksharednode
 
 BOOST_FIXTURE_TEST_SUITE(triedb_tests, BasicUtfSetup)
 
@@ -210,6 +212,55 @@ BOOST_AUTO_TEST_CASE(shorttest)
     db.Deinitialize();
 }
 
+BOOST_AUTO_TEST_CASE(updatefunctest)
+{
+    cout << GetLocalTime() << "  triedb update func test.........." << endl;
+
+    std::string fullpath = boost::filesystem::initial_path<boost::filesystem::path>().string() + "/test/trie";
+
+    CTrieDB db;
+    BOOST_CHECK(db.Initialize(boost::filesystem::path(fullpath)));
+
+    uint256 hashPrevRoot;
+    uint256 hashNewRoot;
+
+    {
+        bytesmap mapKv;
+        mapKv.insert(make_pair(GetBytes("key001"), GetBytes("value001")));
+        mapKv.insert(make_pair(GetBytes("key002"), GetBytes("value002")));
+        BOOST_CHECK(db.AddNewTrie(hashPrevRoot, mapKv, hashNewRoot));
+        hashPrevRoot = hashNewRoot;
+    }
+
+    {
+        bytesmap mapKv;
+        mapKv.insert(make_pair(GetBytes("key001"), GetBytes("value001-new")));
+        mapKv.insert(make_pair(GetBytes("key002"), GetBytes("value002-new")));
+        mapKv.insert(make_pair(GetBytes("key003"), GetBytes("value003")));
+
+        std::size_t nNewKeyCount = 0;
+        BOOST_CHECK(db.AddNewTrie(hashPrevRoot, mapKv, hashNewRoot,
+                                  [&](const bytes& btKey, const bytes& btNewValue, const bytes* pbtOldValue) -> bool {
+                                      if (pbtOldValue == nullptr)
+                                      {
+                                          nNewKeyCount++;
+                                          return true;
+                                      }
+                                      // Keep the old value of key001
+                                      return (btKey != GetBytes("key001"));
+                                  }));
+        BOOST_CHECK(nNewKeyCount == 1);
+
+        bytes btValue;
+        BOOST_CHECK(db.Retrieve(hashNewRoot, GetBytes("key001"), btValue) && btValue == GetBytes("value001"));
+        BOOST_CHECK(db.Retrieve(hashNewRoot, GetBytes("key002"), btValue) && btValue == GetBytes("value002-new"));
+        BOOST_CHECK(db.Retrieve(hashNewRoot, GetBytes("key003"), btValue) && btValue == GetBytes("value003"));
+    }
+
+    db.Clear();
+    db.Deinitialize();
+}
+
 BOOST_AUTO_TEST_CASE(stresstest)
 {
     cout << GetLocalTime() << "  triedb stress test.........." << endl;
@@ -416,6 +467,51 @@ BOOST_AUTO_TEST_CASE(walkthroughtest)
     db.Deinitialize();
 }
 
+BOOST_AUTO_TEST_CASE(contractkvrangetest)
+{
+    cout << GetLocalTime() << "  triedb contract kv range test.........." << endl;
+
+    std::string fullpath = boost::filesystem::initial_path<boost::filesystem::path>().string() + "/test/contractkv";
+
+    CForkContractDB db(uint256(1));
+    BOOST_CHECK(db.Initialize(boost::filesystem::path(fullpath)));
+
+    std::map<uint256, bytes> mapContractState;
+    for (int i = 0; i < 25; i++)
+    {
+        uint256 key = metabasenet::crypto::CryptoHash(&i, sizeof(i));
+        mapContractState[key] = bytes(i + 1, (uint8)i);
+    }
+
+    uint256 hashRoot;
+    BOOST_CHECK(db.AddBlockContractKvValue(uint256(), hashRoot, mapContractState));
+
+    std::vector<std::pair<uint256, bytes>> vAllKv;
+    uint256 keyBegin;
+    int nPageCount = 0;
+    do
+    {
+        std::vector<std::pair<uint256, bytes>> vContractKv;
+        uint256 keyNext;
+        BOOST_CHECK(db.ListContractKvValue(hashRoot, keyBegin, 10, vContractKv, keyNext));
+        BOOST_CHECK(vContractKv.size() <= 10);
+        vAllKv.insert(vAllKv.end(), vContractKv.begin(), vContractKv.end());
+        keyBegin = keyNext;
+        nPageCount++;
+    } while (keyBegin != 0 && nPageCount < 10);
+
+    BOOST_CHECK(nPageCount == 3);
+    BOOST_CHECK(vAllKv.size() == mapContractState.size());
+    for (const auto& kv : vAllKv)
+    {
+        auto it = mapContractState.find(kv.first);
+        BOOST_CHECK(it != mapContractState.end() && it->second == kv.second);
+    }
+
+    db.RemoveAll();
+    db.Deinitialize();
+}
+
 /////////////////////////////////////////////////////////////
 BOOST_AUTO_TEST_CASE(stresstest2)
 {
@@ -593,6 +689,66 @@ BOOST_AUTO_TEST_CASE(stattrienode)
     db.Deinitialize();
 }
 
+// Rewrites the leaf node of a value under its old hash
+class CCorruptTrieDB : public CTrieDB
+{
+public:
+    bool CorruptValueNode(const bytes& btValue)
+    {
+        CTrieValue value;
+        value.type = CTrieValue::TYPE_VALUE;
+        value.vaValue = btValue;
+        const uint256 hashNode = value.CalcHash();
+        if (!GetDbNodeValue(hashNode, value) || value.vaValue.empty())
+        {
+            return false;
+        }
+        value.vaValue.back() ^= 0x01;
+        return SetDbNodeValue(hashNode, value);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(checksharednode)
+{
+    std::string fullpath = boost::filesystem::initial_path<boost::filesystem::path>().string() + "/test/triecheck";
+
+    CCorruptTrieDB db;
+    BOOST_CHECK(db.Initialize(boost::filesystem::path(fullpath)));
+
+    // Enough keys for the check to split into parallel subtrees, the second root changes one key
+    uint256 hashRoot1, hashRoot2;
+    {
+        bytesmap mapKv;
+        for (int i = 0; i < 2000; i++)
+        {
+            const string strIndex = to_string(10000 + i).substr(1);
+            mapKv.insert(make_pair(GetBytes("key" + strIndex), GetBytes("value" + strIndex)));
+        }
+        BOOST_REQUIRE(db.AddNewTrie(uint256(), mapKv, hashRoot1));
+    }
+    {
+        bytesmap mapKv;
+        mapKv.insert(make_pair(GetBytes("key1999"), GetBytes("value1999-new")));
+        BOOST_REQUIRE(db.AddNewTrie(hashRoot1, mapKv, hashRoot2));
+    }
+
+    std::map<uint256, CTrieValue> mapCacheNode;
+    BOOST_CHECK(db.CheckTrieNode(hashRoot1, mapCacheNode));
+    const size_t nRoot1NodeCount = mapCacheNode.size();
+
+    // The leaf of key0000 is shared by both roots, checked once it is not read again
+    BOOST_REQUIRE(db.CorruptValueNode(GetBytes("value0000")));
+    BOOST_CHECK(db.CheckTrieNode(hashRoot2, mapCacheNode));
+    BOOST_CHECK(mapCacheNode.size() > nRoot1NodeCount && mapCacheNode.size() < nRoot1NodeCount + 16);
+
+    std::map<uint256, CTrieValue> mapNewCacheNode;
+    BOOST_CHECK(!db.CheckTrieNode(hashRoot2, mapNewCacheNode));
+    BOOST_CHECK(!db.CheckTrie({ hashRoot1, hashRoot2 }));
+
+    db.Clear();
+    db.Deinitialize();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 //./build/test/test_big --log_level=all --run_test=triedb_tests/basetest
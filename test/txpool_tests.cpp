@@ -0,0 +1,230 @@
+// Copyright (c) 2021-2023 The MetabaseNet developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "txpool.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_big.h"
+
+using namespace std;
+using namespace mtbase;
+using namespace metabasenet;
+
+//./build-release/test/test_big --log_level=all --run_test=txpool_tests/rejectedtx
+//./build-release/test/test_big --log_level=all --run_test=txpool_tests/addresstxstate
+//./build-release/test/test_big --log_level=all --run_test=txpool_tests/relayorder
+
+BOOST_FIXTURE_TEST_SUITE(txpool_tests, BasicUtfSetup)
+
+BOOST_AUTO_TEST_CASE(rejectedtx)
+{
+    const int64 nTime = 1000;
+    const int64 nExpiredSeconds = 15;
+    Errno err = OK;
+
+    // expiry
+    {
+        CRejectedTxCache cache(16, nExpiredSeconds);
+        cache.Add(uint256(1), ERR_TRANSACTION_SIGNATURE_INVALID, nTime);
+        cache.Add(uint256(2), ERR_TRANSACTION_INVALID, nTime);
+        BOOST_CHECK(cache.Get(uint256(1), err, nTime + nExpiredSeconds) && err == ERR_TRANSACTION_SIGNATURE_INVALID);
+        BOOST_CHECK(cache.Get(uint256(2), err, nTime + nExpiredSeconds) && err == ERR_TRANSACTION_INVALID);
+        BOOST_CHECK(!cache.Get(uint256(1), err, nTime + nExpiredSeconds + 1));
+        BOOST_CHECK(!cache.Get(uint256(2), err, nTime + nExpiredSeconds + 1));
+        BOOST_CHECK(!cache.Get(uint256(1), err, nTime));
+    }
+
+    // first in, first out when full
+    {
+        CRejectedTxCache cache(4, nExpiredSeconds);
+        for (uint64 i = 1; i <= 5; i++)
+        {
+            cache.Add(uint256(i), ERR_TRANSACTION_INVALID, nTime);
+        }
+        BOOST_CHECK(!cache.Get(uint256(1), err, nTime));
+        for (uint64 i = 2; i <= 5; i++)
+        {
+            BOOST_CHECK(cache.Get(uint256(i), err, nTime));
+        }
+    }
+
+    // not rejections
+    {
+        CRejectedTxCache cache(16, nExpiredSeconds);
+        cache.Add(uint256(1), OK, nTime);
+        cache.Add(uint256(2), ERR_MISSING_PREV, nTime);
+        cache.Add(uint256(3), ERR_ALREADY_HAVE, nTime);
+        BOOST_CHECK(!cache.Get(uint256(1), err, nTime));
+        BOOST_CHECK(!cache.Get(uint256(2), err, nTime));
+        BOOST_CHECK(!cache.Get(uint256(3), err, nTime));
+
+        cache.Add(uint256(4), ERR_TRANSACTION_INVALID, nTime);
+        cache.Clear();
+        BOOST_CHECK(!cache.Get(uint256(4), err, nTime));
+    }
+}
+
+static CPooledTxPtr CreatePooledTx(const CDestination& destFrom, const uint64 nNonce, const uint16 nTxType = CTransaction::TX_TOKEN)
+{
+    CTransaction tx;
+    tx.SetTxType(nTxType);
+    tx.SetNonce(nNonce);
+    tx.SetFromAddress(destFrom);
+    tx.SetToAddress(CDestination(uint256(0x100)));
+    return CPooledTxPtr(new CPooledTx(tx, nNonce));
+}
+
+static CDestState CreateNonceState(const uint64 nTxNonce)
+{
+    CDestState state(COIN);
+    state.SetTxNonce(nTxNonce);
+    return state;
+}
+
+BOOST_AUTO_TEST_CASE(addresstxstate)
+{
+    const CDestination destFrom(uint256(0x200));
+    vector<CPooledTxPtr> vPooledTx;
+    for (uint64 i = 0; i <= 6; i++)
+    {
+        vPooledTx.push_back(CreatePooledTx(destFrom, i));
+    }
+    auto txidAt = [&](const uint64 nNonce) -> uint256 { return vPooledTx[nNonce]->GetHash(); };
+
+    // connect: only the prefix front is dropped alone, the cert tx is not in the prefix
+    {
+        CAddressTxState state;
+        state.SetAddressState(CreateNonceState(3));
+        for (uint64 i = 1; i <= 3; i++)
+        {
+            state.AddAddressTx(txidAt(i), vPooledTx[i], true);
+        }
+        CPooledTxPtr ptxCert = CreatePooledTx(destFrom, 100, CTransaction::TX_CERT);
+        state.AddAddressTx(ptxCert->GetHash(), ptxCert, true);
+        BOOST_CHECK(state.mapFromTxNonce.size() == 3);
+
+        BOOST_CHECK(state.IsNextFromTx(txidAt(1), 1));
+        BOOST_CHECK(!state.IsNextFromTx(txidAt(2), 2));
+        BOOST_CHECK(!state.IsNextFromTx(CreatePooledTx(CDestination(uint256(0x300)), 1)->GetHash(), 1));
+
+        state.RemoveAddressTx(txidAt(1));
+        BOOST_CHECK(state.IsNextFromTx(txidAt(2), 2));
+        vector<pair<uint256, CPooledTxPtr>> vFromTx;
+        state.ListFromTx(vFromTx);
+        BOOST_CHECK(vFromTx.size() == 2 && vFromTx[0].first == txidAt(2) && vFromTx[1].first == txidAt(3));
+    }
+
+    // disconnect: the disconnected txs go before the prefix, in nonce order
+    {
+        CAddressTxState state;
+        state.SetAddressState(CreateNonceState(4));
+        state.AddAddressTx(txidAt(4), vPooledTx[4], true);
+        state.AddAddressTx(txidAt(3), vPooledTx[3], true);
+
+        vector<pair<uint256, CTransaction>> vDisconnectTx;
+        for (uint64 i = 2; i >= 1; i--)
+        {
+            vDisconnectTx.push_back(make_pair(txidAt(i), *static_cast<CTransaction*>(vPooledTx[i].get())));
+        }
+        vector<pair<uint256, CTransaction>> vResetTx;
+        state.ListResetTx(vDisconnectTx, vResetTx);
+        BOOST_CHECK(vResetTx.size() == 4);
+        for (size_t i = 0; i < vResetTx.size(); i++)
+        {
+            BOOST_CHECK(vResetTx[i].first == txidAt(i + 1) && vResetTx[i].second.GetNonce() == i + 1);
+        }
+    }
+
+    // gaps: the queued tail waits for the missing nonce, then is promoted one by one
+    {
+        CAddressTxState state;
+        state.SetAddressState(CreateNonceState(1));
+        state.AddMissTx(txidAt(5), *vPooledTx[5]);
+        state.AddMissTx(txidAt(4), *vPooledTx[4]);
+        state.AddMissTx(txidAt(1), *vPooledTx[1]);
+        BOOST_CHECK(state.mapMissTx.size() == 2);
+
+        uint256 txid;
+        CTransaction tx;
+        BOOST_CHECK(!state.FetchNextMissTx(txid, tx));
+
+        state.AddAddressTx(txidAt(2), vPooledTx[2], true);
+        state.AddAddressTx(txidAt(3), vPooledTx[3], true);
+        state.SetAddressState(CreateNonceState(3));
+        BOOST_CHECK(state.FetchNextMissTx(txid, tx) && txid == txidAt(4) && tx.GetNonce() == 4);
+
+        state.AddAddressTx(txidAt(4), vPooledTx[4], true);
+        state.SetAddressState(CreateNonceState(4));
+        BOOST_CHECK(state.mapMissTx.size() == 1);
+        BOOST_CHECK(state.FetchNextMissTx(txid, tx) && txid == txidAt(5));
+
+        // mined by another node: the tail at or below the chain nonce is dropped
+        state.SetAddressState(CreateNonceState(5));
+        BOOST_CHECK(state.mapMissTx.empty() && state.mapMissNonce.empty());
+        BOOST_CHECK(!state.FetchNextMissTx(txid, tx));
+    }
+}
+
+static CTransaction CreateRelayTx(const CDestination& destFrom, const uint64 nNonce, const uint64 nGasPrice, const uint16 nTxType = CTransaction::TX_TOKEN)
+{
+    CTransaction tx;
+    tx.SetTxType(nTxType);
+    tx.SetNonce(nNonce);
+    tx.SetFromAddress(destFrom);
+    tx.SetToAddress(CDestination(uint256(0x100)));
+    tx.SetGasPrice(uint256(nGasPrice));
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(relayorder)
+{
+    CForkTxPool pool(nullptr, nullptr, uint256(), uint256(), 0);
+    int64 nTxSeq = INIT_TX_SEQUENCE_NUMBER;
+    map<string, pair<uint256, CTransaction>> mapTx;
+    auto addTx = [&](const string& strName, const CTransaction& tx) {
+        mapTx[strName] = make_pair(tx.GetHash(), tx);
+        BOOST_REQUIRE(pool.AddPooledTx(tx.GetHash(), tx, nTxSeq++));
+    };
+    auto checkOrder = [&](const vector<string>& vName) {
+        vector<uint256> vTxid;
+        pool.ListRelayTx(vTxid);
+        vector<uint256> vExpected;
+        for (const string& strName : vName)
+        {
+            vExpected.push_back(mapTx[strName].first);
+        }
+        BOOST_CHECK(vTxid == vExpected);
+    };
+
+    const CDestination destA(uint256(0x201)), destB(uint256(0x202)), destC(uint256(0x203)), destD(uint256(0x204));
+    addTx("a1", CreateRelayTx(destA, 1, 10));
+    addTx("a2", CreateRelayTx(destA, 2, 30));
+    addTx("a3", CreateRelayTx(destA, 3, 20));
+    addTx("b1", CreateRelayTx(destB, 1, 25));
+    addTx("b2", CreateRelayTx(destB, 2, 15));
+    addTx("c1", CreateRelayTx(destC, 1, 40));
+    addTx("c3", CreateRelayTx(destC, 3, 50));
+    addTx("d", CreateRelayTx(destD, 100, 5, CTransaction::TX_CERT));
+
+    // a2 and a3 are capped by a1, c3 waits for the missing c2
+    checkOrder({ "c1", "b1", "b2", "a1", "a2", "a3", "d" });
+
+    // a1 mined: a2 and a3 rank by their own prices, still in nonce order
+    BOOST_REQUIRE(pool.RemovePooledTx(mapTx["a1"].first, mapTx["a1"].second, true));
+    checkOrder({ "c1", "a2", "b1", "a3", "b2", "d" });
+
+    // c2 closes the gap, c3 entered the pool first but stays after c2
+    addTx("c2", CreateRelayTx(destC, 2, 45));
+    checkOrder({ "c1", "c2", "c3", "a2", "b1", "a3", "b2", "d" });
+
+    // a gap in the middle stops relaying the rest of the sender
+    BOOST_REQUIRE(pool.RemovePooledTx(mapTx["c2"].first, mapTx["c2"].second, true));
+    checkOrder({ "c1", "a2", "b1", "a3", "b2", "d" });
+
+    BOOST_REQUIRE(pool.RemovePooledTx(mapTx["d"].first, mapTx["d"].second, true));
+    checkOrder({ "c1", "a2", "b1", "a3", "b2" });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
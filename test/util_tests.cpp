@@ -5,6 +5,9 @@
 #include "util.h"
 
 #include <boost/test/unit_test.hpp>
+#include <map>
+
+#include "arena.h"
 
 #include "forkcontext.h"
 #include "param.h"
@@ -132,4 +135,52 @@ BOOST_AUTO_TEST_CASE(reverse_hex_string_test)
     BOOST_CHECK(ReverseHexNumericString("0x123") == std::string("0x2301"));
 }
 
+BOOST_AUTO_TEST_CASE(arena_test)
+{
+    CArena arena(256);
+    std::map<int, std::string, std::less<int>, CArenaAllocator<std::pair<const int, std::string>>> mapArena(arena);
+    for (int i = 0; i < 100; i++)
+    {
+        mapArena[i] = std::to_string(i);
+    }
+    BOOST_CHECK(mapArena.size() == 100);
+    BOOST_CHECK(mapArena[42] == std::string("42"));
+    BOOST_CHECK(arena.GetChunkCount() > 1);
+
+    void* p = arena.Allocate(1024, 16);
+    BOOST_CHECK(((std::uintptr_t)p & 15) == 0);
+    BOOST_CHECK(arena.GetAllocatedSize() >= 1024);
+
+    // Reset keeps the chunks, the next round is carved from them
+    mapArena.clear();
+    const std::size_t nChunkCount = arena.GetChunkCount();
+    arena.Reset();
+    BOOST_CHECK(arena.GetAllocatedSize() == 0);
+    for (int i = 0; i < 100; i++)
+    {
+        mapArena[i] = std::to_string(i);
+    }
+    arena.Allocate(1024, 16);
+    BOOST_CHECK(arena.GetChunkCount() == nChunkCount);
+
+    mapArena.clear();
+    arena.Release();
+    BOOST_CHECK(arena.GetChunkCount() == 0);
+    BOOST_CHECK(arena.GetAllocatedSize() == 0);
+
+    // The caller buffer is used first, chunks are added when it runs out
+    alignas(16) uint8 buf[64];
+    CArena arenaBuf(buf, sizeof(buf), 256);
+    CArenaBytes bt(arenaBuf);
+    bt.reserve(32);
+    BOOST_CHECK(bt.data() >= buf && bt.data() + 32 <= buf + sizeof(buf));
+    BOOST_CHECK(arenaBuf.GetChunkCount() == 0);
+    bt.reserve(128);
+    BOOST_CHECK(arenaBuf.GetChunkCount() == 1);
+    bt.clear();
+    bt.shrink_to_fit();
+    arenaBuf.Reset();
+    BOOST_CHECK(arenaBuf.Allocate(16, 8) == (void*)buf);
+}
+
 BOOST_AUTO_TEST_SUITE_END()